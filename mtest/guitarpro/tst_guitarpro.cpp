@@ -20,6 +20,10 @@
 
 using namespace Ms;
 
+namespace Ms {
+extern Score::FileError importGTP(MasterScore*, const QString& name);
+}
+
 //---------------------------------------------------------
 //   TestGuitarPro
 //---------------------------------------------------------
@@ -29,6 +33,7 @@ class TestGuitarPro : public QObject, public MTest
     Q_OBJECT
 
     void gpReadTest(const char* file,  const char* ext);
+    void gpTruncatedTest(const char* file, const char* ext);
 
 private slots:
     void initTestCase();
@@ -245,6 +250,9 @@ private slots:
     void gp4CapoFret() { gpReadTest("capo-fret", "gp4"); }
     void gp5CapoFret() { gpReadTest("capo-fret", "gp5"); }
     void gpxUncompletedMeasure() { gpReadTest("UncompletedMeasure", "gpx"); }
+    void gp3Truncated() { gpTruncatedTest("capo-fret", "gp3"); }
+    void gp4Truncated() { gpTruncatedTest("fret-diagram", "gp4"); }
+    void gp5Truncated() { gpTruncatedTest("fret-diagram", "gp5"); }
 };
 
 //---------------------------------------------------------
@@ -273,5 +281,39 @@ void TestGuitarPro::gpReadTest(const char* file, const char* ext)
     delete score;
 }
 
+//---------------------------------------------------------
+//   gpTruncatedTest
+//   import every prefix of the file; a cut file must be
+//   rejected without crashing
+//---------------------------------------------------------
+
+void TestGuitarPro::gpTruncatedTest(const char* file, const char* ext)
+{
+    QFile fp(root + "/" + DIR + file + "." + ext);
+    QVERIFY(fp.open(QIODevice::ReadOnly));
+    const QByteArray data = fp.readAll();
+    fp.close();
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.filePath(QString("truncated.") + ext);
+
+    for (int len = 0; len <= data.size(); ++len) {
+        QFile out(path);
+        QVERIFY(out.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        out.write(data.constData(), len);
+        out.close();
+
+        MasterScore* score = new MasterScore(mscore->baseStyle());
+        Score::FileError rv = importGTP(score, path);
+        if (len == data.size()) {
+            QVERIFY(rv == Score::FileError::FILE_NO_ERROR);
+        } else if (len < data.size() / 2) {
+            QVERIFY2(rv != Score::FileError::FILE_NO_ERROR, qPrintable(QString("cut at %1").arg(len)));
+        }
+        delete score;
+    }
+}
+
 QTEST_MAIN(TestGuitarPro)
 #include "tst_guitarpro.moc"
@@ -20,6 +20,7 @@
 #include "libmscore/segment.h"
 #include "libmscore/chordrest.h"
 #include "libmscore/harmony.h"
+#include "libmscore/chordlist.h"
 #include "libmscore/duration.h"
 #include "libmscore/durationtype.h"
 
@@ -61,6 +62,7 @@ private slots:
     void testRealizeTriplet();
     void testRealizeDuration();
     void testRealizeJazz();
+    void testParseCacheTokens();
 };
 
 //---------------------------------------------------------
@@ -410,5 +412,30 @@ void TestChordSymbol::testRealizeJazz()
     test_post(score, "realize-jazz");
 }
 
+//---------------------------------------------------------
+//   testParseCacheTokens
+///   Check that chords parsed before the tokens of a chord
+///   list are read are parsed again with the tokens
+//---------------------------------------------------------
+void TestChordSymbol::testParseCacheTokens()
+{
+    const QStringList chords { "Cmaj7", "C-7b5", "C7sus4", "Cadd9", "Co7", "C7(#9b13)" };
+
+    ChordList reference;
+    QVERIFY(reference.read("chords.xml"));
+    QVERIFY(reference.read("chords_std.xml"));
+
+    ChordList list;
+    QVERIFY(list.read("chords.xml"));
+    for (const QString& s : chords) {
+        list.parse(s);
+    }
+    QVERIFY(list.read("chords_std.xml"));
+    for (const QString& s : chords) {
+        QCOMPARE(list.parse(s).handle(), reference.parse(s).handle());
+        QCOMPARE(list.parse(s).name(), reference.parse(s).name());
+    }
+}
+
 QTEST_MAIN(TestChordSymbol)
 #include "tst_chordsymbol.moc"
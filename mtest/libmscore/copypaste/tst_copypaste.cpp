@@ -19,6 +19,7 @@
 #include "libmscore/chord.h"
 #include "libmscore/xml.h"
 #include "libmscore/durationtype.h"
+#include "libmscore/staffclipboard.h"
 
 #define DIR QString("libmscore/copypaste/")
 
@@ -32,7 +33,7 @@ class TestCopyPaste : public QObject, public MTest
 {
     Q_OBJECT
 
-    void copypaste(const char*);
+    void copypaste(const char*, bool fromMemory = false);
     void copypastestaff(const char*);
     void copypastevoice(const char*, int);
     void copypastetuplet(const char*);
@@ -67,6 +68,12 @@ private slots:
     void copypaste25() { copypaste("25"); }         // copy full measure rest
     void copypaste26() { copypaste("26"); }         // Copy chords (#298541)
 
+    void copypasteMemory04() { copypaste("04", true); }   // start tie, in process clipboard
+    void copypasteMemory05() { copypaste("05", true); }   // end tie
+    void copypasteMemory06() { copypaste("06", true); }   // tie
+    void copypasteMemory12() { copypaste("12", true); }   // voices
+    void copypasteMemory25() { copypaste("25", true); }   // full measure rest
+
     void copypastestaff50() { copypastestaff("50"); }         // staff & slurs
 
     void copyPastePartial();
@@ -89,9 +96,11 @@ void TestCopyPaste::initTestCase()
 //---------------------------------------------------------
 //   copypaste
 //    copy measure 2, paste into measure 4
+//    fromMemory: paste from the StaffClipboard instead of xml,
+//    the result must be the same
 //---------------------------------------------------------
 
-void TestCopyPaste::copypaste(const char* idx)
+void TestCopyPaste::copypaste(const char* idx, bool fromMemory)
 {
     MasterScore* score = readScore(DIR + QString("copypaste%1.mscx").arg(idx));
     Measure* m1 = score->firstMeasure();
@@ -115,6 +124,10 @@ void TestCopyPaste::copypaste(const char* idx)
     QByteArray ba = score->selection().mimeData();
     mimeData->setData(mimeType, ba);
     QApplication::clipboard()->setMimeData(mimeData);
+    if (fromMemory) {
+        StaffClipboard::copy(score->selection(), ba);
+        QVERIFY(StaffClipboard::find(score, ba));
+    }
     QVERIFY(m4->first()->element(0) != 0);
     score->select(m4->first()->element(0));
 
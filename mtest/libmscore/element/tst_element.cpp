@@ -14,6 +14,9 @@
 
 #include "libmscore/score.h"
 #include "libmscore/element.h"
+#include "libmscore/note.h"
+#include "libmscore/rest.h"
+#include "libmscore/mmrest.h"
 #include "mtest/testutils.h"
 
 using namespace Ms;
@@ -29,6 +32,7 @@ class TestElement : public QObject, public MTest
 private slots:
     void initTestCase() { initMTest(); }
     void testIds();
+    void testElementPool();
 };
 
 //---------------------------------------------------------
@@ -104,6 +108,44 @@ void TestElement::testIds()
     }
 }
 
+//---------------------------------------------------------
+//   testElementPool
+//    pooled elements have to reuse freed slots, derived
+//    classes are served by the global heap
+//---------------------------------------------------------
+
+void TestElement::testElementPool()
+{
+    ElementPool& pool = ElementPool::pool<Note>("Note");
+    ElementPoolStatistics s0 = pool.statistics();
+
+    std::vector<Note*> notes;
+    for (int i = 0; i < 1000; ++i) {
+        notes.push_back(new Note(score));
+    }
+    ElementPoolStatistics s1 = pool.statistics();
+    QCOMPARE(s1.allocations - s0.allocations, size_t(1000));
+    QCOMPARE(s1.live - s0.live, size_t(1000));
+    QVERIFY(s1.capacity >= s1.live);
+
+    Note* last = notes.back();
+    qDeleteAll(notes);
+    ElementPoolStatistics s2 = pool.statistics();
+    QCOMPARE(s2.live, s0.live);
+    QCOMPARE(s2.capacity, s1.capacity);
+
+    // the last freed slot is handed out first
+    Note* n = new Note(score);
+    QCOMPARE(n, last);
+    delete n;
+
+    ElementPool& restPool = ElementPool::pool<Rest>("Rest");
+    size_t fallbacks = restPool.statistics().fallbacks;
+    Rest* r = new MMRest(score);
+    QCOMPARE(restPool.statistics().fallbacks, fallbacks + 1);
+    delete r;
+}
+
 QTEST_MAIN(TestElement)
 
 #include "tst_element.moc"
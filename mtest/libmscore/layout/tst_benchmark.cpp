@@ -13,8 +13,15 @@
 #include <QtTest/QtTest>
 #include "mtest/testutils.h"
 #include "libmscore/score.h"
+#include "libmscore/measure.h"
+#include "libmscore/segment.h"
+#include "libmscore/chord.h"
+#include "libmscore/stem.h"
+#include "libmscore/slurtie.h"
+#include "libmscore/system.h"
 
 #define DIR QString("libmscore/layout/")
+#define PIANO_SCORE (DIR + "pianobenchmark.mscx")      // eight measures for two staves
 
 using namespace Ms;
 
@@ -32,6 +39,7 @@ class TestBenchmark : public QObject, public MTest
 
     MasterScore * score;
     void beam(const char* path);
+    void incrementalLayout(bool reuseMeasures);
 
 private slots:
     void initTestCase();
@@ -39,6 +47,10 @@ private slots:
     void benchmark1();
     void benchmark2();
     void benchmark4();              // incremental layout (one page)
+    void benchmark5() { incrementalLayout(true); }    // edit in the middle of a piano score
+    void benchmark6() { incrementalLayout(false); }   // same, laying out all chords again
+    void measureLayoutCache();
+    void slurTieLayout();
 };
 
 //---------------------------------------------------------
@@ -90,5 +102,145 @@ void TestBenchmark::benchmark4()
     }
 }
 
+//---------------------------------------------------------
+//   firstChord
+//---------------------------------------------------------
+
+static Chord* firstChord(Score* s, int measureIdx)
+{
+    for (Segment* seg = s->crMeasure(measureIdx)->first(SegmentType::ChordRest); seg;
+         seg = seg->next(SegmentType::ChordRest)) {
+        if (seg->element(0) && seg->element(0)->isChord()) {
+            return toChord(seg->element(0));
+        }
+    }
+    return nullptr;
+}
+
+//---------------------------------------------------------
+//   layoutPositions
+//    measure widths, segment positions and stem lengths
+//---------------------------------------------------------
+
+static QVector<qreal> layoutPositions(Score* s)
+{
+    QVector<qreal> v;
+    for (Measure* m = s->firstMeasure(); m; m = m->nextMeasure()) {
+        v.append(m->width());
+        for (Segment* seg = m->first(SegmentType::ChordRest); seg; seg = seg->next(SegmentType::ChordRest)) {
+            v.append(seg->x());
+            for (Element* e : seg->elist()) {
+                if (e && e->isChord() && toChord(e)->stem()) {
+                    v.append(toChord(e)->stem()->len());
+                }
+            }
+        }
+    }
+    return v;
+}
+
+//---------------------------------------------------------
+//   incrementalLayout
+//    flip a stem in measure 201 of 400; without reusing
+//    measures the chords of all measures laid out again
+//    are laid out anew
+//---------------------------------------------------------
+
+void TestBenchmark::incrementalLayout(bool reuseMeasures)
+{
+    MasterScore* s = readRepeatedScore(PIANO_SCORE, 400);
+    Chord* chord = firstChord(s, 200);
+    QVERIFY(chord);
+
+    Direction d = Direction::UP;
+    QBENCHMARK {
+        if (!reuseMeasures) {
+            s->invalidateMeasureLayouts(Fraction(0, 1), Fraction(-1, 1));
+        }
+        d = d == Direction::UP ? Direction::DOWN : Direction::UP;
+        s->startCmd();
+        chord->undoChangeProperty(Pid::STEM_DIRECTION, QVariant::fromValue<Direction>(d));
+        s->endCmd();
+    }
+    delete s;
+}
+
+//---------------------------------------------------------
+//   measureLayoutCache
+//    an incremental layout reusing unchanged measures
+//    ends up where a full layout does
+//---------------------------------------------------------
+
+void TestBenchmark::measureLayoutCache()
+{
+    MasterScore* s = readRepeatedScore(PIANO_SCORE, 400);
+    Chord* chord = firstChord(s, 200);
+    QVERIFY(chord);
+
+    s->startCmd();
+    chord->undoChangeProperty(Pid::STEM_DIRECTION, QVariant::fromValue<Direction>(Direction::DOWN));
+    s->endCmd();
+    QVector<qreal> incremental = layoutPositions(s);
+    s->doLayout();
+    QCOMPARE(layoutPositions(s), incremental);
+
+    s->undoRedo(true, nullptr);
+    incremental = layoutPositions(s);
+    s->doLayout();
+    QCOMPARE(layoutPositions(s), incremental);
+
+    delete s;
+}
+
+//---------------------------------------------------------
+//   slurTiePositions
+//    positions, curves and shapes of all slur and tie
+//    segments
+//---------------------------------------------------------
+
+static QVector<qreal> slurTiePositions(Score* s)
+{
+    QVector<qreal> v;
+    for (System* system : s->systems()) {
+        for (SpannerSegment* ss : system->spannerSegments()) {
+            if (!ss->isSlurSegment() && !ss->isTieSegment()) {
+                continue;
+            }
+            SlurTieSegment* sts = static_cast<SlurTieSegment*>(ss);
+            v << sts->pos().x() << sts->pos().y();
+            for (int i = 0; i < int(Grip::GRIPS); ++i) {
+                v << sts->ups(Grip(i)).p.x() << sts->ups(Grip(i)).p.y();
+            }
+            for (const ShapeElement& r : sts->shape()) {
+                v << r.x() << r.y() << r.width() << r.height();
+            }
+        }
+    }
+    return v;
+}
+
+//---------------------------------------------------------
+//   slurTieLayout
+//    slurs and ties laid out on several threads end up
+//    where a serial layout puts them
+//---------------------------------------------------------
+
+void TestBenchmark::slurTieLayout()
+{
+    MasterScore* s = readScore("libmscore/all_elements/moonlight.mscx");
+    SlurTieLayout::setMaxThreads(1);
+    s->doLayout();
+    QVector<qreal> serial = slurTiePositions(s);
+    QVERIFY(!serial.isEmpty());
+
+    SlurTieLayout::setMaxThreads(4);
+    for (int i = 0; i < 3; ++i) {
+        s->doLayout();
+        QCOMPARE(slurTiePositions(s), serial);
+    }
+    SlurTieLayout::setMaxThreads(0);
+    delete s;
+}
+
 QTEST_MAIN(TestBenchmark)
 #include "tst_benchmark.moc"
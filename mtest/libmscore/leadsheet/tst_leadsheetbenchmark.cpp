@@ -0,0 +1,138 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+#include "mtest/testutils.h"
+#include "libmscore/score.h"
+#include "libmscore/measure.h"
+#include "libmscore/segment.h"
+#include "libmscore/harmony.h"
+#include "libmscore/undo.h"
+
+#define DIR QString("libmscore/leadsheet/")
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestLeadSheetBenchmark
+//    loading, parsing and transposing the chord symbols
+//    of a 2000 measure lead sheet
+//---------------------------------------------------------
+
+class TestLeadSheetBenchmark : public QObject, public MTest
+{
+    Q_OBJECT
+
+    MasterScore* score { nullptr };
+
+    std::vector<Harmony*> harmonies() const;
+
+private slots:
+    void initTestCase();
+    void load();
+    void parse();
+    void transpose();
+};
+
+//---------------------------------------------------------
+//   initTestCase
+//    build the score by appending an eight measure pattern
+//    with four chord symbols per measure
+//---------------------------------------------------------
+
+void TestLeadSheetBenchmark::initTestCase()
+{
+    initMTest();
+    score = readRepeatedScore(DIR + "leadsheetbenchmark.mscx", 2000);
+    QVERIFY(score);
+    QCOMPARE(score->nmeasures(), 2000);
+    QCOMPARE(int(harmonies().size()), 2000 * 4);
+}
+
+//---------------------------------------------------------
+//   harmonies
+//---------------------------------------------------------
+
+std::vector<Harmony*> TestLeadSheetBenchmark::harmonies() const
+{
+    std::vector<Harmony*> hl;
+    for (Segment* s = score->firstSegment(SegmentType::ChordRest); s; s = s->next1(SegmentType::ChordRest)) {
+        for (Element* e : s->annotations()) {
+            if (e->isHarmony()) {
+                hl.push_back(toHarmony(e));
+            }
+        }
+    }
+    return hl;
+}
+
+//---------------------------------------------------------
+//   load
+//---------------------------------------------------------
+
+void TestLeadSheetBenchmark::load()
+{
+    QVERIFY(saveScore(score, "leadsheetbenchmark-2000.mscx"));
+    QBENCHMARK {
+        MasterScore* s = readCreatedScore("leadsheetbenchmark-2000.mscx");
+        QVERIFY(s);
+        delete s;
+    }
+}
+
+//---------------------------------------------------------
+//   parse
+//    enter the text of every chord symbol again
+//---------------------------------------------------------
+
+void TestLeadSheetBenchmark::parse()
+{
+    std::vector<Harmony*> hl = harmonies();
+    std::vector<QString> names;
+    for (Harmony* h : hl) {
+        names.push_back(h->harmonyName());
+    }
+
+    QBENCHMARK {
+        for (size_t i = 0; i < hl.size(); ++i) {
+            hl[i]->setHarmony(names[i]);
+        }
+    }
+    for (size_t i = 0; i < hl.size(); ++i) {
+        QCOMPARE(hl[i]->harmonyName(), names[i]);
+    }
+}
+
+//---------------------------------------------------------
+//   transpose
+//    up a major third and back by undo
+//---------------------------------------------------------
+
+void TestLeadSheetBenchmark::transpose()
+{
+    Harmony* h = harmonies().front();
+    int tpc = h->rootTpc();
+
+    QBENCHMARK {
+        score->startCmd();
+        score->cmdSelectAll();
+        score->transpose(TransposeMode::BY_INTERVAL, TransposeDirection::UP, Key::C, 4, false, true, true);
+        score->endCmd();
+        QVERIFY(h->rootTpc() != tpc);
+        score->undoRedo(true, 0);
+        QCOMPARE(h->rootTpc(), tpc);
+    }
+    score->deselectAll();
+}
+
+QTEST_MAIN(TestLeadSheetBenchmark)
+#include "tst_leadsheetbenchmark.moc"
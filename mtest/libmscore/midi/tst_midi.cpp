@@ -81,6 +81,7 @@ private slots:
     void midiTimeStretchFermataTempoEdit();
     void midiTimeStretchFermataTempoEditContinuousView();
     void midiSingleNoteDynamics();
+    void playEventsRange();
 };
 
 //---------------------------------------------------------
@@ -531,6 +532,65 @@ void TestMidi::midiSingleNoteDynamics()
     delete score;
 }
 
+//---------------------------------------------------------
+//   playEventsRange
+//    an edit near the end of a 2000 measure score renews
+//    the ties and play events of the edited measures only
+//---------------------------------------------------------
+
+void TestMidi::playEventsRange()
+{
+    MasterScore* score = readRepeatedScore(DIR + "testSwing8thTies.mscx", 2000);
+    QVERIFY(score);
+    QCOMPARE(score->nmeasures(), 2000);
+
+    EventMap events;
+    SynthesizerState ss;
+    score->renderMidi(&events, ss);
+    QCOMPARE(score->playEventsValidTo(), score->endTick());
+    QVERIFY(score->checkPlayEvents());
+
+    // mark the first note, renewing its play events would reset the mark
+    Note* first = toChord(score->firstSegment(SegmentType::ChordRest)->element(0))->upNote();
+    const NoteEventList playEvents = first->playEvents();
+    NoteEventList marked = playEvents;
+    marked[0].setLen(123);
+    first->setPlayEvents(marked);
+
+    // lengthen the last chord of measure 1995 across the barline
+    ChordRest* cr = nullptr;
+    Measure* m = score->crMeasure(1994);
+    for (Segment* s = m->first(SegmentType::ChordRest); s; s = s->next(SegmentType::ChordRest)) {
+        if (s->element(0) && s->element(0)->isChord()) {
+            cr = toChordRest(s->element(0));
+        }
+    }
+    QVERIFY(cr);
+    score->startCmd();
+    score->changeCRlen(cr, Fraction(1, 2));
+    score->endCmd();
+    QVERIFY(score->checkTies());
+    QVERIFY(score->playEventsValidTo() >= score->crMeasure(1990)->tick());
+    QVERIFY(score->playEventsValidTo() < score->endTick());
+
+    events.clear();
+    score->renderMidi(&events, ss);
+    QCOMPARE(score->playEventsValidTo(), score->endTick());
+    QVERIFY(first->playEvents() == marked);
+    first->setPlayEvents(playEvents);
+    QVERIFY(score->checkPlayEvents());
+
+    // undo starts from the edited measure as well
+    score->undoRedo(true, nullptr);
+    QVERIFY(score->checkTies());
+    QVERIFY(score->playEventsValidTo() >= score->crMeasure(1990)->tick());
+    events.clear();
+    score->renderMidi(&events, ss);
+    QVERIFY(score->checkPlayEvents());
+
+    delete score;
+}
+
 //---------------------------------------------------------
 //   events
 //---------------------------------------------------------
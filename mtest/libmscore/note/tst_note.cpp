@@ -25,6 +25,7 @@
 #include "libmscore/sym.h"
 #include "libmscore/key.h"
 #include "libmscore/pitchspelling.h"
+#include "libmscore/undo.h"
 #include "mtest/testutils.h"
 
 #define DIR QString("libmscore/note/")
@@ -49,6 +50,8 @@ private slots:
     void noteLimits();
     void tpcDegrees();
     void LongNoteAfterShort_183746();
+    void batchPropertyChange();
+    void spell();
 };
 
 //---------------------------------------------------------
@@ -544,6 +547,168 @@ void TestNote::LongNoteAfterShort_183746()
     QVERIFY(totalTicks == breveTicks);   // total duration same as a breve
 }
 
+//---------------------------------------------------------
+///   batchPropertyChange
+///    change the color of many notes in one property batch
+///    and verify it is recorded as a single undo command
+//---------------------------------------------------------
+
+void TestNote::batchPropertyChange()
+{
+    MasterScore* score = readScore(DIR + "empty.mscx");
+
+    score->inputState().setTrack(0);
+    score->inputState().setSegment(score->tick2segment(Fraction(0,1), false, SegmentType::ChordRest));
+    score->inputState().setDuration(TDuration::DurationType::V_QUARTER);
+    score->inputState().setNoteEntryMode(true);
+    for (int i = 0; i < 8; ++i) {
+        score->cmdAddPitch(60 + i, false, false);
+        score->cmdAddPitch(64 + i, true, false);
+    }
+
+    std::vector<Note*> notes;
+    for (Segment* s = score->firstSegment(SegmentType::ChordRest); s; s = s->next1(SegmentType::ChordRest)) {
+        Element* e = s->element(0);
+        if (e && e->isChord()) {
+            for (Note* n : toChord(e)->notes()) {
+                notes.push_back(n);
+            }
+        }
+    }
+    QCOMPARE(int(notes.size()), 16);
+
+    const QColor red(Qt::red);
+    score->startCmd();
+    score->undoStack()->beginPropertyBatch();
+    for (Note* n : notes) {
+        n->undoChangeProperty(Pid::COLOR, red);
+    }
+    score->undoStack()->endPropertyBatch();
+    score->endCmd();
+
+    UndoMacro* macro = score->undoStack()->last();
+    QVERIFY(macro);
+    QCOMPARE(macro->childCount(), 1);
+    QCOMPARE(QString(macro->commands().front()->name()), QString("ChangePropertyBatch"));
+    for (Note* n : notes) {
+        QCOMPARE(n->color(), red);
+    }
+
+    score->undoRedo(true, 0);
+    for (Note* n : notes) {
+        QVERIFY(n->color() != red);
+    }
+
+    score->undoRedo(false, 0);
+    for (Note* n : notes) {
+        QCOMPARE(n->color(), red);
+    }
+}
+
+//---------------------------------------------------------
+//   spell
+//    spellTpcs() on lines with known spellings in C major,
+//    and against the sliding window spelling on real scores
+//---------------------------------------------------------
+
+void TestNote::spell()
+{
+    MasterScore* score = readScore(DIR + "empty.mscx");
+
+    static const std::vector<std::vector<int> > lines {
+        { 60, 61, 62, 63, 64, 65, 66, 67, 68, 69, 70, 71, 72 },
+        { 60, 64, 67, 70, 69, 65, 66, 67 },
+        { 69, 68, 69, 71, 72, 71, 70, 69 },
+    };
+    static const std::vector<std::vector<int> > spellings {
+        { Tpc::TPC_C, Tpc::TPC_C_S, Tpc::TPC_D, Tpc::TPC_D_S, Tpc::TPC_E, Tpc::TPC_F, Tpc::TPC_F_S,
+          Tpc::TPC_G, Tpc::TPC_G_S, Tpc::TPC_A, Tpc::TPC_A_S, Tpc::TPC_B, Tpc::TPC_C },
+        { Tpc::TPC_C, Tpc::TPC_E, Tpc::TPC_G, Tpc::TPC_B_B, Tpc::TPC_A, Tpc::TPC_F, Tpc::TPC_F_S, Tpc::TPC_G },
+        { Tpc::TPC_A, Tpc::TPC_G_S, Tpc::TPC_A, Tpc::TPC_B, Tpc::TPC_C, Tpc::TPC_B, Tpc::TPC_A_S, Tpc::TPC_A },
+    };
+
+    score->inputState().setTrack(0);
+    score->inputState().setSegment(score->tick2segment(Fraction(0,1), false, SegmentType::ChordRest));
+    score->inputState().setDuration(TDuration::DurationType::V_QUARTER);
+    score->inputState().setNoteEntryMode(true);
+    score->startCmd();
+    for (const std::vector<int>& line : lines) {
+        for (int pitch : line) {
+            score->addMidiPitch(pitch, false);
+        }
+    }
+    score->endCmd();
+
+    std::vector<Note*> notes;
+    for (Segment* s = score->firstSegment(SegmentType::ChordRest); s; s = s->next1(SegmentType::ChordRest)) {
+        Element* e = s->element(0);
+        if (e && e->isChord()) {
+            notes.push_back(toChord(e)->upNote());
+        }
+    }
+
+    auto first = notes.begin();
+    for (size_t i = 0; i < lines.size(); ++i) {
+        QVERIFY(notes.end() - first >= int(lines[i].size()));
+        std::vector<Note*> lineNotes(first, first + lines[i].size());
+        QCOMPARE(spellTpcs(lineNotes), spellings[i]);
+        first += lines[i].size();
+    }
+    QVERIFY(first == notes.end());
+
+    // Score::spell() spells the whole staff as one list
+    std::vector<int> tpcs = spellTpcs(notes);
+    score->startCmd();
+    score->spell();
+    score->endCmd();
+    for (size_t i = 0; i < notes.size(); ++i) {
+        QCOMPARE(notes[i]->tpc1(), tpcs[i]);
+    }
+
+    delete score;
+
+    // the staves of some real scores, in the order Score::spell() collects them
+    static const QStringList files {
+        "libmscore/all_elements/moonlight.mscx",
+        "libmscore/midi/testAndanteExcerpts.mscx",
+        "libmscore/midi/testKantataBWV140Excerpts.mscx",
+    };
+    for (const QString& file : files) {
+        score = readScore(file);
+        QVERIFY(score);
+        for (int staff = 0; staff < score->nstaves(); ++staff) {
+            std::vector<Note*> staffNotes;
+            for (Segment* s = score->firstSegment(SegmentType::All); s; s = s->next1()) {
+                for (int track = staff * VOICES; track < (staff + 1) * VOICES; ++track) {
+                    Element* e = s->element(track);
+                    if (e && e->isChord()) {
+                        staffNotes.insert(staffNotes.end(), toChord(e)->notes().begin(), toChord(e)->notes().end());
+                    }
+                }
+            }
+            if (staffNotes.size() < 6) {      // the windowed spelling leaves shorter lists unspelled
+                continue;
+            }
+            std::vector<int> viterbi = spellTpcs(staffNotes);
+            std::vector<int> windowed = spellTpcsWindowed(staffNotes);
+            int same = 0;
+            for (size_t i = 0; i < staffNotes.size(); ++i) {
+                QCOMPARE((tpc2pitch(viterbi[i]) + 120 - staffNotes[i]->pitch()) % 12, 0);
+                QCOMPARE((tpc2pitch(windowed[i]) + 120 - staffNotes[i]->pitch()) % 12, 0);
+                if (viterbi[i] == windowed[i]) {
+                    ++same;
+                }
+            }
+            QVERIFY(spellingPenalty(staffNotes, viterbi) <= spellingPenalty(staffNotes, windowed));
+            // both minimize the same penalties, so they should mostly agree
+            QVERIFY2(same * 10 >= int(staffNotes.size()) * 9,
+                     qPrintable(QString("%1 staff %2: %3 of %4 spellings differ")
+                                .arg(file).arg(staff).arg(int(staffNotes.size()) - same).arg(staffNotes.size())));
+        }
+        delete score;
+    }
+}
+
 QTEST_MAIN(TestNote)
 
 #include "tst_note.moc"
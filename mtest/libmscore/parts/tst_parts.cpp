@@ -29,6 +29,10 @@
 #include "libmscore/sym.h"
 #include "libmscore/chordline.h"
 #include "libmscore/sym.h"
+#include "libmscore/measurewritecache.h"
+#include "libmscore/imageStore.h"
+#include "thirdparty/qzip/qzipreader_p.h"
+#include "thirdparty/qzip/qzipwriter_p.h"
 #include "mtest/testutils.h"
 
 #define DIR QString("libmscore/parts/")
@@ -64,6 +68,11 @@ private slots:
 
     void createPart1();
     void createPart2();
+    void createPartsParallel();
+    void readPartsParallel();
+    void readPartsLazily();
+    void readCompressed();
+    void readLazyImages();
     void voicesExcerpt();
 
     void createPartBreath();
@@ -125,6 +134,7 @@ private slots:
 //      void staffStyles();
 
     void measureProperties();
+    void measureWriteCache();
 
     // second part has system text on empty chordrest segment
     void createPart3()
@@ -405,6 +415,275 @@ void TestParts::createPart2()
     testPartCreation("part-all");
 }
 
+//---------------------------------------------------------
+//   createPartsParallel
+//    parts cloned and laid out on several threads are
+//    the same as parts created one after the other
+//---------------------------------------------------------
+
+void TestParts::createPartsParallel()
+{
+    MasterScore* score = readScore(DIR + "part-all.mscx");
+    QVERIFY(score);
+
+    QList<Excerpt*> excerpts;
+    for (Part* part : score->parts()) {
+        Excerpt* ex = new Excerpt(score);
+        ex->setPartScore(new Score(score));
+        ex->setParts(QList<Part*>({ part }));
+        ex->setTitle(part->partName());
+        score->excerpts().append(ex);
+        excerpts.append(ex);
+    }
+    Excerpt::createExcerpts(excerpts);
+    score->setExcerptsChanged(true);
+    QVERIFY(saveCompareScore(score, "part-all-parallel.mscx", DIR + "part-all-parts.mscx"));
+
+    // the notes of every part are linked to the notes of the score
+    for (Excerpt* ex : excerpts) {
+        for (Segment* s = ex->partScore()->firstSegment(SegmentType::ChordRest); s; s = s->next1(SegmentType::ChordRest)) {
+            for (Element* e : s->elist()) {
+                if (!e || !e->isChord()) {
+                    continue;
+                }
+                for (Note* n : toChord(e)->notes()) {
+                    QVERIFY(n->links());
+                    QVERIFY(n->links()->lid() >= 0);      // not a private list of a stage
+                    QVERIFY(n->links()->mainElement()->score() == score);
+                }
+            }
+        }
+    }
+    delete score;
+}
+
+//---------------------------------------------------------
+//   readPartsParallel
+//    parts read on several threads are the same as
+//    parts read one after the other
+//---------------------------------------------------------
+
+void TestParts::readPartsParallel()
+{
+    MScore::readThreads = 1;
+    MasterScore* score  = readScore(DIR + "part-all-parts.mscx");
+    QVERIFY(score);
+    QVERIFY(saveScore(score, "part-all-read-serial.mscx"));
+    delete score;
+
+    MScore::readThreads = 4;
+    score = readScore(DIR + "part-all-parts.mscx");
+    MScore::readThreads = 0;
+    QVERIFY(score);
+    QVERIFY(saveScore(score, "part-all-read-parallel.mscx"));
+    QVERIFY(compareFilesFromPaths("part-all-read-parallel.mscx", "part-all-read-serial.mscx"));
+
+    // the notes of every part are linked to the notes of the score
+    QVERIFY(!score->excerpts().isEmpty());
+    for (Excerpt* ex : score->excerpts()) {
+        for (Segment* s = ex->partScore()->firstSegment(SegmentType::ChordRest); s; s = s->next1(SegmentType::ChordRest)) {
+            for (Element* e : s->elist()) {
+                if (!e || !e->isChord()) {
+                    continue;
+                }
+                for (Note* n : toChord(e)->notes()) {
+                    QVERIFY(n->links());
+                    QVERIFY(n->links()->lid() >= 0);      // not a private list of a stage
+                    QVERIFY(n->links()->mainElement()->score() == score);
+                }
+            }
+        }
+    }
+    delete score;
+}
+
+//---------------------------------------------------------
+//   readPartsLazily
+//    part scores kept unread after loading are read when
+//    they are asked for, edited or saved; an edit of a
+//    staff reads only the parts of the staff
+//---------------------------------------------------------
+
+void TestParts::readPartsLazily()
+{
+    MasterScore* score = readScore(DIR + "part-all-parts.mscx");
+    QVERIFY(score);
+    QVERIFY(saveScore(score, "part-all-read.mscx"));
+    delete score;
+
+    MScore::lazyExcerpts = true;
+    score = readScore(DIR + "part-all-parts.mscx");
+    MScore::lazyExcerpts = false;
+    QVERIFY(score);
+    QCOMPARE(score->excerpts().size(), 2);
+    for (int i = 0; i < 2; ++i) {
+        Excerpt* ex = score->excerpts().at(i);
+        QVERIFY(!ex->isPartScoreRead());
+        QVERIFY(!ex->title().isEmpty());
+        QCOMPARE(ex->parts(), QList<Part*>({ score->parts().at(i) }));
+    }
+    QCOMPARE(score->scoreList().size(), 1);
+
+    // the accessors do not read a part score
+    Excerpt* first  = score->excerpts().at(0);
+    Excerpt* second = score->excerpts().at(1);
+    QVERIFY(first->partScore());
+    QVERIFY(!first->isPartScoreRead());
+
+    // an edit of the second staff reads only its part
+    ChordRest* cr = score->firstSegment(SegmentType::ChordRest)->cr(VOICES);
+    QVERIFY(cr);
+    score->select(cr, SelectType::SINGLE, 1);
+    score->startCmd();
+    QVERIFY(!first->isPartScoreRead());
+    QVERIFY(second->isPartScoreRead());
+    QCOMPARE(second->parts(), QList<Part*>({ score->parts().at(1) }));
+    score->endCmd();
+    QCOMPARE(score->scoreList().size(), 2);
+
+    Excerpt::readPartScores(score->excerpts());
+    QVERIFY(first->isPartScoreRead());
+    QVERIFY(first->partScore()->nstaves() > 0);
+    QCOMPARE(score->scoreList().size(), 3);
+
+    QVERIFY(saveScore(score, "part-all-read-lazily.mscx"));
+    QVERIFY(compareFilesFromPaths("part-all-read-lazily.mscx", "part-all-read.mscx"));
+    delete score;
+
+    // a change of the measures reads all of them
+    MScore::lazyExcerpts = true;
+    score = readScore(DIR + "part-all-parts.mscx");
+    MScore::lazyExcerpts = false;
+    QVERIFY(score);
+    cr = score->firstSegment(SegmentType::ChordRest)->cr(0);
+    QVERIFY(cr);
+    score->select(cr, SelectType::SINGLE, 0);
+    score->startCmd();
+    QVERIFY(score->excerpts().at(0)->isPartScoreRead());
+    QVERIFY(!score->excerpts().at(1)->isPartScoreRead());
+    score->insertMeasure(ElementType::MEASURE, score->firstMeasure());
+    for (Excerpt* ex : score->excerpts()) {
+        QVERIFY(ex->isPartScoreRead());
+    }
+    score->endCmd();
+    delete score;
+}
+
+//---------------------------------------------------------
+//   readCompressed
+//    the score file of a .mscz is inflated while it is read
+//---------------------------------------------------------
+
+void TestParts::readCompressed()
+{
+    MasterScore* score = readScore(DIR + "part-all-parts.mscx");
+    QVERIFY(score);
+    QVERIFY(saveScore(score, "part-all-uncompressed.mscx"));
+    QFileInfo fi("part-all-compressed.mscz");
+    QVERIFY(score->saveCompressedFile(fi, false, false));
+    delete score;
+
+    score = readCreatedScore("part-all-compressed.mscz");
+    QVERIFY(score);
+    QCOMPARE(score->excerpts().size(), 2);
+    QVERIFY(saveScore(score, "part-all-compressed.mscx"));
+    QVERIFY(compareFilesFromPaths("part-all-compressed.mscx", "part-all-uncompressed.mscx"));
+    delete score;
+}
+
+//---------------------------------------------------------
+//   firstImage
+//---------------------------------------------------------
+
+static Image* firstImage(Score* score)
+{
+    for (Element* e : score->first()->el()) {
+        if (e->isImage()) {
+            return toImage(e);
+        }
+    }
+    return 0;
+}
+
+//---------------------------------------------------------
+//   readLazyImages
+//    the images of a .mscz are read from its deflated or
+//    stored entries on first use; an image which is not in
+//    the file anymore makes saving fail
+//---------------------------------------------------------
+
+void TestParts::readLazyImages()
+{
+    MasterScore* score = readScore(DIR + "part-image.mscx");
+    QVERIFY(score);
+    Image* image = firstImage(score);
+    QVERIFY(image && image->storeItem());
+    const QByteArray png = image->storeItem()->buffer();
+    const QString name = "Pictures/" + image->storeItem()->hashName();
+    QVERIFY(!png.isEmpty());
+    QFileInfo fi("part-image-lazy.mscz");
+    QVERIFY(score->saveCompressedFile(fi, false, false));
+    delete score;
+
+    // deflated; the image is read before its file is overwritten
+    score = readCreatedScore("part-image-lazy.mscz");
+    QVERIFY(score);
+    QCOMPARE(firstImage(score)->storeItem()->buffer(), png);
+    QVERIFY(saveScore(score, "part-image-deflated.mscx"));
+    QVERIFY(score->saveCompressedFile(fi, false, false));
+    delete score;
+    QCOMPARE(MQZipReader("part-image-lazy.mscz").fileData(name), png);
+
+    // stored
+    {
+        MQZipReader in("part-image-lazy.mscz");
+        MQZipWriter out("part-image-stored.mscz");
+        out.setCompressionPolicy(MQZipWriter::NeverCompress);
+        for (const MQZipReader::FileInfo& info : in.fileInfoList()) {
+            if (info.isFile) {
+                out.addFile(info.filePath, in.fileData(info.filePath));
+            }
+        }
+        out.close();
+    }
+    {
+        MQZipReader in("part-image-stored.mscz");
+        std::unique_ptr<QIODevice> device(in.openFile(name));
+        QVERIFY(device);
+        QCOMPARE(device->readAll(), png);
+        QVERIFY(device->atEnd());
+    }
+    score = readCreatedScore("part-image-stored.mscz");
+    QVERIFY(score);
+    QCOMPARE(firstImage(score)->storeItem()->buffer(), png);
+    QVERIFY(saveScore(score, "part-image-stored.mscx"));
+    QVERIFY(compareFilesFromPaths("part-image-stored.mscx", "part-image-deflated.mscx"));
+    delete score;
+
+    // the file is replaced before the image is first used
+    QFile::remove("part-image-replaced.mscz");
+    QVERIFY(QFile::copy("part-image-lazy.mscz", "part-image-replaced.mscz"));
+    score = new MasterScore(mscore->baseStyle());
+    {
+        ScoreLoad sl;
+        QVERIFY(score->loadMsc("part-image-replaced.mscz", false) == Score::FileError::FILE_NO_ERROR);
+    }
+    ImageStoreItem* item = firstImage(score)->storeItem();
+    QVERIFY(item && !item->loaded());
+    {
+        MQZipWriter out("part-image-replaced.mscz");
+        out.addFile(name, QByteArray("not the picture"));
+        out.close();
+    }
+    QVERIFY(item->buffer().isEmpty());
+    QVERIFY(item->loadFailed());
+    QFile::remove("part-image-failed.mscz");
+    QFileInfo failed("part-image-failed.mscz");
+    QVERIFY(!score->saveCompressedFile(failed, false, false));
+    QVERIFY(!QFile::exists("part-image-failed.mscz"));
+    delete score;
+}
+
 void TestParts::createPartBreath()
 {
     testPartCreation("part-breath");
@@ -1208,6 +1487,43 @@ void TestParts::measureProperties()
 {
 }
 
+//---------------------------------------------------------
+//   measureWriteCache
+//    saving from the fragments of the previous save gives
+//    the same file as a full save
+//---------------------------------------------------------
+
+void TestParts::measureWriteCache()
+{
+    MasterScore* score = readScore(DIR + "part-empty-parts.mscx");
+    QVERIFY(score);
+    score->setMeasureWriteCacheEnabled(true);
+    QVERIFY(saveScore(score, "part-cache.mscx"));
+    QVERIFY(score->measureWriteCache());
+    QCOMPARE(score->measureWriteCache()->hits(), 0);
+
+    Measure* m   = score->firstMeasure();
+    Segment* s   = m->tick2segment(Fraction(1, 4));
+    Ms::Chord* chord = toChord(s->element(0));
+    Note* note   = chord->upNote();
+    EditData dd(0);
+    Breath* b = new Breath(score);
+    b->setSymId(SymId::breathMarkComma);
+    dd.dropElement = b;
+
+    score->startCmd();
+    note->drop(dd);
+    score->endCmd();
+
+    QVERIFY(saveCompareScore(score, "part-cache-breath-add.mscx", DIR + "part-breath-add.mscx"));
+    QVERIFY(score->measureWriteCache()->hits() > 0);
+
+    score->undoRedo(true, 0);
+    QVERIFY(saveCompareScore(score, "part-cache-breath-uadd.mscx", DIR + "part-breath-uadd.mscx"));
+
+    delete score;
+}
+
 QTEST_MAIN(TestParts)
 
 #include "tst_parts.moc"
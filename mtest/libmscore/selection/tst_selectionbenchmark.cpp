@@ -0,0 +1,203 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+#include "mtest/testutils.h"
+#include "libmscore/score.h"
+#include "libmscore/measure.h"
+#include "libmscore/segment.h"
+#include "libmscore/chord.h"
+#include "libmscore/note.h"
+#include "libmscore/staffclipboard.h"
+
+#define DIR QString("libmscore/selection/")
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestSelectionBenchmark
+//    range and list selection, copy and paste on a 5000
+//    measure piano score
+//---------------------------------------------------------
+
+class TestSelectionBenchmark : public QObject, public MTest
+{
+    Q_OBJECT
+
+    MasterScore* score { nullptr };
+
+    void selectCopyRange();
+    void pasteRange(bool fromMemory);
+
+private slots:
+    void initTestCase();
+    void selectAll();
+    void extendRange();
+    void addNotes();
+    void copyRange();
+    void pasteRangeXml() { pasteRange(false); }
+    void pasteRangeFromMemory() { pasteRange(true); }
+};
+
+//---------------------------------------------------------
+//   initTestCase
+//    build the score by appending an eight measure pattern
+//---------------------------------------------------------
+
+void TestSelectionBenchmark::initTestCase()
+{
+    initMTest();
+    score = readRepeatedScore(DIR + "selectionbenchmark.mscx", 5000);
+    QVERIFY(score);
+    QCOMPARE(score->nmeasures(), 5000);
+}
+
+//---------------------------------------------------------
+//   selectAll
+//---------------------------------------------------------
+
+void TestSelectionBenchmark::selectAll()
+{
+    QBENCHMARK {
+        score->cmdSelectAll();
+    }
+    QVERIFY(score->selection().isRange());
+    // two notes, a stem and a beam per chord at least
+    QVERIFY(score->selection().elements().size() > 5000 * 16 * 3);
+    score->deselectAll();
+}
+
+//---------------------------------------------------------
+//   extendRange
+//    shift+click from the first to the last chord
+//---------------------------------------------------------
+
+void TestSelectionBenchmark::extendRange()
+{
+    Segment* first = score->firstMeasure()->first(SegmentType::ChordRest);
+    Segment* last = score->lastMeasure()->last()->prev1(SegmentType::ChordRest);
+    Element* firstChord = first->element(0);
+    Element* lastChord = last->element(VOICES);
+
+    QBENCHMARK {
+        score->select(firstChord, SelectType::SINGLE, 0);
+        score->select(lastChord, SelectType::RANGE, 1);
+    }
+    QVERIFY(score->selection().isRange());
+    QVERIFY(score->selection().contains(toChord(lastChord)->upNote()));
+    score->deselectAll();
+}
+
+//---------------------------------------------------------
+//   addNotes
+//    ctrl+click on every note of the first staff
+//---------------------------------------------------------
+
+void TestSelectionBenchmark::addNotes()
+{
+    std::vector<Note*> notes;
+    for (Segment* s = score->firstSegment(SegmentType::ChordRest); s; s = s->next1(SegmentType::ChordRest)) {
+        Element* e = s->element(0);
+        if (e && e->isChord()) {
+            for (Note* n : toChord(e)->notes()) {
+                notes.push_back(n);
+            }
+        }
+    }
+
+    QBENCHMARK {
+        score->deselectAll();
+        for (Note* n : notes) {
+            score->select(n, SelectType::ADD, 0);
+        }
+    }
+    QCOMPARE(score->selection().elements().size(), int(notes.size()));
+    score->deselectAll();
+}
+
+//---------------------------------------------------------
+//   selectCopyRange
+//    the first 500 measures of both staves
+//---------------------------------------------------------
+
+void TestSelectionBenchmark::selectCopyRange()
+{
+    score->select(score->crMeasure(0), SelectType::SINGLE, 0);
+    score->select(score->crMeasure(499), SelectType::RANGE, score->nstaves() - 1);
+    QVERIFY(score->selection().isRange());
+}
+
+//---------------------------------------------------------
+//   copyRange
+//    test mode writes generated beams to the clipboard,
+//    which are only pasted from xml, so copy and paste
+//    as the application does
+//---------------------------------------------------------
+
+void TestSelectionBenchmark::copyRange()
+{
+    bool testMode = MScore::testMode;
+    MScore::testMode = false;
+    selectCopyRange();
+
+    QByteArray data;
+    QBENCHMARK {
+        data = score->selection().mimeData();
+        StaffClipboard::copy(score->selection(), data);
+    }
+    QVERIFY(StaffClipboard::find(score, data));
+
+    StaffClipboard::clear();
+    score->deselectAll();
+    MScore::testMode = testMode;
+}
+
+//---------------------------------------------------------
+//   pasteRange
+//    paste the copied range at measure 2001; every paste
+//    is rolled back so that all iterations do the same
+//---------------------------------------------------------
+
+void TestSelectionBenchmark::pasteRange(bool fromMemory)
+{
+    bool testMode = MScore::testMode;
+    MScore::testMode = false;
+    selectCopyRange();
+
+    QByteArray data = score->selection().mimeData();
+    QMimeData mimeData;
+    mimeData.setData(mimeStaffListFormat, data);
+    if (fromMemory) {
+        StaffClipboard::copy(score->selection(), data);
+        QVERIFY(StaffClipboard::find(score, data));
+    } else {
+        StaffClipboard::clear();
+    }
+
+    Element* dst = score->crMeasure(2000)->first(SegmentType::ChordRest)->element(0);
+    QBENCHMARK {
+        score->select(dst, SelectType::SINGLE, 0);
+        score->startCmd();
+        score->cmdPaste(&mimeData, 0);
+        QVERIFY(score->selection().isRange());
+        QCOMPARE(score->selection().tickStart(), dst->tick());
+        score->endCmd(false, true);
+    }
+    QCOMPARE(score->nmeasures(), 5000);
+
+    StaffClipboard::clear();
+    score->deselectAll();
+    MScore::testMode = testMode;
+}
+
+QTEST_MAIN(TestSelectionBenchmark)
+#include "tst_selectionbenchmark.moc"
@@ -0,0 +1,254 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <set>
+
+#include <QtTest/QtTest>
+#include "mtest/testutils.h"
+#include "libmscore/score.h"
+#include "libmscore/hairpin.h"
+#include "libmscore/spannermap.h"
+
+using namespace Ms;
+
+static const int SPANNERS = 50000;
+static const int TICKS    = 480 * 4 * 5000;
+
+//---------------------------------------------------------
+//   TestSpannerMapBenchmark
+//    a spanner map with 50000 hairpins over 5000 measures,
+//    checked against a linear search
+//---------------------------------------------------------
+
+class TestSpannerMapBenchmark : public QObject, public MTest
+{
+    Q_OBJECT
+
+    std::vector<Spanner*> spanners;
+    QRandomGenerator random { 1 };
+
+    void randomTicks(Spanner* s);
+    void compare(SpannerMap& map, const std::vector<Spanner*>& sl, int start, int stop);
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void randomChanges();
+    void addSpanners();
+    void addAndFind();
+    void changeTicks();
+    void removeSpanners();
+};
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestSpannerMapBenchmark::initTestCase()
+{
+    initMTest();
+    for (int i = 0; i < SPANNERS; ++i) {
+        Spanner* s = new Hairpin(score);
+        s->setTrack(i % 8);
+        randomTicks(s);
+        spanners.push_back(s);
+    }
+}
+
+//---------------------------------------------------------
+//   cleanupTestCase
+//---------------------------------------------------------
+
+void TestSpannerMapBenchmark::cleanupTestCase()
+{
+    qDeleteAll(spanners);
+    spanners.clear();
+}
+
+//---------------------------------------------------------
+//   randomTicks
+//    up to four measures long
+//---------------------------------------------------------
+
+void TestSpannerMapBenchmark::randomTicks(Spanner* s)
+{
+    s->setTick(Fraction::fromTicks(random.bounded(TICKS)));
+    s->setTicks(Fraction::fromTicks(random.bounded(480 * 16)));
+}
+
+//---------------------------------------------------------
+//   compare
+//    the results of the map for start - stop against a
+//    linear search of the spanners sl in the map
+//---------------------------------------------------------
+
+void TestSpannerMapBenchmark::compare(SpannerMap& map, const std::vector<Spanner*>& sl, int start, int stop)
+{
+    std::set<Spanner*> overlapping;
+    std::set<Spanner*> contained;
+    for (Spanner* s : sl) {
+        if (s->tick2().ticks() >= start && s->tick().ticks() <= stop) {
+            overlapping.insert(s);
+        }
+        if (s->tick().ticks() >= start && s->tick2().ticks() <= stop) {
+            contained.insert(s);
+        }
+    }
+
+    std::set<Spanner*> result;
+    int lastStart = -1;
+    for (auto i : map.findOverlapping(start, stop)) {
+        QVERIFY(i.start >= lastStart);
+        lastStart = i.start;
+        result.insert(i.value);
+    }
+    QVERIFY(result == overlapping);
+
+    result.clear();
+    for (auto i : map.findContained(start, stop)) {
+        result.insert(i.value);
+    }
+    QVERIFY(result == contained);
+}
+
+//---------------------------------------------------------
+//   randomChanges
+//    add, remove and move spanners at random and check
+//    the queries after each step
+//---------------------------------------------------------
+
+void TestSpannerMapBenchmark::randomChanges()
+{
+    SpannerMap map;
+    std::vector<Spanner*> in;
+    std::vector<Spanner*> out(spanners.begin(), spanners.begin() + 2000);
+
+    for (int i = 0; i < 10000; ++i) {
+        int op = random.bounded(4);
+        if ((op < 2 && !out.empty()) || in.empty()) {
+            Spanner* s = out.back();
+            out.pop_back();
+            map.addSpanner(s);
+            in.push_back(s);
+        } else if (op == 2) {
+            int idx = random.bounded(int(in.size()));
+            Spanner* s = in[idx];
+            QVERIFY(map.removeSpanner(s));
+            QVERIFY(!s->mapNode());
+            in[idx] = in.back();
+            in.pop_back();
+            out.push_back(s);
+        } else {
+            randomTicks(in[random.bounded(int(in.size()))]);
+        }
+        QCOMPARE(int(map.map().size()), int(in.size()));
+#ifndef NDEBUG
+        QVERIFY(map.check());
+#endif
+        int start = random.bounded(TICKS);
+        compare(map, in, start, start + random.bounded(480 * 8));
+    }
+
+    map.clear();
+    for (Spanner* s : in) {
+        QVERIFY(!s->mapNode());
+    }
+}
+
+//---------------------------------------------------------
+//   addSpanners
+//---------------------------------------------------------
+
+void TestSpannerMapBenchmark::addSpanners()
+{
+    QBENCHMARK {
+        SpannerMap map;
+        for (Spanner* s : spanners) {
+            map.addSpanner(s);
+        }
+        QCOMPARE(int(map.map().size()), SPANNERS);
+        map.clear();
+    }
+}
+
+//---------------------------------------------------------
+//   addAndFind
+//    add the spanners one by one, looking up the measure
+//    of each as layout does
+//---------------------------------------------------------
+
+void TestSpannerMapBenchmark::addAndFind()
+{
+    QBENCHMARK {
+        SpannerMap map;
+        for (Spanner* s : spanners) {
+            map.addSpanner(s);
+            int tick = s->tick().ticks() / 1920 * 1920;
+            QVERIFY(!map.findOverlapping(tick, tick + 1920).empty());
+        }
+        map.clear();
+    }
+}
+
+//---------------------------------------------------------
+//   changeTicks
+//    move every spanner by a measure and back
+//---------------------------------------------------------
+
+void TestSpannerMapBenchmark::changeTicks()
+{
+    SpannerMap map;
+    for (Spanner* s : spanners) {
+        map.addSpanner(s);
+    }
+    const Fraction measure(1, 1);
+    QBENCHMARK {
+        for (Spanner* s : spanners) {
+            s->setTick(s->tick() + measure);
+            map.findOverlapping(s->tick().ticks(), s->tick2().ticks());
+        }
+        for (Spanner* s : spanners) {
+            s->setTick(s->tick() - measure);
+        }
+    }
+#ifndef NDEBUG
+    QVERIFY(map.check());
+#endif
+    map.clear();
+}
+
+//---------------------------------------------------------
+//   removeSpanners
+//    remove the spanners one by one in random order
+//---------------------------------------------------------
+
+void TestSpannerMapBenchmark::removeSpanners()
+{
+    std::vector<Spanner*> sl(spanners);
+    for (int i = int(sl.size()) - 1; i > 0; --i) {
+        std::swap(sl[i], sl[random.bounded(i + 1)]);
+    }
+
+    SpannerMap map;
+    QBENCHMARK {
+        for (Spanner* s : spanners) {
+            map.addSpanner(s);
+        }
+        for (Spanner* s : sl) {
+            map.removeSpanner(s);
+        }
+    }
+    QVERIFY(map.map().empty());
+}
+
+QTEST_MAIN(TestSpannerMapBenchmark)
+#include "tst_spannermapbenchmark.moc"
@@ -52,6 +52,7 @@ private slots:
     void testDropUnicodeAfterSMUFLwhenCursorSetToSymbol();
     void testDropBasicUnicodeWhenNotInEditMode();
     void testDropSupplementaryUnicodeWhenNotInEditMode();
+    void testFontMetricsCache();
 };
 
 //---------------------------------------------------------
@@ -820,6 +821,38 @@ void TestText::testDropSupplementaryUnicodeWhenNotInEditMode()
     QCOMPARE(text->xmlText(), QString("𝄎"));
 }
 
+//---------------------------------------------------------
+///   testFontMetricsCache
+///     cached metrics measure like QFontMetricsF and are dropped on style changes
+//---------------------------------------------------------
+
+void TestText::testFontMetricsCache()
+{
+    FontMetricsCache& cache = score->fontMetricsCache();
+    QFont font("FreeSerif");
+    font.setPointSizeF(11.0);
+    QFontMetricsF fm(font, MScore::paintDevice());
+
+    QCOMPARE(cache.width(font, "Kyrie"), fm.width("Kyrie"));
+    QCOMPARE(cache.width(font, "Kyrie"), fm.width("Kyrie"));
+    QCOMPARE(cache.tightBoundingRect(font, "e-"), fm.tightBoundingRect("e-"));
+    QCOMPARE(cache.metrics(font).ascent(), fm.ascent());
+    QCOMPARE(cache.defaultMetrics(font).ascent(), QFontMetricsF(font).ascent());
+
+    Text* text = new Text(score);
+    text->initSubStyle(SubStyle::DYNAMICS);
+    text->setPlainText("ff a2 ff");
+    text->layout();
+    QRectF bbox = text->bbox();
+    QVERIFY(cache.size() > 0);
+
+    score->styleChanged();
+    QCOMPARE(cache.size(), 0);
+    text->layout();
+    QCOMPARE(text->bbox(), bbox);
+    delete text;
+}
+
 QTEST_MAIN(TestText)
 
 #include "tst_text.moc"
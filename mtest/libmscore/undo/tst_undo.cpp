@@ -0,0 +1,260 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+#include "mtest/testutils.h"
+#include "libmscore/score.h"
+#include "libmscore/undo.h"
+#include "libmscore/measure.h"
+#include "libmscore/segment.h"
+#include "libmscore/chord.h"
+#include "libmscore/note.h"
+#include "libmscore/stafftext.h"
+
+#define DIR QString("libmscore/undo/")
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestUndo
+//---------------------------------------------------------
+
+class TestUndo : public QObject, public MTest
+{
+    Q_OBJECT
+
+    Note* firstNote(MasterScore*);
+    void changeVelocity(MasterScore*, Note*, int);
+
+private slots:
+    void initTestCase();
+    void trimDepth();
+    void trimMemory();
+    void trimCleanState();
+    void coalesceProperty();
+    void noTrimWhileEditingText();
+};
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestUndo::initTestCase()
+{
+    initMTest();
+}
+
+//---------------------------------------------------------
+//   firstNote
+//---------------------------------------------------------
+
+Note* TestUndo::firstNote(MasterScore* score)
+{
+    Segment* seg = score->firstSegment(SegmentType::ChordRest);
+    return toChord(seg->cr(0))->upNote();
+}
+
+//---------------------------------------------------------
+//   changeVelocity
+//    one undo step changing the velocity offset of note
+//---------------------------------------------------------
+
+void TestUndo::changeVelocity(MasterScore* score, Note* note, int velo)
+{
+    score->startCmd();
+    score->undo(new ChangeProperty(note, Pid::VELO_OFFSET, velo));
+    score->endCmd();
+}
+
+//---------------------------------------------------------
+//   trimDepth
+//    only the newest undo steps are kept; undoing all of
+//    them restores the state after the oldest one kept
+//---------------------------------------------------------
+
+void TestUndo::trimDepth()
+{
+    MasterScore* score = readScore(DIR + "undo.mscx");
+    QVERIFY(score);
+    UndoStack* stack = score->undoStack();
+    stack->setDepthLimit(3);
+    Note* note = firstNote(score);
+
+    for (int velo = 1; velo <= 5; ++velo) {
+        changeVelocity(score, note, velo);
+    }
+    QCOMPARE(stack->getCurIdx(), 3);
+    QCOMPARE(note->veloOffset(), 5);
+
+    while (stack->canUndo()) {
+        stack->undo(0);
+    }
+    QCOMPARE(note->veloOffset(), 2);
+
+    while (stack->canRedo()) {
+        stack->redo(0);
+    }
+    QCOMPARE(note->veloOffset(), 5);
+    delete score;
+}
+
+//---------------------------------------------------------
+//   trimMemory
+//    the newest undo step is kept even if it does not fit
+//    into the memory limit
+//---------------------------------------------------------
+
+void TestUndo::trimMemory()
+{
+    MasterScore* score = readScore(DIR + "undo.mscx");
+    QVERIFY(score);
+    UndoStack* stack = score->undoStack();
+    Note* note = firstNote(score);
+
+    for (int velo = 1; velo <= 3; ++velo) {
+        changeVelocity(score, note, velo);
+    }
+    QCOMPARE(stack->getCurIdx(), 3);
+    const size_t size = stack->byteSize();
+    QVERIFY(size > 0);
+
+    stack->setMemoryLimit(1);
+    QCOMPARE(stack->getCurIdx(), 1);
+    QVERIFY(stack->byteSize() < size);
+
+    changeVelocity(score, note, 4);
+    QCOMPARE(stack->getCurIdx(), 1);
+
+    stack->undo(0);
+    QVERIFY(!stack->canUndo());
+    QCOMPARE(note->veloOffset(), 3);
+    delete score;
+}
+
+//---------------------------------------------------------
+//   trimCleanState
+//    a clean state which is trimmed away can not be
+//    reached by undo anymore
+//---------------------------------------------------------
+
+void TestUndo::trimCleanState()
+{
+    MasterScore* score = readScore(DIR + "undo.mscx");
+    QVERIFY(score);
+    UndoStack* stack = score->undoStack();
+    stack->setDepthLimit(2);
+    Note* note = firstNote(score);
+
+    // clean state still on the stack
+    changeVelocity(score, note, 1);
+    stack->setClean();
+    changeVelocity(score, note, 2);
+    changeVelocity(score, note, 3);
+    QVERIFY(!stack->isClean());
+    stack->undo(0);
+    stack->undo(0);
+    QVERIFY(!stack->canUndo());
+    QVERIFY(stack->isClean());
+    QCOMPARE(note->veloOffset(), 1);
+
+    // clean state trimmed away
+    changeVelocity(score, note, 4);
+    changeVelocity(score, note, 5);
+    changeVelocity(score, note, 6);
+    QCOMPARE(stack->getCurIdx(), 2);
+    stack->undo(0);
+    stack->undo(0);
+    QVERIFY(!stack->canUndo());
+    QVERIFY(!stack->isClean());
+    QCOMPARE(note->veloOffset(), 4);
+    delete score;
+}
+
+//---------------------------------------------------------
+//   coalesceProperty
+//    consecutive changes of one property within an undo
+//    step are undone to the value before the first one
+//---------------------------------------------------------
+
+void TestUndo::coalesceProperty()
+{
+    MasterScore* score = readScore(DIR + "undo.mscx");
+    QVERIFY(score);
+    UndoStack* stack = score->undoStack();
+    Note* note = firstNote(score);
+    const int oldVelo = note->veloOffset();
+
+    score->startCmd();
+    score->undo(new ChangeProperty(note, Pid::VELO_OFFSET, 10));
+    score->undo(new ChangeProperty(note, Pid::VELO_OFFSET, 20));
+    score->undo(new ChangeProperty(note, Pid::PLAY, false));
+    score->undo(new ChangeProperty(note, Pid::VELO_OFFSET, 30));
+    score->undo(new ChangeProperty(note, Pid::VELO_OFFSET, 40));
+    score->endCmd();
+    QCOMPARE(note->veloOffset(), 40);
+
+    int veloChanges = 0;
+    for (UndoCommand* cmd : stack->last()->commands()) {
+        if (!strcmp(cmd->name(), "ChangeProperty") && static_cast<ChangeProperty*>(cmd)->getId() == Pid::VELO_OFFSET) {
+            ++veloChanges;
+        }
+    }
+    QCOMPARE(veloChanges, 2);     // the change of PLAY separates the runs
+
+    stack->undo(0);
+    QCOMPARE(note->veloOffset(), oldVelo);
+    QVERIFY(note->play());
+    stack->redo(0);
+    QCOMPARE(note->veloOffset(), 40);
+    QVERIFY(!note->play());
+    delete score;
+}
+
+//---------------------------------------------------------
+//   noTrimWhileEditingText
+//    text editing refers to undo steps by index, the stack
+//    is trimmed only after the edit has ended
+//---------------------------------------------------------
+
+void TestUndo::noTrimWhileEditingText()
+{
+    MasterScore* score = readScore(DIR + "undo.mscx");
+    QVERIFY(score);
+    UndoStack* stack = score->undoStack();
+    stack->setDepthLimit(1);
+    Note* note = firstNote(score);
+
+    score->startCmd();
+    Segment* seg = score->firstSegment(SegmentType::ChordRest);
+    StaffText* text = new StaffText(score);
+    text->setXmlText("text");
+    text->setTrack(0);
+    text->setParent(seg);
+    score->undoAddElement(text);
+    score->endCmd();
+    QCOMPARE(stack->getCurIdx(), 1);
+
+    EditData ted;
+    text->startEdit(ted);
+    for (int velo = 1; velo <= 3; ++velo) {
+        changeVelocity(score, note, velo);
+    }
+    QCOMPARE(stack->getCurIdx(), 4);
+
+    text->endEdit(ted);
+    QCOMPARE(stack->getCurIdx(), 1);
+    QCOMPARE(note->veloOffset(), 3);
+    delete score;
+}
+
+QTEST_MAIN(TestUndo)
+#include "tst_undo.moc"
@@ -52,6 +52,7 @@ class TestMxmlIO : public QObject, public MTest
     void mxmlMscxExportTestRefBreaks(const char* file);
     void mxmlReadTestCompr(const char* file);
     void mxmlReadWriteTestCompr(const char* file);
+    void mxmlWriteTestCompr(const char* file);
 
     // The list of MusicXML regression tests
     // Currently failing tests are commented out and annotated with the failure reason
@@ -173,6 +174,7 @@ private slots:
     void restsTypeWhole() { mxmlIoTestRef("testRestsTypeWhole"); }
     void slurTieLineStyle() { mxmlIoTest("testSlurTieLineStyle"); }
     void slurs() { mxmlIoTest("testSlurs"); }
+    void slursWriteCompr() { mxmlWriteTestCompr("testSlurs"); }
     void slurs2() { mxmlIoTest("testSlurs2"); }
     void sound1() { mxmlIoTestRef("testSound1"); }
     void sound2() { mxmlIoTestRef("testSound2"); }
@@ -218,6 +220,7 @@ private slots:
     void voicePiano1() { mxmlIoTest("testVoicePiano1"); }
     void volta1() { mxmlIoTest("testVolta1"); }
     void wedge1() { mxmlIoTest("testWedge1"); }
+    void wedge1WriteCompr() { mxmlWriteTestCompr("testWedge1"); }
     void wedge2() { mxmlIoTest("testWedge2"); }
     void wedge3() { mxmlIoTest("testWedge3"); }
     void words1() { mxmlIoTest("testWords1"); }
@@ -439,5 +442,28 @@ void TestMxmlIO::mxmlReadWriteTestCompr(const char* file)
     delete score;
 }
 
+//---------------------------------------------------------
+//   mxmlWriteTestCompr
+//   read a MusicXML file, write to a compressed MusicXML file
+//   and verify its root file is identical to the uncompressed export
+//---------------------------------------------------------
+
+void TestMxmlIO::mxmlWriteTestCompr(const char* file)
+{
+    MScore::debugMode = true;
+
+    setValue(PREF_EXPORT_MUSICXML_EXPORTBREAKS, Val(static_cast<int>(IImportexportConfiguration::MusicxmlExportBreaksType::Manual)));
+    setValue(PREF_IMPORT_MUSICXML_IMPORTBREAKS, Val(true));
+
+    MasterScore* score = readScore(DIR + file + ".xml");
+    QVERIFY(score);
+    fixupScore(score);
+    score->doLayout();
+    QVERIFY(saveMxl(score, QString(file) + "_mxl_write.mxl"));
+    delete score;
+    extractRootFile(QString(file) + "_mxl_write.mxl", QString(file) + "_mxl_write.xml");
+    QVERIFY(compareFiles(QString(file) + "_mxl_write.xml", DIR + file + ".xml"));
+}
+
 QTEST_MAIN(TestMxmlIO)
 #include "tst_mxml_io.moc"
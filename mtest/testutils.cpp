@@ -16,6 +16,7 @@
 #include "libmscore/score.h"
 #include "libmscore/note.h"
 #include "libmscore/chord.h"
+#include "libmscore/measure.h"
 #include "libmscore/instrtemplate.h"
 #include "omr/omr.h"
 #include "testutils.h"
@@ -95,6 +96,31 @@ MasterScore* MTest::readScore(const QString& name)
     return readCreatedScore(path);
 }
 
+//---------------------------------------------------------
+//   readRepeatedScore
+//    read name and append its measures to it again until
+//    the score has at least the given number of measures
+//---------------------------------------------------------
+
+MasterScore* MTest::readRepeatedScore(const QString& name, int measures)
+{
+    MasterScore* score = readScore(name);
+    MasterScore* pattern = readScore(name);
+    if (!score || !pattern) {
+        delete score;
+        delete pattern;
+        return 0;
+    }
+    score->startCmd();
+    while (score->nmeasures() < measures) {
+        score->appendMeasuresFromScore(pattern, Fraction(0, 1), pattern->last()->endTick());
+    }
+    score->setLayoutAll();
+    score->endCmd();
+    delete pattern;
+    return score;
+}
+
 //---------------------------------------------------------
 //   readCreatedScore
 //---------------------------------------------------------
@@ -35,6 +35,7 @@ protected:
     MTest();
     Ms::MasterScore* readScore(const QString& name);
     Ms::MasterScore* readCreatedScore(const QString& name);
+    Ms::MasterScore* readRepeatedScore(const QString& name, int measures);
     bool saveScore(Ms::Score*, const QString& name) const;
     bool savePdf(Ms::MasterScore*, const QString& name);
     bool saveMusicXml(Ms::MasterScore*, const QString& name);
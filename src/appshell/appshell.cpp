@@ -20,7 +20,9 @@
 #include "appshell.h"
 
 #include <QApplication>
+#include <QCommandLineParser>
 #include <QQmlApplicationEngine>
+#include <cstring>
 #include <iostream>
 
 #include "log.h"
@@ -51,14 +53,33 @@ int AppShell::run(int argc, char** argv, std::function<void()> moduleSetup)
     qputenv("QML_DISABLE_DISK_CACHE", "true");
 #endif
 
+    //! NOTE The batch converter has no windows
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--batch-converter") == 0) {
+            qputenv("QT_QPA_PLATFORM", "offscreen");
+        }
+    }
+
     QApplication app(argc, argv);
     QCoreApplication::setApplicationName(appName);
     QCoreApplication::setOrganizationName("MuseScore");
     QCoreApplication::setOrganizationDomain("musescore.org");
     QCoreApplication::setApplicationVersion(QString::fromStdString(framework::Version::fullVersion()));
 
+    QCommandLineParser parser;
+    parser.addOptions({
+        { "batch-converter", "Convert scores given as JSON lines on stdin or on a local socket" },
+        { "socket", "Local socket name the batch converter listens on", "name" },
+        { "workers", "Number of scores the batch converter converts at once", "count" }
+    });
+    parser.parse(app.arguments());
+
     moduleSetup();
 
+    if (parser.isSet("batch-converter")) {
+        return converter()->runBatchConverter(parser.value("socket").toStdString(), parser.value("workers").toInt());
+    }
+
     QQmlApplicationEngine* engine = new QQmlApplicationEngine();
     //! NOTE Move ownership to UiEngine
     framework::UiEngine::instance()->moveQQmlEngine(engine);
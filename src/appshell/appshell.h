@@ -22,10 +22,15 @@
 
 #include <functional>
 
+#include "modularity/ioc.h"
+#include "converter/iconvertercontroller.h"
+
 namespace mu {
 namespace appshell {
 class AppShell
 {
+    INJECT(appshell, converter::IConverterController, converter)
+
 public:
     AppShell();
 
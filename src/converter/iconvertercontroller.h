@@ -0,0 +1,44 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_CONVERTER_ICONVERTERCONTROLLER_H
+#define MU_CONVERTER_ICONVERTERCONTROLLER_H
+
+#include <string>
+
+#include "modularity/imoduleexport.h"
+
+namespace mu {
+namespace converter {
+class IConverterController : MODULE_EXPORT_INTERFACE
+{
+    INTERFACE_ID(IConverterController)
+
+public:
+    virtual ~IConverterController() = default;
+
+    //! NOTE Runs a headless converter until its input ends.
+    //! Jobs are read as JSON lines from stdin, or from the clients
+    //! of a local socket if socketName is not empty; the results
+    //! are written back the same way. Returns the exit code.
+    virtual int runBatchConverter(const std::string& socketName, int workers = 0) = 0;
+};
+}
+}
+
+#endif // MU_CONVERTER_ICONVERTERCONTROLLER_H
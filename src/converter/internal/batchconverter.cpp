@@ -0,0 +1,193 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "batchconverter.h"
+
+#include <algorithm>
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "log.h"
+
+using namespace mu::converter;
+using namespace mu::notation;
+
+static double elapsedMs(const QElapsedTimer& timer)
+{
+    return timer.nsecsElapsed() / 1000000.0;
+}
+
+static QByteArray toLine(const QJsonObject& obj)
+{
+    return QJsonDocument(obj).toJson(QJsonDocument::Compact);
+}
+
+static bool isNativeFormat(const mu::io::path& path)
+{
+    std::string suffix = mu::io::syffix(path);
+    return suffix == "mscz" || suffix == "mscx";
+}
+
+BatchConverter::BatchConverter(int workers)
+    : m_workers(workers > 0 ? workers : std::max(1, int(std::thread::hardware_concurrency())))
+{
+}
+
+BatchConverter::~BatchConverter()
+{
+    finish();
+}
+
+void BatchConverter::start()
+{
+    for (int i = 0; i < m_workers; ++i) {
+        m_threads.emplace_back([this, i]() { work(i); });
+    }
+}
+
+bool BatchConverter::post(const QByteArray& line, const Reply& reply)
+{
+    QJsonParseError err;
+    QJsonObject obj = QJsonDocument::fromJson(line, &err).object();
+    if (err.error != QJsonParseError::NoError) {
+        reply(toLine({ { "ok", false }, { "error", err.errorString() } }));
+        return true;
+    }
+    if (obj.value("quit").toBool()) {
+        return false;
+    }
+
+    Job job;
+    job.id = obj.value("id").toVariant().toString();
+    job.in = obj.value("in").toString();
+
+    QJsonValue out = obj.value("out");
+    if (out.isArray()) {
+        for (const QJsonValue& val : out.toArray()) {
+            job.out.push_back(val.toString());
+        }
+    } else if (out.isString()) {
+        job.out.push_back(out.toString());
+    }
+
+    if (job.in.empty() || job.out.empty()) {
+        reply(toLine({ { "id", job.id }, { "ok", false }, { "error", "job needs \"in\" and \"out\"" } }));
+        return true;
+    }
+
+    job.reply = reply;
+    job.queued.start();
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_queue.push_back(std::move(job));
+    }
+    m_queueChanged.notify_one();
+    return true;
+}
+
+//! NOTE Waits until all posted jobs are done
+void BatchConverter::finish()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_finished = true;
+    }
+    m_queueChanged.notify_all();
+    for (std::thread& t : m_threads) {
+        t.join();
+    }
+    m_threads.clear();
+}
+
+void BatchConverter::work(int worker)
+{
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            m_queueChanged.wait(lock, [this]() { return m_finished || !m_queue.empty(); });
+            if (m_queue.empty()) {
+                return;
+            }
+            job = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+        job.reply(convert(job, worker));
+    }
+}
+
+//! NOTE Native scores are read and laid out by several workers at
+//! once, under a shared lock: the state they share (the image store,
+//! the score fonts, MScore::lastError) is guarded or per thread.
+//! Everything that changes process wide state takes the lock alone:
+//! the writers change MScore::pixelRatio, which layout reads, and
+//! iterate the image store, which destroying a score clears; the
+//! importers of other formats keep global state of their own.
+QByteArray BatchConverter::convert(const Job& job, int worker)
+{
+    QJsonObject result;
+    result["id"] = job.id;
+    result["worker"] = worker;
+    result["queueMs"] = elapsedMs(job.queued);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    IMasterNotationPtr notation = notationCreator()->newMasterNotation();
+
+    QElapsedTimer loadTimer;
+    loadTimer.start();
+    Ret ret;
+    if (isNativeFormat(job.in)) {
+        std::shared_lock<std::shared_mutex> lock(m_scoreMutex);
+        ret = notation->load(job.in);
+    } else {
+        std::unique_lock<std::shared_mutex> lock(m_scoreMutex);
+        ret = notation->load(job.in);
+    }
+    result["loadMs"] = elapsedMs(loadTimer);
+
+    if (ret) {
+        QElapsedTimer writeTimer;
+        writeTimer.start();
+        std::unique_lock<std::shared_mutex> lock(m_scoreMutex);
+        result["lockMs"] = elapsedMs(writeTimer);
+        for (const io::path& out : job.out) {
+            ret = notation->save(out);
+            if (!ret) {
+                LOGE() << "failed to write " << out;
+                break;
+            }
+        }
+        result["writeMs"] = elapsedMs(writeTimer);
+    }
+
+    {
+        std::unique_lock<std::shared_mutex> lock(m_scoreMutex);
+        notation.reset();
+    }
+
+    result["totalMs"] = elapsedMs(timer);
+    result["ok"] = bool(ret);
+    if (!ret) {
+        result["error"] = QString::fromStdString(ret.toString());
+    }
+    return toLine(result);
+}
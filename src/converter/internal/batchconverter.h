@@ -0,0 +1,85 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_CONVERTER_BATCHCONVERTER_H
+#define MU_CONVERTER_BATCHCONVERTER_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QString>
+
+#include "modularity/ioc.h"
+#include "io/path.h"
+#include "notation/inotationcreator.h"
+
+namespace mu {
+namespace converter {
+//! NOTE Converts the jobs posted to it on a pool of worker
+//! threads, reading several scores at once (see convert()). A job is a JSON object
+//!     {"id": "1", "in": "a.mscz", "out": ["a.pdf", "a.png"]}
+//! where "out" may also be a single path; {"quit": true}
+//! ends the input. Every job is answered by one JSON line
+//! with its result and timing in milliseconds.
+class BatchConverter
+{
+    INJECT(converter, notation::INotationCreator, notationCreator)
+
+public:
+    using Reply = std::function<void (const QByteArray&)>;
+
+    explicit BatchConverter(int workers = 0);
+    ~BatchConverter();
+
+    void start();
+    bool post(const QByteArray& line, const Reply& reply);
+    void finish();
+
+private:
+    struct Job {
+        QString id;
+        io::path in;
+        std::vector<io::path> out;
+        Reply reply;
+        QElapsedTimer queued;
+    };
+
+    void work(int worker);
+    QByteArray convert(const Job& job, int worker);
+
+    int m_workers = 0;
+    std::vector<std::thread> m_threads;
+
+    std::deque<Job> m_queue;
+    std::mutex m_queueMutex;
+    std::condition_variable m_queueChanged;
+    bool m_finished = false;
+
+    std::shared_mutex m_scoreMutex;
+};
+}
+}
+
+#endif // MU_CONVERTER_BATCHCONVERTER_H
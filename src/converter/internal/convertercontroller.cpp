@@ -0,0 +1,127 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "convertercontroller.h"
+
+#include <iostream>
+#include <mutex>
+#include <string>
+
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QPointer>
+
+#include "log.h"
+#include "libmscore/sym.h"
+
+#include "batchconverter.h"
+
+using namespace mu::converter;
+
+int ConverterController::runBatchConverter(const std::string& socketName, int workers)
+{
+    warmUp();
+
+    BatchConverter converter(workers);
+    converter.start();
+
+    if (socketName.empty()) {
+        return readJobs(converter);
+    }
+    return serveJobs(converter, QString::fromStdString(socketName));
+}
+
+//! NOTE Load what every conversion needs once and before the
+//! workers start; the score fonts are loaded lazily otherwise
+//! and would be loaded by several workers at once.
+//! Instrument templates are loaded by the instruments module.
+void ConverterController::warmUp()
+{
+    for (const Ms::ScoreFont& font : Ms::ScoreFont::scoreFonts()) {
+        Ms::ScoreFont::fontFactory(font.name());
+    }
+    Ms::ScoreFont::fallbackFont();
+}
+
+int ConverterController::readJobs(BatchConverter& converter)
+{
+    static std::mutex outMutex;
+    BatchConverter::Reply reply = [](const QByteArray& line) {
+        std::lock_guard<std::mutex> lock(outMutex);
+        std::cout << line.constData() << std::endl;
+    };
+
+    std::string line;
+    while (std::getline(std::cin, line)) {
+        if (line.empty()) {
+            continue;
+        }
+        if (!converter.post(QByteArray::fromStdString(line), reply)) {
+            break;
+        }
+    }
+    converter.finish();
+    return 0;
+}
+
+int ConverterController::serveJobs(BatchConverter& converter, const QString& socketName)
+{
+    QLocalServer server;
+    QLocalServer::removeServer(socketName);
+    if (!server.listen(socketName)) {
+        LOGE() << "failed to listen on " << socketName << ": " << server.errorString();
+        return 1;
+    }
+
+    QEventLoop loop;
+    QObject::connect(&server, &QLocalServer::newConnection, [&]() {
+        while (QLocalSocket* socket = server.nextPendingConnection()) {
+            QPointer<QLocalSocket> client(socket);
+            BatchConverter::Reply reply = [&server, client](const QByteArray& line) {
+                // called by the workers; the socket is written on its own thread
+                QMetaObject::invokeMethod(&server, [client, line]() {
+                    if (client) {
+                        client->write(line + '\n');
+                    }
+                }, Qt::QueuedConnection);
+            };
+
+            QObject::connect(socket, &QLocalSocket::readyRead, socket, [&converter, &loop, socket, reply]() {
+                while (socket->canReadLine()) {
+                    QByteArray line = socket->readLine().trimmed();
+                    if (!line.isEmpty() && !converter.post(line, reply)) {
+                        loop.quit();
+                    }
+                }
+            });
+            QObject::connect(socket, &QLocalSocket::disconnected, socket, &QObject::deleteLater);
+        }
+    });
+
+    loop.exec();
+
+    //! NOTE Deliver the replies of the last jobs before the server goes away
+    converter.finish();
+    QCoreApplication::processEvents();
+    for (QLocalSocket* socket : server.findChildren<QLocalSocket*>()) {
+        socket->waitForBytesWritten();
+    }
+    return 0;
+}
@@ -0,0 +1,42 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_CONVERTER_CONVERTERCONTROLLER_H
+#define MU_CONVERTER_CONVERTERCONTROLLER_H
+
+#include <QString>
+
+#include "../iconvertercontroller.h"
+
+namespace mu {
+namespace converter {
+class BatchConverter;
+class ConverterController : public IConverterController
+{
+public:
+    int runBatchConverter(const std::string& socketName, int workers = 0) override;
+
+private:
+    void warmUp();
+    int readJobs(BatchConverter& converter);
+    int serveJobs(BatchConverter& converter, const QString& socketName);
+};
+}
+}
+
+#endif // MU_CONVERTER_CONVERTERCONTROLLER_H
@@ -0,0 +1,172 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "converter/internal/batchconverter.h"
+
+#include "notation/tests/mocks/masternotationmock.h"
+#include "notation/tests/mocks/notationcreatormock.h"
+
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::NiceMock;
+
+using namespace mu;
+using namespace mu::converter;
+using namespace mu::notation;
+
+class BatchConverterTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_creator = std::make_shared<NotationCreatorMock>();
+
+        //! NOTE Every job gets its own notation; loads and saves
+        //! record what runs at the same time
+        ON_CALL(*m_creator, newMasterNotation())
+        .WillByDefault(Invoke([this]() -> IMasterNotationPtr {
+            auto notation = std::make_shared<NiceMock<MasterNotationMock> >();
+            ON_CALL(*notation, load(_)).WillByDefault(Invoke([this](const io::path& path) {
+                return io::syffix(path) == "mscz" ? sharedLoad() : alone();
+            }));
+            ON_CALL(*notation, save(_)).WillByDefault(Invoke([this](const io::path&) { return alone(); }));
+            return notation;
+        }));
+    }
+
+    //! NOTE Waits a while for another load to run at the same time
+    Ret sharedLoad()
+    {
+        int loading = ++m_loading;
+        if (m_alone > 0) {
+            m_overlapped = true;
+        }
+        auto timeout = std::chrono::steady_clock::now() + std::chrono::milliseconds(200);
+        while (m_loading < 2 && std::chrono::steady_clock::now() < timeout) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        loading = std::max(loading, m_loading.load());
+        int max = m_maxLoading;
+        while (loading > max && !m_maxLoading.compare_exchange_weak(max, loading)) {
+        }
+        --m_loading;
+        return make_ret(Ret::Code::Ok);
+    }
+
+    Ret alone()
+    {
+        if (++m_alone > 1 || m_loading > 0) {
+            m_overlapped = true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        --m_alone;
+        return make_ret(Ret::Code::Ok);
+    }
+
+    std::vector<QJsonObject> convert(BatchConverter& converter, const std::vector<QByteArray>& jobs)
+    {
+        std::mutex mutex;
+        std::vector<QJsonObject> replies;
+        BatchConverter::Reply reply = [&](const QByteArray& line) {
+            std::lock_guard<std::mutex> lock(mutex);
+            replies.push_back(QJsonDocument::fromJson(line).object());
+        };
+
+        converter.setnotationCreator(m_creator);
+        converter.start();
+        for (const QByteArray& job : jobs) {
+            EXPECT_TRUE(converter.post(job, reply));
+        }
+        converter.finish();
+        return replies;
+    }
+
+    std::shared_ptr<NotationCreatorMock> m_creator;
+    std::atomic<int> m_loading { 0 };
+    std::atomic<int> m_maxLoading { 0 };
+    std::atomic<int> m_alone { 0 };
+    std::atomic<bool> m_overlapped { false };
+};
+
+TEST_F(BatchConverterTest, ConcurrentJobs)
+{
+    //! GIVEN Jobs for native and imported files, with one or more outputs
+    const int jobCount = 24;
+    std::vector<QByteArray> jobs;
+    for (int i = 0; i < jobCount; ++i) {
+        QString in = QString(i % 3 ? "score%1.mscz" : "score%1.mid").arg(i);
+        QString out = i % 2 ? QString("[\"score%1.pdf\", \"score%1.png\"]").arg(i) : QString("\"score%1.mscx\"").arg(i);
+        jobs.push_back(QString("{\"id\": \"%1\", \"in\": \"%2\", \"out\": %3}").arg(i).arg(in, out).toUtf8());
+    }
+
+    EXPECT_CALL(*m_creator, newMasterNotation()).Times(jobCount);
+
+    //! WHEN They are converted by several workers
+    BatchConverter converter(4);
+    std::vector<QJsonObject> replies = convert(converter, jobs);
+
+    //! THEN Every job is answered once and succeeded
+    EXPECT_EQ(replies.size(), size_t(jobCount));
+    std::set<QString> ids;
+    for (const QJsonObject& reply : replies) {
+        EXPECT_TRUE(reply.value("ok").toBool());
+        ids.insert(reply.value("id").toString());
+    }
+    EXPECT_EQ(ids.size(), size_t(jobCount));
+
+    //! THEN Native scores were loaded at the same time
+    EXPECT_GE(m_maxLoading.load(), 2);
+
+    //! THEN Imports and writes ran alone
+    EXPECT_FALSE(m_overlapped.load());
+}
+
+TEST_F(BatchConverterTest, BadJobs)
+{
+    //! GIVEN A job that is not JSON and a job without output
+    std::vector<QByteArray> jobs {
+        "{\"id\": \"1\", \"in\": ",
+        "{\"id\": \"2\", \"in\": \"score.mscz\"}"
+    };
+
+    EXPECT_CALL(*m_creator, newMasterNotation()).Times(0);
+
+    //! WHEN They are posted
+    BatchConverter converter(2);
+    std::vector<QJsonObject> replies = convert(converter, jobs);
+
+    //! THEN Both are answered with an error and nothing is loaded
+    EXPECT_EQ(replies.size(), size_t(2));
+    for (const QJsonObject& reply : replies) {
+        EXPECT_FALSE(reply.value("ok").toBool());
+        EXPECT_FALSE(reply.value("error").toString().isEmpty());
+    }
+}
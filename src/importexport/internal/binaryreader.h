@@ -0,0 +1,148 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#ifndef MU_IMPORTEXPORT_BINARYREADER_H
+#define MU_IMPORTEXPORT_BINARYREADER_H
+
+#include <cstring>
+
+#include <QByteArray>
+#include <QIODevice>
+#include <QtEndian>
+
+namespace Ms {
+//---------------------------------------------------------
+//   BinaryReader
+//    cursor over a binary file held in memory, used by
+//    the importers of byte oriented formats instead of
+//    reading the QIODevice value by value.
+//
+//    All reads are bounds checked: reading past the end
+//    of the data returns zeros (or the part of a string
+//    which is there), leaves the cursor at the end and
+//    sets error(), so that a parser can run on and check
+//    error() at convenient points.
+//---------------------------------------------------------
+
+class BinaryReader
+{
+    QByteArray _data;                   ///< keeps the buffer alive, may be empty for raw data
+    const uchar* _begin { nullptr };
+    const uchar* _pos   { nullptr };
+    const uchar* _end   { nullptr };
+    bool _error         { false };
+
+    bool available(qint64 len)
+    {
+        if (len >= 0 && len <= _end - _pos) {
+            return true;
+        }
+        _pos   = _end;
+        _error = true;
+        return false;
+    }
+
+    void setRawData(const char* data, qint64 size)
+    {
+        _begin = reinterpret_cast<const uchar*>(data);
+        _pos   = _begin;
+        _end   = _begin + size;
+        _error = false;
+    }
+
+public:
+    BinaryReader() = default;
+
+    //! the reader shares data, no copy is made
+    explicit BinaryReader(const QByteArray& data)
+        : _data(data) { setRawData(_data.constData(), _data.size()); }
+
+    //! data is not copied and must outlive the reader
+    BinaryReader(const char* data, qint64 size) { setRawData(data, size); }
+
+    //! read the rest of the device in one go
+    static BinaryReader fromDevice(QIODevice* device) { return BinaryReader(device->readAll()); }
+
+    qint64 pos() const { return _pos - _begin; }
+    qint64 size() const { return _end - _begin; }
+    bool atEnd() const { return _pos == _end; }
+    bool error() const { return _error; }
+
+    void skip(qint64 len)
+    {
+        if (available(len)) {
+            _pos += len;
+        }
+    }
+
+    bool read(void* p, qint64 len)
+    {
+        if (!available(len)) {
+            memset(p, 0, len > 0 ? size_t(len) : 0);
+            return false;
+        }
+        memcpy(p, _pos, size_t(len));
+        _pos += len;
+        return true;
+    }
+
+    int readUInt8() { return available(1) ? *_pos++ : 0; }
+    int readInt8() { return available(1) ? static_cast<signed char>(*_pos++) : 0; }
+
+    int readInt16()
+    {
+        if (!available(2)) {
+            return 0;
+        }
+        qint16 v = qFromLittleEndian<qint16>(_pos);
+        _pos += 2;
+        return v;
+    }
+
+    int readInt32()
+    {
+        if (!available(4)) {
+            return 0;
+        }
+        qint32 v = qFromLittleEndian<qint32>(_pos);
+        _pos += 4;
+        return v;
+    }
+
+    //---------------------------------------------------
+    //   readString
+    //    return the len following bytes up to the first
+    //    NUL, without copying them; the result is only
+    //    valid as long as the reader data is
+    //---------------------------------------------------
+
+    QByteArray readString(qint64 len)
+    {
+        if (len <= 0) {
+            return QByteArray();
+        }
+        const char* s = reinterpret_cast<const char*>(_pos);
+        qint64 n = qMin(len, qint64(_end - _pos));
+        skip(len);
+        return QByteArray::fromRawData(s, int(qstrnlen(s, uint(n))));
+    }
+};
+}     // namespace Ms
+
+#endif // MU_IMPORTEXPORT_BINARYREADER_H
@@ -621,8 +621,7 @@ int GuitarPro4::convertGP4SlideNum(int sl)
 
 bool GuitarPro4::read(QFile* fp)
 {
-    f      = fp;
-    curPos = 30;
+    _reader = BinaryReader::fromDevice(fp);
 
     readInfo();
     readUChar();        // triplet feeling
@@ -694,6 +693,10 @@ bool GuitarPro4::read(QFile* fp)
         bars.append(bar);
     }
 
+    if (_reader.error()) {
+        return false;
+    }
+
     //
     // create a part for every staff
     //
@@ -737,6 +740,9 @@ bool GuitarPro4::read(QFile* fp)
         int capo         = readInt();
         /*int color        =*/ readInt();
 
+        if (_reader.error()) {
+            return false;
+        }
         std::vector<int> tuning2(strings);
         //int tuning2[strings];
         for (int k = 0; k < strings; ++k) {
@@ -809,7 +815,7 @@ bool GuitarPro4::read(QFile* fp)
     bool mixChange = false;
     bool lastSlurAdd = false;
     for (int bar = 0; bar < measures; ++bar, measure = measure->nextMeasure()) {
-        if (!f->isReadable()) {
+        if (_reader.error()) {
             break;
         }
         const GpBar& gpbar = bars[bar];
@@ -832,7 +838,7 @@ bool GuitarPro4::read(QFile* fp)
             int beats = readInt();
             int track = staffIdx * VOICES;
 
-            if (!f->isReadable()) {
+            if (_reader.error()) {
                 break;
             }
             for (int beat = 0; beat < beats; ++beat) {
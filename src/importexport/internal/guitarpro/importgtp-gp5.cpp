@@ -198,7 +198,7 @@ Fraction GuitarPro5::readBeat(const Fraction& tick, int voice, Measure* measure,
             /*auto len =*/
             readUChar();
             char c[21];
-            f->read(c, 21);
+            read(c, 21);
             // if (len > 20)
             //      skip(len - 20);
             //skip(len - 20);
@@ -561,6 +561,9 @@ bool GuitarPro5::readTracks()
             readDelphiString();
             readDelphiString();
         }
+        if (_reader.error()) {
+            return false;
+        }
         std::vector<int> tuning2(strings);
         //int tuning2[strings];
         for (int k = 0; k < strings; ++k) {
@@ -633,6 +636,9 @@ void GuitarPro5::readMeasures(int /*startingTempo*/)
     Measure* measure = score->firstMeasure();
     bool mixChange = false;
     for (int bar = 0; bar < measures; ++bar, measure = measure->nextMeasure()) {
+        if (_reader.error()) {
+            break;
+        }
         const GpBar& gpbar = bars[bar];
 
         if (!gpbar.marker.isEmpty()) {
@@ -793,7 +799,7 @@ void GuitarPro5::readMeasures(int /*startingTempo*/)
 
 bool GuitarPro5::read(QFile* fp)
 {
-    f = fp;
+    _reader = BinaryReader::fromDevice(fp);
 
     readInfo();
     readLyrics();
@@ -905,6 +911,10 @@ bool GuitarPro5::read(QFile* fp)
         bars.append(bar);
     }
 
+    if (_reader.error()) {
+        return false;
+    }
+
     //
     // create a part for every staff
     //
@@ -14,6 +14,7 @@
 #include "importgtp.h"
 
 #include <QDebug>
+#include <QtEndian>
 #include <cmath>
 
 #include <libmscore/score.h>
@@ -218,49 +219,125 @@ const std::map<QString, QString> GuitarPro6::instrumentMapping = {
 };
 
 //---------------------------------------------------------
-//   readBit
+//   GPXBitReader
+//    msb first bit stream of a BCFZ container; keeps up to
+//    64 bits of the input in a register instead of indexing
+//    the input for every single bit. Reading past the end
+//    returns zero bits.
 //---------------------------------------------------------
 
-int GuitarPro6::readBit(QByteArray* buffer)
+class GPXBitReader
 {
-    // calculate the byte index by dividing the position in bits by the bits per byte
-    int byteIndex = position / BITS_IN_BYTE;
+    const uchar* _data;
+    int _size;
+    int _next;                  // next byte to load into _bits
+    quint64 _bits { 0 };        // msb aligned
+    int _count { 0 };           // number of valid bits in _bits
+
+    void refill()
+    {
+        if (_count == 0 && _next + 8 <= _size) {
+            _bits = qFromBigEndian<quint64>(_data + _next);
+            _next += 8;
+            _count = 64;
+            return;
+        }
+        while (_count <= 56 && _next < _size) {
+            _bits |= quint64(_data[_next++]) << (56 - _count);
+            _count += 8;
+        }
+    }
 
-    // calculate our offset so we know how much to bit shift
-    int byteOffset = ((BITS_IN_BYTE - 1) - (position % BITS_IN_BYTE));
+public:
+    GPXBitReader(const QByteArray& data, int offset)
+        : _data(reinterpret_cast<const uchar*>(data.constData())), _size(data.size()), _next(offset) {}
 
-    // calculate the bit which we want to read
-    int bit = ((((*buffer)[byteIndex] & 0xff) >> byteOffset) & 0x01);
+    bool atEnd() const { return _count == 0 && _next >= _size; }
 
-    // increment our current position so we know this bit has been read
-    position++;
-    return bit;         // return the bit we calculated
-}
+    //---------------------------------------------------
+    //   readBits
+    //    read bitsToRead (<= 32) bits, first bit read
+    //    is the most significant one
+    //---------------------------------------------------
 
-//---------------------------------------------------------
-//   readBits
-//---------------------------------------------------------
+    int readBits(int bitsToRead)
+    {
+        if (bitsToRead == 0) {
+            return 0;
+        }
+        if (_count < bitsToRead) {
+            refill();
+        }
+        int bits = int(_bits >> (64 - bitsToRead));
+        _bits <<= bitsToRead;
+        _count = qMax(0, _count - bitsToRead);
+        return bits;
+    }
 
-int GuitarPro6::readBits(QByteArray* buffer, int bitsToRead)
-{
-    int bits = 0;
-    for (int i = (bitsToRead - 1); i >= 0; i--) {
-        bits |= (readBit(buffer) << i);
+    //---------------------------------------------------
+    //   readBitsReversed
+    //    first bit read is the least significant one
+    //---------------------------------------------------
+
+    int readBitsReversed(int bitsToRead)
+    {
+        int bits = readBits(bitsToRead);
+        int reversed = 0;
+        for (int i = 0; i < bitsToRead; ++i) {
+            reversed = (reversed << 1) | (bits & 1);
+            bits >>= 1;
+        }
+        return reversed;
     }
-    return bits;
-}
+};
 
 //---------------------------------------------------------
-//   readBitsReversed
+//   decompressGPX
+//    inflate a BCFZ container into the BCFS container it
+//    holds. The header gives the size of the result, so
+//    the output is allocated once and filled in place.
 //---------------------------------------------------------
 
-int GuitarPro6::readBitsReversed(QByteArray* buffer, int bitsToRead)
+static QByteArray decompressGPX(const QByteArray& buffer)
 {
-    int bits = 0;
-    for (int i = 0; i < bitsToRead; i++) {
-        bits |= readBit(buffer) << i;
+    const int headerSize = 2 * sizeof(qint32);
+    if (buffer.size() < headerSize) {
+        return QByteArray();
     }
-    return bits;
+    const int length = qFromLittleEndian<qint32>(reinterpret_cast<const uchar*>(buffer.constData()) + sizeof(qint32));
+    if (length <= 0) {
+        return QByteArray();
+    }
+    QByteArray bcfsBuffer(length, 0);
+    char* out = bcfsBuffer.data();
+    int positionCounter = 0;
+
+    GPXBitReader reader(buffer, headerSize);
+    while (positionCounter < length && !reader.atEnd()) {
+        // read the bit indicating compression information
+        if (reader.readBits(1)) {
+            // copy from the already decompressed data
+            int bits = reader.readBits(4);
+            int offs = reader.readBitsReversed(bits);
+            int size = reader.readBitsReversed(bits);
+
+            int pos = positionCounter - offs;
+            if (pos < 0) {
+                qDebug("readGPX: bad offset in compressed data");
+                break;
+            }
+            int n = qMin(qMin(size, offs), length - positionCounter);
+            memcpy(out + positionCounter, out + pos, n);      // no overlap, n <= offs
+            positionCounter += n;
+        } else {
+            int size = reader.readBitsReversed(2);
+            for (int i = 0; i < size && positionCounter < length; i++) {
+                out[positionCounter++] = char(reader.readBits(8));
+            }
+        }
+    }
+    bcfsBuffer.truncate(positionCounter);
+    return bcfsBuffer;
 }
 
 //---------------------------------------------------------
@@ -269,14 +346,7 @@ int GuitarPro6::readBitsReversed(QByteArray* buffer, int bitsToRead)
 
 QByteArray GuitarPro6::getBytes(QByteArray* buffer, int offset, int length)
 {
-    QByteArray newBytes;
-    // compute new bytes from our buffer and return byte array
-    for (int i = 0; i < length; i++) {
-        if (buffer->length() > offset + i) {
-            newBytes.insert(i, ((*buffer)[offset + i]));
-        }
-    }
-    return newBytes;
+    return buffer->mid(offset, length);
 }
 
 //---------------------------------------------------------
@@ -291,8 +361,6 @@ int GuitarPro6::readInteger(QByteArray* buffer, int offset)
     bytes[1] = (*buffer)[offset + 1];
     bytes[2] = (*buffer)[offset + 2];
     bytes[3] = (*buffer)[offset + 3];
-    // increment positioning so we keep track of where we are
-    position += sizeof(int) * BITS_IN_BYTE;
     // bit shift in order to compute our integer value and return
     return ((bytes[3] & 0xff) << 24) | ((bytes[2] & 0xff) << 16) | ((bytes[1] & 0xff) << 8) | (bytes[0] & 0xff);
 }
@@ -2679,38 +2747,12 @@ void GuitarPro6::readGPX(QByteArray* buffer)
 
     if (fileHeader == GPX_HEADER_COMPRESSED) {
         // this is  a compressed file.
-        int length             = readInteger(buffer, position / BITS_IN_BYTE);
-        QByteArray* bcfsBuffer = new QByteArray();
-        int positionCounter    = 0;
-        while (!f->error() && (position / BITS_IN_BYTE) < length) {
-            // read the bit indicating compression information
-            int flag = readBits(buffer, 1);
-
-            if (flag) {
-                int bits = readBits(buffer, 4);
-                int offs = readBitsReversed(buffer, bits);
-                int size = readBitsReversed(buffer, bits);
-
-                QByteArray bcfsBufferCopy = *bcfsBuffer;
-                int pos                   = (bcfsBufferCopy.length() - offs);
-                for (int i = 0; i < (size > offs ? offs : size); i++) {
-                    bcfsBuffer->insert(positionCounter, bcfsBufferCopy[pos + i]);
-                    positionCounter++;
-                }
-            } else {
-                int size = readBitsReversed(buffer, 2);
-                for (int i = 0; i < size; i++) {
-                    bcfsBuffer->insert(positionCounter, readBits(buffer, 8));
-                    positionCounter++;
-                }
-            }
-        }
+        QByteArray bcfsBuffer = decompressGPX(*buffer);
         // recurse on the decompressed file stored as a byte array
-        readGPX(bcfsBuffer);
-        delete bcfsBuffer;
+        readGPX(&bcfsBuffer);
     } else if (fileHeader == GPX_HEADER_UNCOMPRESSED) {
         // this is an uncompressed file - strip the header off
-        *buffer = buffer->right(buffer->length() - sizeof(int));
+        buffer->remove(0, sizeof(int));
         int sectorSize = 0x1000;
         int offset     = 0;
         while ((offset = (offset + sectorSize)) + 3 < buffer->length()) {
@@ -2723,19 +2765,18 @@ void GuitarPro6::readGPX(QByteArray* buffer)
                 // create a byte array and put information about files found in it
                 int block             = 0;
                 int blockCount        = 0;
-                QByteArray* fileBytes = new QByteArray();
+                QByteArray fileBytes;
                 while ((block = (readInteger(buffer, (indexOfBlock + (4 * (blockCount++)))))) != 0) {
-                    fileBytes->push_back(getBytes(buffer, (offset = (block * sectorSize)), sectorSize));
+                    fileBytes.append(getBytes(buffer, (offset = (block * sectorSize)), sectorSize));
                 }
                 // get file information and read the file
                 int fileSize = readInteger(buffer, indexFileSize);
-                if (fileBytes->length() >= fileSize) {
+                if (fileBytes.length() >= fileSize) {
                     QByteArray filenameBytes = readString(buffer, indexFileName, 127);
                     char* filename           = filenameBytes.data();
-                    QByteArray data          = getBytes(fileBytes, 0, fileSize);
-                    parseFile(filename, &data);
+                    fileBytes.truncate(fileSize);
+                    parseFile(filename, &fileBytes);
                 }
-                delete fileBytes;
             }
         }
     }
@@ -2757,7 +2798,6 @@ int GuitarPro6::readBeatEffects(int, Segment*)
 
 bool GuitarPro6::read(QFile* fp)
 {
-    f = fp;
     previousTempo = -1;
     QByteArray buffer = fp->readAll();
 
@@ -111,7 +111,6 @@ void GuitarPro7::readTracks(QDomNode* track)
 
 bool GuitarPro7::read(QFile* fp)
 {
-    f = fp;
     previousTempo = -1;
     MQZipReader zip(fp);
     QByteArray fileData = zip.fileData("Content/score.gpif");
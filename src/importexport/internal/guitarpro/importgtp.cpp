@@ -113,18 +113,6 @@ GuitarPro::~GuitarPro()
     delete[] slurs;
 }
 
-//---------------------------------------------------------
-//   skip
-//---------------------------------------------------------
-
-void GuitarPro::skip(qint64 len)
-{
-    f->seek(f->pos() + len);
-    /*char c;
-    while (len--)
-          read(&c, 1);*/
-}
-
 //---------------------------------------------------------
 //   createTuningString
 //---------------------------------------------------------
@@ -146,62 +134,21 @@ void GuitarPro::createTuningString(int strings, int tuning[])
     tunings.push_back(t);
 }
 
-//---------------------------------------------------------
-//    read
-//---------------------------------------------------------
-
-void GuitarPro::read(void* p, qint64 len)
-{
-    if (len == 0) {
-        return;
-    }
-    qint64 rv = f->read((char*)p, len);
-    if (rv != len) {
-        Q_ASSERT(rv == len);     //to have assert in debug and no warnings from AppVeyor in release
-    }
-    curPos += len;
-}
-
-//---------------------------------------------------------
-//   readChar
-//---------------------------------------------------------
-
-int GuitarPro::readChar()
-{
-    signed char c;
-    read(&c, 1);
-    return c;
-}
-
-//---------------------------------------------------------
-//   readUChar
-//---------------------------------------------------------
-
-int GuitarPro::readUChar()
-{
-    uchar c;
-    read(&c, 1);
-    return c;
-}
-
 //---------------------------------------------------------
 //   readPascalString
 //---------------------------------------------------------
 
 QString GuitarPro::readPascalString(int n)
 {
-    uchar l = readUChar();
-    std::vector<char> s(l + 1);
-    //char s[l + 1];
-    read(&s[0], l);
-    s[l] = 0;
+    int l = readUChar();
+    QByteArray s = _reader.readString(l);
     if (n - l > 0) {
         skip(n - l);
     }
     if (_codec) {
-        return _codec->toUnicode(&s[0]);
+        return _codec->toUnicode(s);
     } else {
-        return QString(&s[0]);
+        return QString::fromUtf8(s);
     }
 }
 
@@ -212,14 +159,11 @@ QString GuitarPro::readPascalString(int n)
 QString GuitarPro::readWordPascalString()
 {
     int l = readInt();
-    std::vector<char> c(l + 1);
-    //char c[l+1];
-    read(&c[0], l);
-    c[l] = 0;
+    QByteArray c = _reader.readString(l);
     if (_codec) {
-        return _codec->toUnicode(&c[0]);
+        return _codec->toUnicode(c);
     } else {
-        return QString::fromLocal8Bit(&c[0]);
+        return QString::fromLocal8Bit(c);
     }
 }
 
@@ -230,14 +174,11 @@ QString GuitarPro::readWordPascalString()
 QString GuitarPro::readBytePascalString()
 {
     int l = readUChar();
-    std::vector<char> c(l + 1);
-    //char c[l+1];
-    read(&c[0], l);
-    c[l] = 0;
+    QByteArray c = _reader.readString(l);
     if (_codec) {
-        return _codec->toUnicode(&c[0]);
+        return _codec->toUnicode(c);
     } else {
-        return QString::fromLocal8Bit(&c[0]);
+        return QString::fromLocal8Bit(c);
     }
 }
 
@@ -250,42 +191,17 @@ QString GuitarPro::readDelphiString()
     int maxl = readInt();
     int l    = readUChar();
     if (maxl != l + 1 && maxl > 255) {
-        qFatal("readDelphiString: first word doesn't match second byte");
+        qDebug("readDelphiString: first word doesn't match second byte");
         l = maxl - 1;
     }
-    std::vector<char> c(l + 1);
-    //char c[l + 1];
-    read(&c[0], l);
-    c[l] = 0;
-    std::string g(&c[0]);
-    if (g.find("2nd ") == 0) {
-        //?? int k = 1;
-    }
+    QByteArray c = _reader.readString(l);
     if (_codec) {
-        return _codec->toUnicode(&c[0]);
+        return _codec->toUnicode(c);
     } else {
-        return QString::fromLatin1(&c[0]);
+        return QString::fromLatin1(c);
     }
 }
 
-//---------------------------------------------------------
-//   readInt
-//---------------------------------------------------------
-
-int GuitarPro::readInt()
-{
-    uchar x;
-    read(&x, 1);
-    int r = x;
-    read(&x, 1);
-    r += x << 8;
-    read(&x, 1);
-    r += x << 16;
-    read(&x, 1);
-    r += x << 24;
-    return r;
-}
-
 //---------------------------------------------------------
 //   initGuitarProDrumset
 //---------------------------------------------------------
@@ -739,7 +655,9 @@ void GuitarPro::setTuplet(Tuplet* tuplet, int tuple)
         tuplet->setRatio(Fraction(13,8));
         break;
     default:
-        qFatal("unsupported tuplet %d\n", tuple);
+        qDebug("unsupported tuplet %d", tuple);
+        tuplet->setRatio(Fraction(1,1));
+        break;
     }
 }
 
@@ -1218,8 +1136,7 @@ void GuitarPro::applyBeatEffects(Chord* chord, int beatEffect)
 
 bool GuitarPro1::read(QFile* fp)
 {
-    f      = fp;
-    curPos = 30;
+    _reader = BinaryReader::fromDevice(fp);
 
     title  = readDelphiString();
     artist = readDelphiString();
@@ -1243,6 +1160,10 @@ bool GuitarPro1::read(QFile* fp)
     //int tnumerator   = 4;
     //int tdenominator = 4;
 
+    if (_reader.error()) {
+        return false;
+    }
+
     //
     // create a part for every staff
     //
@@ -1262,6 +1183,9 @@ bool GuitarPro1::read(QFile* fp)
         for (int j = 0; j < strings; ++j) {
             tuning[j] = readInt();
         }
+        if (_reader.error()) {
+            return false;
+        }
         std::vector<int> tuning2(strings);
         //int tuning2[strings];
         for (int k = 0; k < strings; ++k) {
@@ -1307,6 +1231,9 @@ bool GuitarPro1::read(QFile* fp)
     Measure* measure = score->firstMeasure();
     bool mixChange = false;
     for (int bar = 0; bar < measures; ++bar, measure = measure->nextMeasure()) {
+        if (_reader.error()) {
+            break;
+        }
         const GpBar& gpbar = bars[bar];
 
         if (!gpbar.marker.isEmpty()) {
@@ -1600,8 +1527,7 @@ void GuitarPro::createOttava(bool hasOttava, int track, ChordRest* cr, QString v
 
 bool GuitarPro2::read(QFile* fp)
 {
-    f      = fp;
-    curPos = 30;
+    _reader = BinaryReader::fromDevice(fp);
 
     title        = readDelphiString();
     subtitle     = readDelphiString();
@@ -1683,6 +1609,10 @@ bool GuitarPro2::read(QFile* fp)
         bars.append(bar);
     }
 
+    if (_reader.error()) {
+        return false;
+    }
+
     //
     // create a part for every staff
     //
@@ -1745,6 +1675,9 @@ bool GuitarPro2::read(QFile* fp)
         int capo         = readInt();
         /*int color        =*/ readInt();
 
+        if (_reader.error()) {
+            return false;
+        }
         std::vector<int> tuning2(strings);
         //int tuning2[strings];
         for (int k = 0; k < strings; ++k) {
@@ -1808,6 +1741,9 @@ bool GuitarPro2::read(QFile* fp)
     Measure* measure = score->firstMeasure();
     bool mixChange = false;
     for (int bar = 0; bar < measures; ++bar, measure = measure->nextMeasure()) {
+        if (_reader.error()) {
+            break;
+        }
         const GpBar& gpbar = bars[bar];
 
         if (!gpbar.marker.isEmpty()) {
@@ -2279,8 +2215,7 @@ int GuitarPro1::readBeatEffects(int, Segment*)
 
 bool GuitarPro3::read(QFile* fp)
 {
-    f      = fp;
-    curPos = 30;
+    _reader = BinaryReader::fromDevice(fp);
 
     title        = readDelphiString();
     subtitle     = readDelphiString();
@@ -2377,6 +2312,10 @@ bool GuitarPro3::read(QFile* fp)
         bars.append(bar);
     }
 
+    if (_reader.error()) {
+        return false;
+    }
+
     //
     // create a part for every staff
     //
@@ -2466,6 +2405,9 @@ bool GuitarPro3::read(QFile* fp)
         int capo         = readInt();
         /*int color        =*/ readInt();
 
+        if (_reader.error()) {
+            return false;
+        }
         std::vector<int> tuning2(strings);
         //int tuning2[strings];
         for (int k = 0; k < strings; ++k) {
@@ -2528,6 +2470,9 @@ bool GuitarPro3::read(QFile* fp)
     Measure* measure = score->firstMeasure();
     bool mixChange = false;
     for (int bar = 0; bar < measures; ++bar, measure = measure->nextMeasure()) {
+        if (_reader.error()) {
+            break;
+        }
         const GpBar& gpbar = bars[bar];
 
         if (!gpbar.marker.isEmpty()) {
@@ -2971,7 +2916,7 @@ Score::FileError importGTP(MasterScore* score, const QString& name)
         fp.read((char*)&l, 1);
         char ss[30];
         fp.read(ss, 30);
-        ss[l] = 0;
+        ss[qMin(int(l), 29)] = 0;
         QString s(ss);
         if (s.startsWith("FICHIER GUITAR PRO ")) {
             s = s.mid(20);
@@ -3004,6 +2949,11 @@ Score::FileError importGTP(MasterScore* score, const QString& name)
     } else {
         return Score::FileError::FILE_BAD_FORMAT;
     }
+    if (gp->truncated()) {
+        qDebug("guitar pro import error: unexpected end of file");
+        delete gp;
+        return Score::FileError::FILE_CORRUPTED;
+    }
     if (readResult == false) {
         /*if (!MScore::noGui) {
               QMessageBox::warning(0,
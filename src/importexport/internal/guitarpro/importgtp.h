@@ -38,6 +38,8 @@
 #include <libmscore/vibrato.h>
 #include <libmscore/drumset.h>
 
+#include "../binaryreader.h"
+
 #include "modularity/ioc.h"
 #include "importexport/iimportexportconfiguration.h"
 
@@ -205,8 +207,7 @@ protected:
     std::vector<Ottava*> ottava;
     Hairpin** hairpins;
     MasterScore* score;
-    QFile* f;
-    int curPos;
+    BinaryReader _reader;
     int previousTempo;
     int previousDynamic;
     std::vector<int> ottavaFound;
@@ -221,14 +222,14 @@ protected:
     QTextCodec* _codec { 0 };
     Slur** slurs       { nullptr };
 
-    void skip(qint64 len);
-    void read(void* p, qint64 len);
-    int readUChar();
-    int readChar();
+    void skip(qint64 len) { _reader.skip(len); }
+    void read(void* p, qint64 len) { _reader.read(p, len); }
+    int readUChar() { return _reader.readUInt8(); }
+    int readChar() { return _reader.readInt8(); }
     QString readPascalString(int);
     QString readWordPascalString();
     QString readBytePascalString();
-    int readInt();
+    int readInt() { return _reader.readInt32(); }
     QString readDelphiString();
     void readVolta(GPVolta*, Measure*);
     virtual void readBend(Note*);
@@ -284,6 +285,7 @@ public:
     virtual ~GuitarPro();
     virtual bool read(QFile*) = 0;
     QString error(GuitarProError n) const { return QString(errmsg[int(n)]); }
+    bool truncated() const { return _reader.error(); }    ///< the file ended before the data did
 };
 
 //---------------------------------------------------------
@@ -386,9 +388,6 @@ class GuitarPro6 : public GuitarPro
     const int GPX_HEADER_UNCOMPRESSED = 1397113666;
     // an integer stored in the header indicating that the file is not compressed (BCFZ).
     const int GPX_HEADER_COMPRESSED = 1514554178;
-    int position = 0;
-    // a constant storing the amount of bits per byte
-    const int BITS_IN_BYTE = 8;
     // contains all the information about notes that will go in the parts
     struct GPPartInfo {
         QDomNode masterBars;
@@ -402,13 +401,10 @@ class GuitarPro6 : public GuitarPro
     // a mapping from identifiers to fret diagrams
     QMap<int, FretDiagram*> fretDiagrams;
     void parseFile(const char* filename, QByteArray* data);
-    int readBit(QByteArray* buffer);
     QByteArray getBytes(QByteArray* buffer, int offset, int length);
     void readGPX(QByteArray* buffer);
     int readInteger(QByteArray* buffer, int offset);
     QByteArray readString(QByteArray* buffer, int offset, int length);
-    int readBits(QByteArray* buffer, int bitsToRead);
-    int readBitsReversed(QByteArray* buffer, int bitsToRead);
     void readScore(QDomNode* metadata);
     void readChord(QDomNode* diagram, int track);
     int findNumMeasures(GPPartInfo* partInfo);
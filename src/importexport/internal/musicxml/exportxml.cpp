@@ -253,10 +253,12 @@ class SlurHandler
 {
     const Slur* slur[MAX_NUMBER_LEVEL];
     bool started[MAX_NUMBER_LEVEL];
+    QHash<const Element*, std::vector<const Slur*> > _slurs;    // start and end element -> slurs, in spanner map order
     int findSlur(const Slur* s) const;
 
 public:
     SlurHandler();
+    void init(const Score* score);
     void doSlurs(const ChordRest* chordRest, Notations& notations, XmlWriter& xml);
 
 private:
@@ -325,6 +327,7 @@ struct MeasurePrintContext final
 
 typedef QHash<const ChordRest* const, const Trill*> TrillHash;
 typedef QMap<const Instrument*, int> MxmlInstrumentMap;
+typedef QHash<int, std::vector<Spanner*> > SpannerStopHash;
 
 class ExportMusicXml
 {
@@ -349,6 +352,7 @@ class ExportMusicXml
     TrillHash _trillStart;
     TrillHash _trillStop;
     MxmlInstrumentMap instrMap;
+    SpannerStopHash _spannerStops;      // tick2 -> spanners, in spanner map order
 
     int findBracket(const TextLineBase* tl) const;
     int findDashes(const TextLineBase* tl) const;
@@ -367,6 +371,7 @@ class ExportMusicXml
     void work(const MeasureBase* measure);
     void calcDivMoveToTick(const Fraction& t);
     void calcDivisions();
+    void initSpannerIndexes();
     void keysigTimesig(const Measure* m, const Part* p);
     void chordAttributes(Chord* chord, Notations& notations, Technical& technical,TrillHash& trillStart, TrillHash& trillStop);
     void wavyLineStartStop(const ChordRest* const cr, Notations& notations, Ornaments& ornaments,TrillHash& trillStart,
@@ -419,6 +424,7 @@ public:
     double getTenthsFromInches(double) const;
     double getTenthsFromDots(double) const;
     Fraction tick() const { return _tick; }
+    const std::vector<Spanner*>& spannersEndingAt(const Fraction& tick2) const;
     void writeInstrumentDetails(const Instrument* instrument);
 };
 
@@ -658,6 +664,31 @@ SlurHandler::SlurHandler()
     }
 }
 
+//---------------------------------------------------------
+//   init
+//    index the slurs of score by start and end element,
+//    so that doSlurs() does not scan all spanners for
+//    every chord or rest
+//---------------------------------------------------------
+
+void SlurHandler::init(const Score* score)
+{
+    _slurs.clear();
+    for (const auto it : score->spanner()) {
+        const Spanner* sp = it.second;
+        if (sp->generated() || sp->type() != ElementType::SLUR) {
+            continue;
+        }
+        const Slur* s = static_cast<const Slur*>(sp);
+        if (sp->startElement()) {
+            _slurs[sp->startElement()].push_back(s);
+        }
+        if (sp->endElement() && sp->endElement() != sp->startElement()) {
+            _slurs[sp->endElement()].push_back(s);
+        }
+    }
+}
+
 static QString slurTieLineStyle(const SlurTie* s)
 {
     QString lineType;
@@ -757,28 +788,25 @@ static const ChordRest* findFirstChordRest(const Slur* s)
 
 void SlurHandler::doSlurs(const ChordRest* chordRest, Notations& notations, XmlWriter& xml)
 {
+    const auto it = _slurs.constFind(chordRest);
+    if (it == _slurs.constEnd()) {
+        return;
+    }
     // loop over all slurs twice, first to handle the stops, then the starts
     for (int i = 0; i < 2; ++i) {
-        // search for slur(s) starting or stopping at this chord
-        for (const auto it : chordRest->score()->spanner()) {
-            auto sp = it.second;
-            if (sp->generated() || sp->type() != ElementType::SLUR) {
-                continue;
-            }
-            if (chordRest == sp->startElement() || chordRest == sp->endElement()) {
-                const auto s = static_cast<const Slur*>(sp);
-                const auto firstChordRest = findFirstChordRest(s);
-                if (firstChordRest) {
-                    if (i == 0) {
-                        // first time: do slur stops
-                        if (firstChordRest != chordRest) {
-                            doSlurStop(s, notations, xml);
-                        }
-                    } else {
-                        // second time: do slur starts
-                        if (firstChordRest == chordRest) {
-                            doSlurStart(s, notations, xml);
-                        }
+        // slur(s) starting or stopping at this chord
+        for (const Slur* s : it.value()) {
+            const auto firstChordRest = findFirstChordRest(s);
+            if (firstChordRest) {
+                if (i == 0) {
+                    // first time: do slur stops
+                    if (firstChordRest != chordRest) {
+                        doSlurStop(s, notations, xml);
+                    }
+                } else {
+                    // second time: do slur starts
+                    if (firstChordRest == chordRest) {
+                        doSlurStart(s, notations, xml);
                     }
                 }
             }
@@ -5408,6 +5436,33 @@ static void figuredBass(XmlWriter& xml, int strack, int etrack, int track, const
     }
 }
 
+//---------------------------------------------------------
+//  initSpannerIndexes
+//    index the spanners once per export instead of
+//    scanning the whole spanner map for every chord, rest
+//    and measure
+//---------------------------------------------------------
+
+void ExportMusicXml::initSpannerIndexes()
+{
+    _spannerStops.clear();
+    for (auto it : _score->spanner()) {
+        _spannerStops[it.second->tick2().ticks()].push_back(it.second);
+    }
+    sh.init(_score);
+}
+
+//---------------------------------------------------------
+//  spannersEndingAt
+//---------------------------------------------------------
+
+const std::vector<Spanner*>& ExportMusicXml::spannersEndingAt(const Fraction& tick2) const
+{
+    static const std::vector<Spanner*> empty;
+    const auto it = _spannerStops.constFind(tick2.ticks());
+    return it == _spannerStops.constEnd() ? empty : it.value();
+}
+
 //---------------------------------------------------------
 //  spannerStart
 //---------------------------------------------------------
@@ -5475,16 +5530,14 @@ static void spannerStart(ExportMusicXml* exp, int strack, int etrack, int track,
 //---------------------------------------------------------
 
 // called after writing each chord or rest to check if a spanner must be stopped
-// loop over all spanners and find spanners in strack ending at tick2
+// loop over the spanners ending at tick2 and find those in strack
 // note that more than one voice may contains notes ending at tick2,
 // remember which spanners have already been stopped (the "stopped" set)
 
 static void spannerStop(ExportMusicXml* exp, int strack, int etrack, const Fraction& tick2, int sstaff,
                         QSet<const Spanner*>& stopped)
 {
-    for (auto it : exp->score()->spanner()) {
-        Spanner* e = it.second;
-
+    for (Spanner* e : exp->spannersEndingAt(tick2)) {
         if (e->tick2() != tick2 || e->track() < strack || e->track() >= etrack) {
             continue;
         }
@@ -6917,6 +6970,7 @@ void ExportMusicXml::write(QIODevice* dev)
     }
 
     calcDivisions();
+    initSpannerIndexes();
 
     for (int i = 0; i < MAX_NUMBER_LEVEL; ++i) {
         brackets[i] = nullptr;
@@ -6947,6 +7001,7 @@ void ExportMusicXml::write(QIODevice* dev)
     writeParts();
 
     _xml.etag();
+    _xml.flush();
 
     if (concertPitch) {
         // restore concert pitch
@@ -7003,7 +7058,7 @@ bool saveXml(Score* score, const QString& name)
 //     </rootfiles>
 // </container>
 
-static void writeMxlArchive(Score* score, MQZipWriter& zipwriter, const QString& filename)
+static bool writeMxlArchive(Score* score, MQZipWriter& zipwriter, const QString& filename)
 {
     QBuffer cbuf;
     cbuf.open(QIODevice::ReadWrite);
@@ -7023,12 +7078,18 @@ static void writeMxlArchive(Score* score, MQZipWriter& zipwriter, const QString&
     //uz.addDirectory("META-INF");
     zipwriter.addFile("META-INF/container.xml", cbuf.data());
 
-    QBuffer dbuf;
-    dbuf.open(QIODevice::ReadWrite);
-    ExportMusicXml em(score);
-    em.write(&dbuf);
-    dbuf.seek(0);
-    zipwriter.addFile(filename, dbuf.data());
+    // the score is exported straight into the deflated zip entry,
+    // so that memory use does not grow with the size of the score
+    QIODevice* dev = zipwriter.openFile(filename);
+    if (!dev) {
+        return false;
+    }
+    {
+        ExportMusicXml em(score);
+        em.write(dev);
+    }
+    dev->close();
+    return zipwriter.status() == MQZipWriter::NoError;
 }
 
 bool saveMxl(Score* score, QIODevice* device)
@@ -7037,10 +7098,10 @@ bool saveMxl(Score* score, QIODevice* device)
 
     //anonymized filename since we don't know the actual one here
     QString fn = "score.xml";
-    writeMxlArchive(score, uz, fn);
+    bool res = writeMxlArchive(score, uz, fn);
     uz.close();
 
-    return true;
+    return res;
 }
 
 bool saveMxl(Score* score, const QString& name)
@@ -7049,9 +7110,7 @@ bool saveMxl(Score* score, const QString& name)
 
     QFileInfo fi(name);
     QString fn = fi.completeBaseName() + ".xml";
-    writeMxlArchive(score, uz, fn);
-
-    return true;
+    return writeMxlArchive(score, uz, fn);
 }
 
 double ExportMusicXml::getTenthsFromInches(double inches) const
@@ -3998,37 +3998,14 @@ QList<MidiData*> MeasureData::getMidiDatas(MidiType type)
 //////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////////////
 StreamHandle::StreamHandle()
-    : size_(0), curPos_(0), point_(NULL)
 {
 }
 
 StreamHandle::StreamHandle(unsigned char* p, int size)
-    : size_(size), curPos_(0), point_(p)
+    : reader_(reinterpret_cast<const char*>(p), p ? size : 0)
 {
 }
 
-StreamHandle::~StreamHandle()
-{
-    point_ = NULL;
-}
-
-bool StreamHandle::read(char* buff, int size)
-{
-    if (point_ != NULL && curPos_ + size <= size_) {
-        memcpy(buff, point_ + curPos_, size);
-        curPos_ += size;
-
-        return true;
-    }
-
-    return false;
-}
-
-bool StreamHandle::write(char* /*buff*/, int /*size*/)
-{
-    return true;
-}
-
 // Block.cpp
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 Block::Block()
@@ -4048,22 +4025,17 @@ void Block::resize(unsigned int count)
 
 void Block::doResize(unsigned int count)
 {
-    data_.clear();
-    for (unsigned int i=0; i < count; ++i) {
-        data_.push_back('\0');
-    }
-    //data_.resize(count);
+    data_.fill('\0', int(count));
 }
 
 const unsigned char* Block::data() const
 {
-    //return const_cast<unsigned char*>(&data_.front());
-    return &data_.front();
+    return reinterpret_cast<const unsigned char*>(data_.constData());
 }
 
 unsigned char* Block::data()
 {
-    return &data_.front();
+    return reinterpret_cast<unsigned char*>(data_.data());
 }
 
 int Block::size() const
@@ -4409,8 +4381,7 @@ bool BasicParse::jump(int offset)
     }
 
     if (offset > 0) {
-        Block placeHolder(offset);
-        return handle_->read((char*)placeHolder.data(), placeHolder.size());
+        return handle_->skip(offset);
     }
 
     return true;
@@ -10794,6 +10765,9 @@ bool OveSerialize::readSizeChunk(SizeChunk* sizeChunk)
     }
 
     unsigned int blockSize = sizeBlock->toSize();
+    if (blockSize > streamHandle_->bytesAvailable()) {
+        return false;
+    }
 
     sizeChunk->getDataBlock()->resize(blockSize);
 
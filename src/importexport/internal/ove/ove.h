@@ -24,6 +24,8 @@
 #include <QString>
 #include <cmath>
 
+#include "../binaryreader.h"
+
 #ifdef WIN32
 #define DLL_EXPORT extern "C" __declspec(dllexport)
 #else
@@ -2232,19 +2234,17 @@ class StreamHandle
 {
 public:
     StreamHandle(unsigned char* p, int size);
-    virtual ~StreamHandle();
 
 private:
     StreamHandle();
 
 public:
-    virtual bool read(char* buff, int size);
-    virtual bool write(char* buff, int size);
+    bool read(char* buff, int size) { return reader_.read(buff, size); }
+    bool skip(int size) { reader_.skip(size); return !reader_.error(); }
+    qint64 bytesAvailable() const { return reader_.size() - reader_.pos(); }
 
 private:
-    int size_;
-    int curPos_;
-    unsigned char* point_;
+    Ms::BinaryReader reader_;
 };
 
 // Block.h
@@ -2279,8 +2279,7 @@ private:
     void doResize(unsigned int count);
 
 private:
-    // char [-128, 127], unsigned char [0, 255]
-    QList<unsigned char> data_;
+    QByteArray data_;
 };
 
 class FixedBlock : public Block
@@ -31,36 +31,14 @@ void ElementRepositoryService::updateElementList(const QList<Ms::Element*>& newR
 {
     m_elementList = exposeRawElements(newRawElementList);
 
+    buildElementIndex();
+
     emit elementsUpdated();
 }
 
 QList<Ms::Element*> ElementRepositoryService::findElementsByType(const Ms::ElementType elementType) const
 {
-    switch (elementType) {
-    case Ms::ElementType::CHORD: return findChords();
-    case Ms::ElementType::NOTE: return findNotes();
-    case Ms::ElementType::STEM: return findStems();
-    case Ms::ElementType::HOOK: return findHooks();
-    case Ms::ElementType::BEAM: return findBeams();
-    case Ms::ElementType::GLISSANDO: return findGlissandos();
-    case Ms::ElementType::HAIRPIN: return findHairpins();
-    case Ms::ElementType::STAFF: return findStaffs();
-    case Ms::ElementType::LAYOUT_BREAK: return findSectionBreaks(); //Page breaks and line breaks are of type LAYOUT_BREAK, but they don't appear in the inspector for now.
-    case Ms::ElementType::PEDAL: return findPedals();
-    case Ms::ElementType::CLEF: return findPairedClefs();
-    case Ms::ElementType::TEXT: return findTexts();
-    case Ms::ElementType::TREMOLO: return findTremolos();
-    default:
-        QList<Ms::Element*> resultList;
-
-        for (Ms::Element* element : m_elementList) {
-            if (element->type() == elementType) {
-                resultList << element;
-            }
-        }
-
-        return resultList;
-    }
+    return m_elementsByType.value(elementType);
 }
 
 QList<Ms::Element*> ElementRepositoryService::findElementsByType(const Ms::ElementType elementType,
@@ -87,10 +65,14 @@ QList<Ms::Element*> ElementRepositoryService::takeAllElements() const
 QList<Ms::Element*> ElementRepositoryService::exposeRawElements(const QList<Ms::Element*>& rawElementList) const
 {
     QList<Ms::Element*> resultList;
+    QSet<Ms::Element*> exposedElements;
 
     for (const Ms::Element* element : rawElementList) {
-        if (!resultList.contains(element->elementBase())) {
-            resultList << element->elementBase();
+        Ms::Element* elementBase = element->elementBase();
+
+        if (!exposedElements.contains(elementBase)) {
+            exposedElements.insert(elementBase);
+            resultList << elementBase;
         }
 
         if (element->type() == Ms::ElementType::BEAM) {
@@ -105,244 +87,107 @@ QList<Ms::Element*> ElementRepositoryService::exposeRawElements(const QList<Ms::
     return resultList;
 }
 
-QList<Ms::Element*> ElementRepositoryService::findChords() const
-{
-    QList<Ms::Element*> resultList;
-
-    for (Ms::Element* element : m_elementList) {
-        if (element->type() == Ms::ElementType::CHORD) {
-            resultList << element;
-        }
-    }
-
-    return resultList;
-}
-
-QList<Ms::Element*> ElementRepositoryService::findNotes() const
-{
-    QList<Ms::Element*> resultList;
-
-    for (const Ms::Element* element : findChords()) {
-        const Ms::Chord* chord = Ms::toChord(element);
-
-        if (!chord) {
-            continue;
-        }
-
-        for (Ms::Element* note : chord->notes()) {
-            resultList << note;
-        }
-    }
-
-    return resultList;
-}
-
-QList<Ms::Element*> ElementRepositoryService::findStems() const
+void ElementRepositoryService::buildElementIndex()
 {
-    QList<Ms::Element*> resultList;
-
-    for (const Ms::Element* element : findChords()) {
-        const Ms::Chord* chord = Ms::toChord(element);
+    m_elementsByType.clear();
 
-        if (chord && chord->stem()) {
-            resultList << chord->stem();
-        }
-    }
+    QSet<Ms::Element*> indexedBeams;
 
-    return resultList;
-}
-
-QList<Ms::Element*> ElementRepositoryService::findHooks() const
-{
-    QList<Ms::Element*> resultList;
-
-    for (const Ms::Element* element : findChords()) {
-        const Ms::Chord* chord = Ms::toChord(element);
-
-        if (chord && chord->hook()) {
-            resultList << chord->hook();
-        }
-    }
-
-    return resultList;
-}
-
-QList<Ms::Element*> ElementRepositoryService::findBeams() const
-{
-    QList<Ms::Element*> resultList;
-
-    for (const Ms::Element* element : findChords()) {
-        Ms::Element* beam = nullptr;
-
-        if (element->isChord()) {
-            const Ms::Chord* chord = Ms::toChord(element);
-
-            if (!chord) {
-                continue;
-            }
-
-            beam = chord->beam();
-        } else if (element->isBeam()) {
-            beam = const_cast<Ms::Element*>(element);
-        }
-
-        if (!beam || resultList.contains(beam)) {
+    for (Ms::Element* element : m_elementList) {
+        IF_ASSERT_FAILED(element) {
             continue;
         }
 
-        resultList << beam;
-    }
-
-    return resultList;
-}
-
-QList<Ms::Element*> ElementRepositoryService::findGlissandos() const
-{
-    QList<Ms::Element*> resultList;
-
-    for (Ms::Element* element : m_elementList) {
-        if (element->type() == Ms::ElementType::GLISSANDO_SEGMENT) {
-            const Ms::GlissandoSegment* glissandoSegment = Ms::toGlissandoSegment(element);
-
-            if (!glissandoSegment) {
-                continue;
+        if (element->staff()) {
+            m_elementsByType[Ms::ElementType::STAFF] << element->staff();
+        }
+
+        switch (element->type()) {
+        case Ms::ElementType::CHORD:
+            indexChord(element, indexedBeams);
+            break;
+        case Ms::ElementType::GLISSANDO_SEGMENT:
+            m_elementsByType[Ms::ElementType::GLISSANDO_SEGMENT] << element;
+            m_elementsByType[Ms::ElementType::GLISSANDO] << Ms::toGlissandoSegment(element)->glissando();
+            break;
+        case Ms::ElementType::HAIRPIN_SEGMENT:
+            m_elementsByType[Ms::ElementType::HAIRPIN_SEGMENT] << element;
+            m_elementsByType[Ms::ElementType::HAIRPIN] << Ms::toHairpinSegment(element)->hairpin();
+            break;
+        case Ms::ElementType::PEDAL_SEGMENT:
+            m_elementsByType[Ms::ElementType::PEDAL_SEGMENT] << element;
+            m_elementsByType[Ms::ElementType::PEDAL] << Ms::toPedalSegment(element)->pedal();
+            break;
+        case Ms::ElementType::LAYOUT_BREAK:
+            //Page breaks and line breaks are of type LAYOUT_BREAK, but they don't appear in the inspector for now.
+            if (Ms::toLayoutBreak(element)->layoutBreakType() == Ms::LayoutBreak::SECTION) {
+                m_elementsByType[Ms::ElementType::LAYOUT_BREAK] << element;
             }
+            break;
+        case Ms::ElementType::CLEF: {
+            Ms::Clef* clef = Ms::toClef(element);
+            m_elementsByType[Ms::ElementType::CLEF] << clef; //could be both main clef and courtesy clef
 
-            resultList << glissandoSegment->glissando();
-        } else if (element->type() == Ms::ElementType::GLISSANDO) {
-            resultList << element;
-        }
-    }
-
-    return resultList;
-}
-
-QList<Ms::Element*> ElementRepositoryService::findHairpins() const
-{
-    QList<Ms::Element*> resultList;
-
-    for (Ms::Element* element : m_elementList) {
-        if (element->type() == Ms::ElementType::HAIRPIN_SEGMENT) {
-            const Ms::HairpinSegment* hairpinSegment = Ms::toHairpinSegment(element);
-
-            if (!hairpinSegment) {
-                continue;
+            Ms::Clef* courtesyPairClef = clef->otherClef(); //seeking for a "pair" clef
+            if (courtesyPairClef) {
+                m_elementsByType[Ms::ElementType::CLEF] << courtesyPairClef;
             }
-
-            resultList << hairpinSegment->hairpin();
-        } else if (element->type() == Ms::ElementType::HAIRPIN) {
-            resultList << element;
-        }
-    }
-
-    return resultList;
-}
-
-QList<Ms::Element*> ElementRepositoryService::findStaffs() const
-{
-    QList<Ms::Element*> resultList;
-
-    for (const Ms::Element* element : m_elementList) {
-        if (!element->staff()) {
-            continue;
-        }
-
-        resultList << element->staff();
-    }
-
-    return resultList;
-}
-
-QList<Ms::Element*> ElementRepositoryService::findSectionBreaks() const
-{
-    QList<Ms::Element*> resultList;
-
-    for (Ms::Element* element : m_elementList) {
-        if (element && element->type() == Ms::ElementType::LAYOUT_BREAK) {
-            const Ms::LayoutBreak* layoutBreak = Ms::toLayoutBreak(element);
-            if (layoutBreak->layoutBreakType() != Ms::LayoutBreak::SECTION) {
-                continue;
+            break;
+        }
+        case Ms::ElementType::TEXT:
+            m_elementsByType[Ms::ElementType::TEXT] << element;
+            break;
+        case Ms::ElementType::STAFF_TEXT:
+        case Ms::ElementType::SYSTEM_TEXT:
+            m_elementsByType[element->type()] << element;
+            m_elementsByType[Ms::ElementType::TEXT] << element;
+            break;
+        case Ms::ElementType::TREMOLO:
+            // the tremolo section currently only has a style setting
+            // so only tremolos which can have custom styles make it appear
+            if (Ms::toTremolo(element)->customStyleApplicable()) {
+                m_elementsByType[Ms::ElementType::TREMOLO] << element;
             }
-
-            resultList << element;
+            break;
+        //! NOTE Notes, stems, hooks and beams are only exposed through their chords
+        case Ms::ElementType::NOTE:
+        case Ms::ElementType::STEM:
+        case Ms::ElementType::HOOK:
+        case Ms::ElementType::BEAM:
+            break;
+        default:
+            m_elementsByType[element->type()] << element;
+            break;
         }
     }
-
-    return resultList;
 }
 
-QList<Ms::Element*> ElementRepositoryService::findPedals() const
+void ElementRepositoryService::indexChord(Ms::Element* element, QSet<Ms::Element*>& indexedBeams)
 {
-    QList<Ms::Element*> resultList;
+    Ms::Chord* chord = Ms::toChord(element);
 
-    for (Ms::Element* element : m_elementList) {
-        if (element->type() == Ms::ElementType::PEDAL_SEGMENT) {
-            const Ms::PedalSegment* pedalSegment = Ms::toPedalSegment(element);
+    m_elementsByType[Ms::ElementType::CHORD] << chord;
 
-            if (!pedalSegment) {
-                continue;
-            }
-
-            resultList << pedalSegment->pedal();
-        } else if (element->type() == Ms::ElementType::PEDAL) {
-            resultList << element;
-        }
+    QList<Ms::Element*>& noteList = m_elementsByType[Ms::ElementType::NOTE];
+    for (Ms::Element* note : chord->notes()) {
+        noteList << note;
     }
 
-    return resultList;
-}
-
-QList<Ms::Element*> ElementRepositoryService::findPairedClefs() const
-{
-    QList<Ms::Element*> resultList;
-
-    for (Ms::Element* element : m_elementList) {
-        if (element->type() == Ms::ElementType::CLEF) {
-            auto clef = Ms::toClef(element);
-            IF_ASSERT_FAILED(clef) {
-                continue;
-            }
-
-            resultList << clef; //could be both main clef and courtesy clef
-
-            auto courtesyPairClef = clef->otherClef(); //seeking for a "pair" clef
-            if (courtesyPairClef) {
-                resultList << courtesyPairClef;
-            }
-        }
+    if (chord->stem()) {
+        m_elementsByType[Ms::ElementType::STEM] << chord->stem();
     }
 
-    return resultList;
-}
-
-QList<Ms::Element*> ElementRepositoryService::findTexts() const
-{
-    QList<Ms::Element*> resultList;
-
-    for (Ms::Element* element : m_elementList) {
-        if (element->type() == Ms::ElementType::TEXT
-            || element->type() == Ms::ElementType::STAFF_TEXT
-            || element->type() == Ms::ElementType::SYSTEM_TEXT) {
-            resultList << element;
-        }
+    if (chord->hook()) {
+        m_elementsByType[Ms::ElementType::HOOK] << chord->hook();
     }
 
-    return resultList;
-}
-
-QList<Ms::Element*> ElementRepositoryService::findTremolos() const
-{
-    QList<Ms::Element*> resultList;
+    Ms::Element* beam = chord->beam();
+    if (beam) {
+        QList<Ms::Element*>& beamList = m_elementsByType[Ms::ElementType::BEAM];
 
-    for (Ms::Element* element : m_elementList) {
-        if (element->isTremolo()) {
-            // the tremolo section currently only has a style setting
-            // so only tremolos which can have custom styles make it appear
-            if (Ms::toTremolo(element)->customStyleApplicable()) {
-                resultList << element;
-            }
+        if (!indexedBeams.contains(beam)) {
+            indexedBeams.insert(beam);
+            beamList << beam;
         }
     }
-
-    return resultList;
 }
@@ -4,6 +4,8 @@
 #include "internal/interfaces/ielementrepositoryservice.h"
 
 #include <QObject>
+#include <QHash>
+#include <QSet>
 
 class ElementRepositoryService : public QObject, public IElementRepositoryService
 {
@@ -27,19 +29,12 @@ private:
 
     QList<Ms::Element*> exposeRawElements(const QList<Ms::Element*>& rawElementList) const;
 
-    QList<Ms::Element*> findChords() const;
-    QList<Ms::Element*> findNotes() const;
-    QList<Ms::Element*> findStems() const;
-    QList<Ms::Element*> findHooks() const;
-    QList<Ms::Element*> findBeams() const;
-    QList<Ms::Element*> findGlissandos() const;
-    QList<Ms::Element*> findHairpins() const;
-    QList<Ms::Element*> findStaffs() const;
-    QList<Ms::Element*> findSectionBreaks() const;
-    QList<Ms::Element*> findPedals() const;
-    QList<Ms::Element*> findPairedClefs() const;
-    QList<Ms::Element*> findTexts() const;
-    QList<Ms::Element*> findTremolos() const;
+    //! NOTE Every query result is collected in a single pass over the element list when the selection changes,
+    //! so that each inspector model reads its elements in O(1) instead of walking the whole selection again
+    void buildElementIndex();
+    void indexChord(Ms::Element* element, QSet<Ms::Element*>& indexedBeams);
+
+    QHash<Ms::ElementType, QList<Ms::Element*> > m_elementsByType;
 };
 
 #endif // ELEMENTREPOSITORYSERVICE_H
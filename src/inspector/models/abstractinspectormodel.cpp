@@ -1,6 +1,7 @@
 #include "abstractinspectormodel.h"
 
 #include "libmscore/musescoreCore.h"
+#include "libmscore/undo.h"
 #include "log.h"
 
 static const QList<Ms::ElementType> NOTATION_ELEMENT_TYPES = {
@@ -105,6 +106,11 @@ bool AbstractInspectorModel::isEmpty() const
     return m_isEmpty;
 }
 
+bool AbstractInspectorModel::isExpanded() const
+{
+    return m_isExpanded;
+}
+
 QList<Ms::ElementType> AbstractInspectorModel::supportedElementTypesBySectionType(
     const AbstractInspectorModel::InspectorSectionType sectionType)
 {
@@ -143,12 +149,16 @@ void AbstractInspectorModel::setModelType(AbstractInspectorModel::InspectorModel
 
 void AbstractInspectorModel::onPropertyValueChanged(const Ms::Pid pid, const QVariant& newValue)
 {
-    if (!hasAcceptableElements()) {
+    if (!hasAcceptableElements() || m_elementList.isEmpty()) {
         return;
     }
 
     adapter()->beginCommand();
 
+    //! NOTE Record the changes of all selected elements as one undo command
+    Ms::UndoStack* undoStack = m_elementList.first()->score()->undoStack();
+    undoStack->beginPropertyBatch();
+
     QVariant convertedValue;
 
     for (Ms::Element* element : m_elementList) {
@@ -167,6 +177,8 @@ void AbstractInspectorModel::onPropertyValueChanged(const Ms::Pid pid, const QVa
         element->undoChangeProperty(pid, convertedValue, ps);
     }
 
+    undoStack->endPropertyBatch();
+
     adapter()->updateNotation();
     adapter()->endCommand();
 
@@ -183,15 +195,48 @@ void AbstractInspectorModel::setIsEmpty(bool isEmpty)
     emit isEmptyChanged(m_isEmpty);
 }
 
+void AbstractInspectorModel::setIsExpanded(bool isExpanded)
+{
+    if (m_isExpanded == isExpanded) {
+        return;
+    }
+
+    m_isExpanded = isExpanded;
+
+    //! NOTE Nested models (e.g. the notation sub-sections) are shown inside this section
+    for (AbstractInspectorModel* childModel : findChildren<AbstractInspectorModel*>(QString(), Qt::FindDirectChildrenOnly)) {
+        childModel->setIsExpanded(isExpanded);
+    }
+
+    if (m_isExpanded && m_isPropertiesOutdated) {
+        m_isPropertiesOutdated = false;
+
+        if (!isEmpty()) {
+            loadProperties();
+        }
+    }
+
+    emit isExpandedChanged(m_isExpanded);
+}
+
 void AbstractInspectorModel::updateProperties()
 {
     requestElements();
 
     setIsEmpty(!hasAcceptableElements());
 
-    if (!isEmpty()) {
-        loadProperties();
+    if (isEmpty()) {
+        return;
+    }
+
+    //! NOTE Reading the property values of a large selection is expensive,
+    //! so collapsed sections postpone it until they are expanded
+    if (!m_isExpanded) {
+        m_isPropertiesOutdated = true;
+        return;
     }
+
+    loadProperties();
 }
 
 Ms::Sid AbstractInspectorModel::styleIdByPropertyId(const Ms::Pid pid) const
@@ -24,6 +24,7 @@ class AbstractInspectorModel : public QObject
     Q_PROPERTY(InspectorSectionType sectionType READ sectionType CONSTANT)
     Q_PROPERTY(InspectorModelType modelType READ modelType CONSTANT)
     Q_PROPERTY(bool isEmpty READ isEmpty NOTIFY isEmptyChanged)
+    Q_PROPERTY(bool isExpanded READ isExpanded WRITE setIsExpanded NOTIFY isExpandedChanged)
 
     Q_ENUMS(InspectorSectionType)
     Q_ENUMS(InspectorModelType)
@@ -89,6 +90,7 @@ public:
     InspectorModelType modelType() const;
 
     bool isEmpty() const;
+    bool isExpanded() const;
 
     static QList<Ms::ElementType> supportedElementTypesBySectionType(const InspectorSectionType sectionType);
     static InspectorSectionType sectionTypeFromElementType(const Ms::ElementType elementType);
@@ -105,11 +107,13 @@ public slots:
     void setSectionType(InspectorSectionType sectionType);
     void setModelType(InspectorModelType modelType);
     void setIsEmpty(bool isEmpty);
+    void setIsExpanded(bool isExpanded);
 
 signals:
     void elementsModified();
     void modelReseted();
     void isEmptyChanged(bool isEmpty);
+    void isExpandedChanged(bool isExpanded);
 
     void requestReloadPropertyItems();
 
@@ -143,6 +147,8 @@ private:
     InspectorSectionType m_sectionType = SECTION_UNDEFINED;
     InspectorModelType m_modelType = TYPE_UNDEFINED;
     bool m_isEmpty = false;
+    bool m_isExpanded = true;
+    bool m_isPropertiesOutdated = false;
 };
 
 #endif // ABSTRACTINSPECTORMODEL_H
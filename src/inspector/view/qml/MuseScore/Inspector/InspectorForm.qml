@@ -96,6 +96,11 @@ FocusableItem {
 
                     Component.onCompleted: {
                         title = inspectorData.title
+                        inspectorData.isExpanded = isExpanded
+                    }
+
+                    onIsExpandedChanged: {
+                        inspectorData.isExpanded = isExpanded
                     }
 
                     function updateContentHeight(newContentHeight) {
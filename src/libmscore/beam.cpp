@@ -1134,12 +1134,10 @@ static void initBeamMetrics()
 
 static Bm beamMetric1(bool up, char l1, char l2)
 {
-    static int initialized = false;
-    if (!initialized) {
-        initBeamMetrics();
-        initialized = true;
-    }
-    return bMetrics[Bm::key(up, l1, l2)];
+    // parts may be laid out on several threads, see Excerpt::createExcerpts()
+    static const bool initialized = (initBeamMetrics(), true);
+    Q_UNUSED(initialized);
+    return bMetrics.value(Bm::key(up, l1, l2));
 }
 
 //---------------------------------------------------------
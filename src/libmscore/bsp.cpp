@@ -118,7 +118,7 @@ void BspTree::insert(Element* element)
 {
     InsertItemBspTreeVisitor insertVisitor;
     insertVisitor.item = element;
-    climbTree(&insertVisitor, element->pageBoundingRect());
+    climbTree(&insertVisitor, element->pageBoundingRect().translated(-_origin));
 }
 
 //---------------------------------------------------------
@@ -129,7 +129,7 @@ void BspTree::remove(Element* element)
 {
     RemoveItemBspTreeVisitor removeVisitor;
     removeVisitor.item = element;
-    climbTree(&removeVisitor, element->pageBoundingRect());
+    climbTree(&removeVisitor, element->pageBoundingRect().translated(-_origin));
 }
 
 //---------------------------------------------------------
@@ -139,7 +139,7 @@ void BspTree::remove(Element* element)
 QList<Element*> BspTree::items(const QRectF& rec)
 {
     FindItemBspTreeVisitor findVisitor;
-    climbTree(&findVisitor, rec);
+    climbTree(&findVisitor, rec.translated(-_origin));
     QList<Element*> l;
     for (Element* e : findVisitor.foundItems) {
         e->itemDiscovered = false;
@@ -157,7 +157,7 @@ QList<Element*> BspTree::items(const QRectF& rec)
 QList<Element*> BspTree::items(const QPointF& pos)
 {
     FindItemBspTreeVisitor findVisitor;
-    climbTree(&findVisitor, pos);
+    climbTree(&findVisitor, pos - _origin);
 
     QList<Element*> l;
     for (Element* e : findVisitor.foundItems) {
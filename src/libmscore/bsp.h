@@ -60,6 +60,7 @@ private:
     QVector<QList<Element*> > leaves;
     int leafCnt;
     QRectF rect;
+    QPointF _origin;        // page position of the tree coordinate system
 
 public:
     BspTree();
@@ -70,6 +71,9 @@ public:
     void insert(Element* item);
     void remove(Element* item);
 
+    const QPointF& origin() const { return _origin; }
+    void setOrigin(const QPointF& p) { _origin = p; }
+
     QList<Element*> items(const QRectF& rect);
     QList<Element*> items(const QPointF& pos);
 
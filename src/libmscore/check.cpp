@@ -24,6 +24,10 @@
 #include "staff.h"
 #include "keysig.h"
 #include "clef.h"
+#include "chord.h"
+#include "note.h"
+#include "tie.h"
+#include "noteevent.h"
 #include "utils.h"
 
 namespace Ms {
@@ -330,6 +334,94 @@ bool Score::checkClefs()
     return rc;
 }
 
+//---------------------------------------------------------
+//   checkTies
+///    check that the range-scoped connectTies() passes
+///    left the ties and note spanners as a full pass over
+///    the score does. The full pass is run, so the score
+///    is correct afterwards either way.
+//---------------------------------------------------------
+
+bool Score::checkTies()
+{
+    struct Connections {
+        Note* note;
+        Note* tieEnd;
+        int spannerFor;
+        int spannerBack;
+    };
+    auto connections = [this]() {
+        std::vector<Connections> c;
+        int tracks = nstaves() * VOICES;
+        SegmentType st = SegmentType::ChordRest;
+        for (Segment* s = firstSegment(st); s; s = s->next1(st)) {
+            for (int i = 0; i < tracks; ++i) {
+                Element* e = s->element(i);
+                if (!e || !e->isChord()) {
+                    continue;
+                }
+                for (Note* n : toChord(e)->notes()) {
+                    Tie* tie = n->tieFor();
+                    c.push_back({ n, tie ? tie->endNote() : nullptr, n->spannerFor().size(), n->spannerBack().size() });
+                }
+            }
+        }
+        return c;
+    };
+
+    std::vector<Connections> scoped = connections();
+    connectTies(true);
+    std::vector<Connections> full = connections();
+    if (scoped.size() != full.size()) {
+        qWarning("%d notes after a full connectTies(), %d before", int(full.size()), int(scoped.size()));
+        return false;
+    }
+    bool rc = true;
+    for (size_t i = 0; i < full.size(); ++i) {
+        const Connections& a = scoped[i];
+        const Connections& b = full[i];
+        if (a.tieEnd != b.tieEnd || a.spannerFor != b.spannerFor || a.spannerBack != b.spannerBack) {
+            qWarning("tick %d track %d: ties or spanners not connected", b.note->tick().ticks(), b.note->track());
+            rc = false;
+        }
+    }
+    return rc;
+}
+
+//---------------------------------------------------------
+//   checkPlayEvents
+///    check that the play events kept as up to date by
+///    createPlayEvents() match the ones of a full pass
+//---------------------------------------------------------
+
+bool Score::checkPlayEvents()
+{
+    bool rc = true;
+    int tracks = nstaves() * VOICES;
+    for (Measure* m = firstMeasure(); m && m->endTick() <= _playEventsValidTo; m = m->nextMeasure()) {
+        for (Segment* s = m->first(SegmentType::ChordRest); s; s = s->next(SegmentType::ChordRest)) {
+            for (int i = 0; i < tracks; ++i) {
+                Element* e = s->element(i);
+                if (!e || !e->isChord() || !staff(i / VOICES)->primaryStaff()) {
+                    continue;
+                }
+                Chord* c = toChord(e);
+                if (c->playEventType() != PlayEventType::Auto) {
+                    continue;
+                }
+                QList<NoteEventList> el = defaultPlayEvents(c);
+                for (size_t k = 0; k < c->notes().size() && int(k) < el.size(); ++k) {
+                    if (c->notes()[k]->playEvents() != el[int(k)]) {
+                        qWarning("tick %d track %d: play events out of date", s->tick().ticks(), i);
+                        rc = false;
+                    }
+                }
+            }
+        }
+    }
+    return rc;
+}
+
 //---------------------------------------------------------
 //   fillGap
 //---------------------------------------------------------
@@ -92,6 +92,7 @@ public:
     Chord(Score* s = 0);
     Chord(const Chord&, bool link = false);
     ~Chord();
+    MS_POOLED_ELEMENT(Chord)
     Chord& operator=(const Chord&) = delete;
 
     // Score Tree functions
@@ -1618,12 +1618,16 @@ void ChordDescription::complete(ParsedChord* pc, const ChordList* cl)
     ParsedChord tempPc;
     if (!pc) {
         // generate parsed chord for its rendering & semantic (xml) info
-        pc = &tempPc;
         QString n;
         if (!names.empty()) {
             n = names.front();
         }
-        pc->parse(n, cl);
+        if (cl) {
+            tempPc = cl->parse(n);
+        } else {
+            tempPc.parse(n, cl);
+        }
+        pc = &tempPc;
     }
     parsedChords.append(*pc);
     if (renderList.empty() || renderListGenerated) {
@@ -1716,6 +1720,7 @@ void ChordList::configureAutoAdjust(qreal emag, qreal eadjust, qreal mmag, qreal
     _eadjust = eadjust;
     _mmag = mmag;
     _madjust = madjust;
+    _parseCache.clear();
 #if 0
     // TODO: regenerate all chord descriptions
     // currently we always reload the entire chordlist
@@ -1739,6 +1744,7 @@ void ChordList::read(XmlReader& e)
 {
     int fontIdx = 0;
     _autoAdjust = false;
+    _parseCache.clear();
     while (e.readNextStartElement()) {
         const QStringRef& tag(e.name());
         if (tag == "font") {
@@ -1804,10 +1810,12 @@ void ChordList::read(XmlReader& e)
             QString nadjust = e.attribute("adjust");
             _nadjust = nadjust.toDouble();
             _autoAdjust = e.readBool();
+            _parseCache.clear();
         } else if (tag == "token") {
             ChordToken t;
             t.read(e);
             chordTokenList.append(t);
+            _parseCache.clear();
         } else if (tag == "chord") {
             int id = e.intAttribute("id");
             // if no id attribute (id == 0), then assign it a private id
@@ -1839,6 +1847,128 @@ void ChordList::read(XmlReader& e)
     }
 }
 
+//---------------------------------------------------------
+//   insert
+//    a generated description has a lower id than all
+//    others, so it is added to valid indexes directly
+//---------------------------------------------------------
+
+ChordList::iterator ChordList::insert(int id, const ChordDescription& cd)
+{
+    if (_indexed && (isEmpty() || id < firstKey())) {
+        for (const QString& name : cd.names) {
+            _nameIndex.insert(name, id);
+        }
+        if (!cd.names.empty()) {
+            for (const ParsedChord& pc : cd.parsedChords) {
+                if (!_parsedIndex.contains(pc.handle())) {
+                    _parsedIndex.insert(pc.handle(), id);
+                }
+            }
+        }
+    } else {
+        _indexed = false;
+    }
+    return QMap<int, ChordDescription>::insert(id, cd);
+}
+
+//---------------------------------------------------------
+//   take
+//---------------------------------------------------------
+
+ChordDescription ChordList::take(int id)
+{
+    _indexed = false;
+    return QMap<int, ChordDescription>::take(id);
+}
+
+//---------------------------------------------------------
+//   clear
+//---------------------------------------------------------
+
+void ChordList::clear()
+{
+    QMap<int, ChordDescription>::clear();
+    _nameIndex.clear();
+    _parsedIndex.clear();
+    _indexed = true;
+    _parseCache.clear();
+}
+
+//---------------------------------------------------------
+//   buildIndex
+//    the same matches as a search of the descriptions in
+//    id order: the first one for a name, the last one for
+//    a parsed chord
+//---------------------------------------------------------
+
+void ChordList::buildIndex() const
+{
+    _nameIndex.clear();
+    _parsedIndex.clear();
+    for (const ChordDescription& cd : *this) {
+        if (cd.names.empty()) {
+            continue;
+        }
+        for (const QString& name : cd.names) {
+            if (!_nameIndex.contains(name)) {
+                _nameIndex.insert(name, cd.id);
+            }
+        }
+        for (const ParsedChord& pc : cd.parsedChords) {
+            _parsedIndex.insert(pc.handle(), cd.id);
+        }
+    }
+    _indexed = true;
+}
+
+//---------------------------------------------------------
+//   description
+//    look up name, optionally fall back on the parsed
+//    chord pc; return null if not found
+//---------------------------------------------------------
+
+const ChordDescription* ChordList::description(const QString& name, const ParsedChord* pc) const
+{
+    if (!_indexed) {
+        buildIndex();
+    }
+    auto i = _nameIndex.constFind(name);
+    if (i == _nameIndex.constEnd() && pc) {
+        i = _parsedIndex.constFind(pc->handle());
+        if (i == _parsedIndex.constEnd()) {
+            return 0;
+        }
+    } else if (i == _nameIndex.constEnd()) {
+        return 0;
+    }
+    auto cd = constFind(i.value());
+    return cd == constEnd() ? 0 : &*cd;
+}
+
+//---------------------------------------------------------
+//   parse
+//    same as ParsedChord::parse() with this list; the
+//    result also depends on the tokens and autoAdjust of
+//    the list, so the cache is cleared when they change
+//---------------------------------------------------------
+
+ParsedChord ChordList::parse(const QString& s, bool syntaxOnly, bool preferMinor) const
+{
+    const QString key = QString("%1%2|").arg(int(syntaxOnly)).arg(int(preferMinor)) + s;
+    auto i = _parseCache.constFind(key);
+    if (i != _parseCache.constEnd()) {
+        return i.value();
+    }
+    if (_parseCache.size() >= 4096) {
+        _parseCache.clear();
+    }
+    ParsedChord pc;
+    pc.parse(s, this, syntaxOnly, preferMinor);
+    _parseCache.insert(key, pc);
+    return pc;
+}
+
 //---------------------------------------------------------
 //   write
 //---------------------------------------------------------
@@ -13,6 +13,7 @@
 #ifndef __CHORDLIST_H__
 #define __CHORDLIST_H__
 
+#include <QHash>
 #include <QMap>
 
 namespace Ms {
@@ -239,6 +240,13 @@ struct ChordFont {
 
 //---------------------------------------------------------
 //   ChordList
+//    the chord descriptions by id.
+//
+//    Descriptions are looked up by name or parsed form
+//    through indexes which are built on the first lookup
+//    after the list changed; insert(), take() and clear()
+//    must be used to change the list. Parsed chords are
+//    cached by text and options.
 //---------------------------------------------------------
 
 class ChordList : public QMap<int, ChordDescription>
@@ -249,6 +257,13 @@ class ChordList : public QMap<int, ChordDescription>
     qreal _emag = 1.0, _eadjust = 0.0;
     qreal _mmag = 1.0, _madjust = 0.0;
 
+    mutable QHash<QString, int> _nameIndex;       // name -> id of the first description with the name
+    mutable QHash<QString, int> _parsedIndex;     // ParsedChord::handle() -> id of the last description with it
+    mutable bool _indexed = false;
+    mutable QHash<QString, ParsedChord> _parseCache;
+
+    void buildIndex() const;
+
 public:
     QList<ChordFont> fonts;
     QList<RenderAction> renderListRoot;
@@ -270,6 +285,12 @@ public:
     bool loaded() const;
     void unload();
     ChordSymbol symbol(const QString& s) const { return symbols.value(s); }
+
+    iterator insert(int id, const ChordDescription& cd);
+    ChordDescription take(int id);
+    void clear();
+    const ChordDescription* description(const QString& name, const ParsedChord* pc = 0) const;
+    ParsedChord parse(const QString& s, bool syntaxOnly = false, bool preferMinor = false) const;
 };
 }     // namespace Ms
 #endif
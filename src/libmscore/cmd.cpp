@@ -54,6 +54,7 @@
 #include "articulation.h"
 #include "layoutbreak.h"
 #include "drumset.h"
+#include "excerpt.h"
 #include "beam.h"
 #include "lyrics.h"
 #include "pitchspelling.h"
@@ -75,6 +76,7 @@
 #include "tremolo.h"
 #include "rehearsalmark.h"
 #include "sym.h"
+#include "measurewritecache.h"
 
 namespace Ms {
 //---------------------------------------------------------
@@ -212,6 +214,114 @@ void CmdState::setUpdateMode(UpdateMode m)
     }
 }
 
+//---------------------------------------------------------
+//   changedRange
+//    the tick range to invalidate in a cache which has
+//    seen the undo stack at seenChanges changes; it is
+//    set to changes. A change made without a layout range
+//    does not tell where it happened and yields the whole
+//    score (0, -1). Return false if nothing changed.
+//---------------------------------------------------------
+
+bool CmdState::changedRange(int changes, int& seenChanges, Fraction& stick, Fraction& etick) const
+{
+    const bool changed = changes != seenChanges;
+    seenChanges = changes;
+    if (layoutRange()) {
+        stick = _startTick;
+        etick = _endTick;
+        return true;
+    }
+    if (changed) {
+        stick = Fraction(0, 1);
+        etick = Fraction(-1, 1);
+        return true;
+    }
+    return false;
+}
+
+//---------------------------------------------------------
+//   isStaffLocal
+//    true if an edit of e changes only the staff of e
+//    and the staves linked to it
+//---------------------------------------------------------
+
+static bool isStaffLocal(const Element* e)
+{
+    if (e->systemFlag() || e->staffIdx() < 0) {
+        return false;
+    }
+    switch (e->type()) {
+    case ElementType::NOTE:
+    case ElementType::REST:
+    case ElementType::CHORD:
+    case ElementType::ACCIDENTAL:
+    case ElementType::ARTICULATION:
+    case ElementType::LYRICS:
+    case ElementType::FINGERING:
+    case ElementType::DYNAMIC:
+    case ElementType::HARMONY:
+    case ElementType::STAFF_TEXT:
+    case ElementType::NOTEDOT:
+    case ElementType::STEM:
+    case ElementType::HOOK:
+    case ElementType::SLUR_SEGMENT:
+    case ElementType::TIE_SEGMENT:
+    case ElementType::HAIRPIN_SEGMENT:
+    case ElementType::GLISSANDO_SEGMENT:
+    case ElementType::FRET_DIAGRAM:
+    case ElementType::BREATH:
+    case ElementType::TREMOLO:
+    case ElementType::ARPEGGIO:
+    case ElementType::CHORDLINE:
+    case ElementType::BEND:
+        return true;
+    default:
+        return false;
+    }
+}
+
+//---------------------------------------------------------
+//   excerptsToEdit
+//    the excerpts whose part scores an edit of the input
+//    state or selection of score may change: the ones
+//    with a part of an edited staff, or all of them
+//---------------------------------------------------------
+
+static QList<Excerpt*> excerptsToEdit(Score* score)
+{
+    const QList<Excerpt*>& excerpts = score->masterScore()->excerpts();
+    if (!score->isMaster() || score->selection().isRange()) {
+        return excerpts;
+    }
+
+    QSet<int> staves;
+    if (score->noteEntryMode() && score->inputState().track() >= 0) {
+        staves.insert(score->inputState().track() / VOICES);
+    }
+    for (const Element* e : score->selection().elements()) {
+        if (!isStaffLocal(e)) {
+            return excerpts;
+        }
+        staves.insert(e->staffIdx());
+    }
+    if (staves.isEmpty()) {
+        return excerpts;
+    }
+
+    QList<Excerpt*> edited;
+    for (Excerpt* ex : excerpts) {
+        for (int staffIdx : staves) {
+            Staff* st = score->staff(staffIdx);
+            if (st && ex->parts().contains(st->part())) {
+                edited.append(ex);
+                break;
+            }
+        }
+    }
+    return edited;
+}
+
 //---------------------------------------------------------
 //   startCmd
 ///   Start a GUI command by clearing the redraw area
@@ -232,6 +342,10 @@ void Score::startCmd()
         qDebug("Score::startCmd(): cmd already active");
         return;
     }
+    // read the part scores whose linked elements the edit may change;
+    // edits of measures or system elements read the others when they
+    // need them
+    Excerpt::readPartScores(excerptsToEdit(this));
     undoStack()->beginMacro(this);
 }
 
@@ -317,9 +431,20 @@ void Score::update(bool resetCmdState)
     for (MasterScore* ms : *movements()) {
         CmdState& cs = ms->cmdState();
         ms->deletePostponed();
+        for (Score* s : ms->scoreList()) {
+            if (MeasureWriteCache* cache = s->measureWriteCache()) {
+                cache->invalidate(s, cs);
+            }
+            s->invalidatePlayEvents(cs);
+            s->invalidateMeasureLayouts(cs);
+        }
         if (cs.layoutRange()) {
             for (Score* s : ms->scoreList()) {
                 s->doLayoutRange(cs.startTick(), cs.endTick());
+                if (MScore::debugMode) {
+                    s->checkTies();
+                    s->checkPlayEvents();
+                }
             }
             updateAll = true;
         }
@@ -863,7 +988,7 @@ Segment* Score::setNoteRest(Segment* segment, int track, NoteVal nval, Fraction
         }
     }
     if (tie) {
-        connectTies();
+        connectTies(cmdState().startTick(), cmdState().endTick());
     }
     if (nr) {
         if (is.slur() && nr->type() == ElementType::NOTE) {
@@ -1464,7 +1589,7 @@ void Score::changeCRlen(ChordRest* cr, const Fraction& dstF, bool fillWithRest)
         expandVoice(s, track);
         cr1 = toChordRest(s->element(track));
     }
-    connectTies();
+    connectTies(cmdState().startTick(), cmdState().endTick());
 }
 
 //---------------------------------------------------------
@@ -3644,7 +3769,7 @@ Segment* Score::setChord(Segment* segment, int track, Chord* chordTemplate, Frac
         }
     }
     if (!tie.empty()) {
-        connectTies();
+        connectTies(cmdState().startTick(), cmdState().endTick());
     }
     if (nr) {
         select(nr, SelectType::SINGLE, 0);
@@ -4295,7 +4420,7 @@ void Score::cmdToggleVisible()
         if (e->isBracket()) {       // ignore
             continue;
         }
-        if (e->isNoteDot() && selection().elements().contains(e->parent())) {
+        if (e->isNoteDot() && selection().contains(e->parent())) {
             // already handled in ScoreElement::undoChangeProperty(); don't toggle twice
             continue;
         }
@@ -0,0 +1,68 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include "concurrent.h"
+
+#include <atomic>
+#include <memory>
+
+#include <QSemaphore>
+#include <QThreadPool>
+
+namespace Ms {
+//---------------------------------------------------------
+//   forEachConcurrently
+//    call f(i) for 0 <= i < n on up to threads threads.
+//    The calling thread takes part; the other threads are
+//    borrowed from the global thread pool, so fan-outs on
+//    pool threads or on several threads at once do not
+//    start more threads than the pool has. Items no pool
+//    thread got to run on the calling thread; a task which
+//    starts after all items are taken returns at once.
+//---------------------------------------------------------
+
+void forEachConcurrently(int n, int threads, const std::function<void(int)>& f)
+{
+    threads = qMin(n, threads);
+    if (threads < 2) {
+        for (int i = 0; i < n; ++i) {
+            f(i);
+        }
+        return;
+    }
+
+    struct State {
+        std::atomic<int> next { 0 };
+        std::atomic<int> done { 0 };
+        QSemaphore finished;
+        int n;
+        const std::function<void(int)>* f;
+    };
+    std::shared_ptr<State> state = std::make_shared<State>();
+    state->n = n;
+    state->f = &f;
+
+    auto work = [state]() {
+        for (int i = state->next++; i < state->n; i = state->next++) {
+            (*state->f)(i);
+            if (++state->done == state->n) {
+                state->finished.release();
+            }
+        }
+    };
+    for (int i = 1; i < threads; ++i) {
+        QThreadPool::globalInstance()->start(work);
+    }
+    work();
+    state->finished.acquire();
+}
+}
@@ -0,0 +1,21 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __CONCURRENT_H__
+#define __CONCURRENT_H__
+
+#include <functional>
+
+namespace Ms {
+extern void forEachConcurrently(int n, int threads, const std::function<void(int)>& f);
+}     // namespace Ms
+#endif
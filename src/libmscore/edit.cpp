@@ -634,7 +634,7 @@ bool Score::rewriteMeasures(Measure* fm, Measure* lm, const Fraction& ns, int st
     if (!range.write(masterScore(), fm->tick())) {
         return false;
     }
-    connectTies(true);
+    connectTies(fm->tick(), fm->tick() + range.ticks(), true);
 
     // Attempt to move tremolos to correct chords
     for (auto tremPair : tremoloChordTicks) {
@@ -821,6 +821,9 @@ bool Score::rewriteMeasures(Measure* fm, const Fraction& ns, int staffIdx)
 
 void Score::cmdAddTimeSig(Measure* fm, int staffIdx, TimeSig* ts, bool local)
 {
+    // the measures of every part score change
+    Excerpt::readPartScores(excerpts());
+
     deselectAll();
 
     if (fm->isMMRest()) {
@@ -1009,6 +1012,9 @@ void Score::cmdRemoveTimeSig(TimeSig* ts)
         return;
     }
 
+    // the measures of every part score change
+    Excerpt::readPartScores(excerpts());
+
     Measure* m = ts->measure();
     Segment* s = ts->segment();
 
@@ -1321,7 +1327,7 @@ void Score::regroupNotesAndRests(const Fraction& startTick, const Fraction& endT
                         }
                     }
                     if (tie) {         // at least one tie was created
-                        connectTies();
+                        connectTies(startTick, endTick);
                     }
                 }
             }
@@ -2351,6 +2357,9 @@ void Score::deleteMeasures(MeasureBase* mbStart, MeasureBase* mbEnd, bool preser
 {
 // qDebug("deleteMeasures %p %p", is, ie);
 
+    // the measures of every part score change
+    Excerpt::readPartScores(excerpts());
+
 #if 0
     if (!selection().isRange()) {
         return;
@@ -3261,6 +3270,9 @@ void Score::nextInputPos(ChordRest* cr, bool doSelect)
 
 void Score::insertMeasure(ElementType type, MeasureBase* measure, bool createEmptyMeasures, bool moveSignaturesClef, bool needDeselectAll)
 {
+    // the measures of every part score change
+    Excerpt::readPartScores(excerpts());
+
     Fraction tick;
     if (measure) {
         if (measure->isMeasure()) {
@@ -3725,6 +3737,9 @@ void Score::timeDelete(Measure* m, Segment* startSegment, const Fraction& f)
         return;
     }
 
+    // the measures of every part score change
+    Excerpt::readPartScores(excerpts());
+
     const Fraction tick  = startSegment->rtick();
     const Fraction len   = f;
     const Fraction etick = tick + len;
@@ -4777,13 +4792,17 @@ void Score::undoAddElement(Element* element)
     // linking:
     //
 
-    if ((et == ElementType::REHEARSAL_MARK)
-        || (et == ElementType::SYSTEM_TEXT)
-        || (et == ElementType::JUMP)
-        || (et == ElementType::MARKER)
-        || (et == ElementType::TEMPO_TEXT)
-        || (et == ElementType::VOLTA)
-        ) {
+    const bool replicated = (et == ElementType::REHEARSAL_MARK)
+                            || (et == ElementType::SYSTEM_TEXT)
+                            || (et == ElementType::JUMP)
+                            || (et == ElementType::MARKER)
+                            || (et == ElementType::TEMPO_TEXT)
+                            || (et == ElementType::VOLTA);
+    if (replicated || element->systemFlag()) {
+        Excerpt::readPartScores(excerpts());
+    }
+
+    if (replicated) {
         for (Score* s : scoreList()) {
             staffList.append(s->staff(0));
         }
@@ -49,6 +49,7 @@
 #include "jump.h"
 #include "keysig.h"
 #include "layoutbreak.h"
+#include "linkstage.h"
 #include "lyrics.h"
 #include "marker.h"
 #include "measure.h"
@@ -686,9 +687,13 @@ bool Element::readProperties(XmlReader& e)
             }
         }
         if (tag == "linkedMain") {
-            _links = new LinkedElements(score());
-            _links->push_back(this);
-            e.addLink(s, _links);
+            if (LinkStage* stage = LinkStage::current()) {
+                e.addLink(s, stage->linkedElements(this));     // the list is created by LinkStage::merge()
+            } else {
+                _links = new LinkedElements(score());
+                _links->push_back(this);
+                e.addLink(s, _links);
+            }
             e.readNext();
         } else {
             Staff* ls = s->links() ? toStaff(s->links()->mainElement()) : nullptr;
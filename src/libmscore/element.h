@@ -14,6 +14,7 @@
 #define __ELEMENT_H__
 
 #include "elementgroup.h"
+#include "elementpool.h"
 #include "spatium.h"
 #include "fraction.h"
 #include "scoreElement.h"
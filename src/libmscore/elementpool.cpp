@@ -0,0 +1,156 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include "elementpool.h"
+
+#include <QtGlobal>
+
+namespace Ms {
+//---------------------------------------------------------
+//   slotSize
+//    round up so that every slot is suitably aligned
+//---------------------------------------------------------
+
+static size_t slotSize(size_t objectSize)
+{
+    const size_t align = alignof(std::max_align_t);
+    size_t size = qMax(objectSize, sizeof(void*));
+    return (size + align - 1) / align * align;
+}
+
+//---------------------------------------------------------
+//   ElementPool
+//---------------------------------------------------------
+
+ElementPool::ElementPool(const char* name, size_t objectSize, size_t chunkObjects)
+    : _name(name), _slotSize(slotSize(objectSize)), _objectSize(objectSize), _chunkObjects(chunkObjects)
+{
+    _stats.name       = name;
+    _stats.objectSize = objectSize;
+    std::lock_guard<std::mutex> lock(registryMutex());
+    registry().push_back(this);
+}
+
+//---------------------------------------------------------
+//   registry
+//---------------------------------------------------------
+
+std::mutex& ElementPool::registryMutex()
+{
+    static std::mutex* m = new std::mutex;
+    return *m;
+}
+
+std::vector<ElementPool*>& ElementPool::registry()
+{
+    static std::vector<ElementPool*>* r = new std::vector<ElementPool*>;
+    return *r;
+}
+
+//---------------------------------------------------------
+//   grow
+//    add a chunk of free slots to the free list;
+//    called with _mutex held
+//---------------------------------------------------------
+
+void ElementPool::grow()
+{
+    char* chunk = static_cast<char*>(::operator new(_slotSize * _chunkObjects));
+    _chunks.push_back(chunk);
+    for (size_t i = _chunkObjects; i > 0; --i) {
+        void* slot = chunk + (i - 1) * _slotSize;
+        *static_cast<void**>(slot) = _freeList;
+        _freeList = slot;
+    }
+    _stats.capacity += _chunkObjects;
+}
+
+//---------------------------------------------------------
+//   allocate
+//---------------------------------------------------------
+
+void* ElementPool::allocate(size_t size)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (size != _objectSize) {
+        ++_stats.fallbacks;
+        return ::operator new(size);
+    }
+    if (!_freeList) {
+        grow();
+    }
+    void* p = _freeList;
+    _freeList = *static_cast<void**>(p);
+    ++_stats.allocations;
+    if (++_stats.live > _stats.peak) {
+        _stats.peak = _stats.live;
+    }
+    return p;
+}
+
+//---------------------------------------------------------
+//   deallocate
+//---------------------------------------------------------
+
+void ElementPool::deallocate(void* p, size_t size)
+{
+    if (!p) {
+        return;
+    }
+    if (size != _objectSize) {
+        ::operator delete(p);
+        return;
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    *static_cast<void**>(p) = _freeList;
+    _freeList = p;
+    ++_stats.deallocations;
+    --_stats.live;
+}
+
+//---------------------------------------------------------
+//   statistics
+//---------------------------------------------------------
+
+ElementPoolStatistics ElementPool::statistics() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _stats;
+}
+
+//---------------------------------------------------------
+//   allStatistics
+//---------------------------------------------------------
+
+std::vector<ElementPoolStatistics> ElementPool::allStatistics()
+{
+    std::vector<ElementPoolStatistics> sl;
+    std::lock_guard<std::mutex> lock(registryMutex());
+    for (const ElementPool* p : registry()) {
+        sl.push_back(p->statistics());
+    }
+    return sl;
+}
+
+//---------------------------------------------------------
+//   dumpStatistics
+//---------------------------------------------------------
+
+void ElementPool::dumpStatistics()
+{
+    qDebug("ElementPool statistics:");
+    for (const ElementPoolStatistics& s : allStatistics()) {
+        qDebug("   %-12s size %4zu allocs %8zu frees %8zu live %7zu peak %7zu capacity %7zu heap %6zu",
+               s.name, s.objectSize, s.allocations, s.deallocations, s.live, s.peak, s.capacity, s.fallbacks);
+    }
+}
+}     // namespace Ms
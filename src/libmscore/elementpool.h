@@ -0,0 +1,110 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __ELEMENTPOOL_H__
+#define __ELEMENTPOOL_H__
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace Ms {
+//---------------------------------------------------------
+//   ElementPoolStatistics
+//---------------------------------------------------------
+
+struct ElementPoolStatistics {
+    const char* name       { nullptr };
+    size_t objectSize      { 0 };
+    size_t allocations     { 0 };     ///< total number of objects served by the pool
+    size_t deallocations   { 0 };
+    size_t live            { 0 };     ///< objects currently in use
+    size_t peak            { 0 };     ///< maximum of live objects
+    size_t capacity        { 0 };     ///< number of object slots in all chunks
+    size_t fallbacks       { 0 };     ///< allocations of derived classes passed to the global heap
+};
+
+//---------------------------------------------------------
+//   ElementPool
+//    type segregated free list allocator for the most
+//    frequently created score elements (Note, Chord,
+//    Segment...).
+//    Memory is requested from the global heap in chunks
+//    and never returned; freed slots are reused by the
+//    next allocation of the same type. This turns the
+//    hundreds of thousands of small allocations done while
+//    loading, cloning parts and closing a score into a few
+//    large ones and keeps the heap of long running
+//    processes from fragmenting.
+//
+//    A class opts in with the MS_POOLED_ELEMENT macro.
+//    Allocations with a size different from the pooled
+//    type (derived classes) go to the global heap.
+//---------------------------------------------------------
+
+class ElementPool
+{
+    const char* _name;
+    const size_t _slotSize;
+    const size_t _objectSize;
+    const size_t _chunkObjects;
+
+    mutable std::mutex _mutex;
+    void* _freeList { nullptr };
+    std::vector<void*> _chunks;
+    ElementPoolStatistics _stats;
+
+    void grow();
+
+    static std::mutex& registryMutex();
+    static std::vector<ElementPool*>& registry();
+
+public:
+    ElementPool(const char* name, size_t objectSize, size_t chunkObjects = 256);
+    ElementPool(const ElementPool&) = delete;
+    ElementPool& operator=(const ElementPool&) = delete;
+
+    void* allocate(size_t size);
+    void deallocate(void* p, size_t size);
+
+    const char* name() const { return _name; }
+    ElementPoolStatistics statistics() const;
+
+    static std::vector<ElementPoolStatistics> allStatistics();
+    static void dumpStatistics();
+
+    //---------------------------------------------------
+    //   pool
+    //    The pools are intentionally leaked: elements
+    //    owned by static objects may be destroyed after
+    //    any function local static.
+    //---------------------------------------------------
+
+    template<class T>
+    static ElementPool& pool(const char* name)
+    {
+        static ElementPool* p = new ElementPool(name, sizeof(T));
+        return *p;
+    }
+};
+
+//---------------------------------------------------------
+//   MS_POOLED_ELEMENT
+//    to be placed in the public section of the class
+//---------------------------------------------------------
+
+#define MS_POOLED_ELEMENT(T) \
+    static void* operator new(size_t size) { return Ms::ElementPool::pool<T>(#T).allocate(size); } \
+    static void operator delete(void* p, size_t size) { Ms::ElementPool::pool<T>(#T).deallocate(p, size); }
+}     // namespace Ms
+
+#endif
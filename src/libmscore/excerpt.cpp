@@ -10,6 +10,10 @@
 //  the file LICENCE.GPL
 //=============================================================================
 
+#include <thread>
+
+#include <QFontDatabase>
+
 #include "excerpt.h"
 #include "score.h"
 #include "part.h"
@@ -42,6 +46,10 @@
 #include "barline.h"
 #include "undo.h"
 #include "bracketItem.h"
+#include "linkstage.h"
+#include "sym.h"
+#include "concurrent.h"
+#include "imageStore.h"
 
 namespace Ms {
 //---------------------------------------------------------
@@ -51,7 +59,18 @@ namespace Ms {
 Excerpt::Excerpt(const Excerpt& ex, bool copyPartScore)
     : QObject(), _oscore(ex._oscore), _title(ex._title), _parts(ex._parts), _tracks(ex._tracks)
 {
-    _partScore = (copyPartScore && ex._partScore) ? ex._partScore->clone() : nullptr;
+    if (!copyPartScore || !ex._partScore) {
+        _partScore = nullptr;
+    } else if (ex.isPartScoreRead()) {
+        _partScore = ex._partScore->clone();
+    } else {
+        // the copy reads the part score from the same data
+        _partScore   = new Score(_oscore, MScore::baseStyle());
+        _partData    = ex._partData;
+        _partLine    = ex._partLine;
+        _docName     = ex._docName;
+        _masterLinks = ex._masterLinks;
+    }
 
     if (_partScore) {
         _partScore->setExcerpt(this);
@@ -74,7 +93,7 @@ Excerpt::~Excerpt()
 int Excerpt::nstaves() const
 {
     int n { 0 };
-    for (Part* p : _parts) {
+    for (Part* p : parts()) {
         n += p->nstaves();
     }
     return n;
@@ -108,6 +127,51 @@ void Excerpt::read(XmlReader& e)
     }
 }
 
+//---------------------------------------------------------
+//   setPartData
+//    keep the <Score> element of the part score at the
+//    given line of a file, to be read by readPartScores();
+//    e is the reader of the master score, see
+//    MScore::lazyExcerpts. The parts of the excerpt are
+//    taken from the <linkedTo> tags of its staves.
+//---------------------------------------------------------
+
+void Excerpt::setPartData(XmlReader& e, const QByteArray& data, qint64 line)
+{
+    _partData    = data;
+    _partLine    = line;
+    _docName     = e.getDocName();
+    _masterLinks = e.staffLinkedElements();
+
+    _parts.clear();
+    XmlReader r(data);
+    r.readNextStartElement();         // <Score>
+    while (r.readNextStartElement()) {
+        if (r.name() == "Staff") {     // the staves of a part come first
+            break;
+        } else if (r.name() != "Part") {
+            r.skipCurrentElement();
+            continue;
+        }
+        while (r.readNextStartElement()) {
+            if (r.name() != "Staff") {
+                r.skipCurrentElement();
+                continue;
+            }
+            while (r.readNextStartElement()) {
+                if (r.name() != "linkedTo") {
+                    r.skipCurrentElement();
+                    continue;
+                }
+                Staff* st = _oscore->staff(r.readInt() - 1);
+                if (st && !_parts.contains(st->part())) {
+                    _parts.append(st->part());
+                }
+            }
+        }
+    }
+}
+
 //---------------------------------------------------------
 //   operator!=
 //---------------------------------------------------------
@@ -151,10 +215,13 @@ bool Excerpt::operator==(const Excerpt& e) const
 }
 
 //---------------------------------------------------------
-//   createExcerpt
+//   initPartScore
+//    create layers, parts and linked staves of the part
+//    score and fill the track list; return the indices of
+//    the source staves
 //---------------------------------------------------------
 
-void Excerpt::createExcerpt(Excerpt* excerpt)
+QList<int> Excerpt::initPartScore(Excerpt* excerpt)
 {
     MasterScore* oscore = excerpt->oscore();
     Score* score        = excerpt->partScore();
@@ -220,20 +287,23 @@ void Excerpt::createExcerpt(Excerpt* excerpt)
         }
         excerpt->setTracks(tracks);
     }
+    return srcStaves;
+}
 
-    cloneStaves(oscore, score, srcStaves, excerpt->tracks());
+//---------------------------------------------------------
+//   layoutPartScore
+//    title frame, first layout and transposition of the
+//    cloned part score
+//---------------------------------------------------------
 
-    // create excerpt title and title frame for all scores if not already there
-    MeasureBase* measure = oscore->first();
+void Excerpt::layoutPartScore(Excerpt* excerpt)
+{
+    MasterScore* oscore = excerpt->oscore();
+    Score* score        = excerpt->partScore();
 
-    if (!measure || !measure->isVBox()) {
-        qDebug("original score has no header frame");
-        oscore->insertMeasure(ElementType::VBOX, measure);
-        measure = oscore->first();
-    }
-    VBox* titleFrameScore = toVBox(measure);
+    VBox* titleFrameScore = toVBox(oscore->first());
 
-    measure = score->first();
+    MeasureBase* measure = score->first();
     Q_ASSERT(measure->isVBox());
 
     VBox* titleFramePart = toVBox(measure);
@@ -316,6 +386,28 @@ void Excerpt::createExcerpt(Excerpt* excerpt)
         //score->spatiumChanged(oscore->spatium(), score->spatium());
         score->styleChanged();
     }
+}
+
+//---------------------------------------------------------
+//   createExcerpt
+//---------------------------------------------------------
+
+void Excerpt::createExcerpt(Excerpt* excerpt)
+{
+    MasterScore* oscore = excerpt->oscore();
+    Score* score        = excerpt->partScore();
+
+    QList<int> srcStaves = initPartScore(excerpt);
+    cloneStaves(oscore, score, srcStaves, excerpt->tracks());
+
+    // create excerpt title and title frame for all scores if not already there
+    MeasureBase* measure = oscore->first();
+
+    if (!measure || !measure->isVBox()) {
+        qDebug("original score has no header frame");
+        oscore->insertMeasure(ElementType::VBOX, measure);
+    }
+    layoutPartScore(excerpt);
 
     // second layout of score
     score->setPlaylistDirty();
@@ -326,6 +418,70 @@ void Excerpt::createExcerpt(Excerpt* excerpt)
     score->doLayout();
 }
 
+//---------------------------------------------------------
+//   createExcerpts
+//    create the part scores of excerpts of one master
+//    score; their part scores must be set.
+//    Every part is cloned and laid out on its own worker
+//    thread which links its elements through a LinkStage;
+//    the stages are merged in the order of excerpts.
+//---------------------------------------------------------
+
+void Excerpt::createExcerpts(const QList<Excerpt*>& excerpts)
+{
+    if (excerpts.isEmpty()) {
+        return;
+    }
+    MasterScore* oscore  = excerpts.front()->oscore();
+    MeasureBase* measure = oscore->first();
+    int threads          = qMin(excerpts.size(), int(std::thread::hardware_concurrency()));
+
+    // a missing title frame is inserted into the master score and all parts by createExcerpt()
+    if (threads < 2 || !measure || !measure->isVBox() || !QFontDatabase::supportsThreadedFontRendering()) {
+        for (Excerpt* excerpt : excerpts) {
+            createExcerpt(excerpt);
+        }
+        return;
+    }
+
+    QList<QList<int> > srcStaves;
+    for (Excerpt* excerpt : excerpts) {
+        srcStaves.append(initPartScore(excerpt));
+    }
+
+    // load what layout would load on first use
+    ScoreFont::fontFactory(oscore->styleSt(Sid::MusicalSymbolFont));
+    ScoreFont::fallbackFont();
+    oscore->fileInfo()->birthTime();
+    oscore->fileInfo()->lastModified();
+    {
+        std::lock_guard<std::recursive_mutex> lock(imageStore.mutex());
+        for (ImageStoreItem* item : imageStore) {
+            if (item->isUsed(oscore)) {
+                item->buffer();
+            }
+        }
+    }
+
+    std::vector<LinkStage> stages(excerpts.size());
+    forEachConcurrently(excerpts.size(), threads, [&](int i) {
+        LinkStage::Scope scope(&stages[i]);
+        Excerpt* excerpt = excerpts[i];
+        Score* score     = excerpt->partScore();
+        cloneStaves(oscore, score, srcStaves[i], excerpt->tracks());
+        layoutPartScore(excerpt);
+        score->setLayoutAll();
+        score->doLayout();
+    });
+
+    for (LinkStage& stage : stages) {
+        stage.merge(oscore);
+    }
+    oscore->setPlaylistDirty();
+    oscore->rebuildMidiMapping();
+    oscore->updateChannel();
+}
+
 //---------------------------------------------------------
 //   deleteExcerpt
 //---------------------------------------------------------
@@ -14,8 +14,10 @@
 #define __EXCERPT_H__
 
 #include <QMultiMap>
+#include <QXmlStreamReader>
 
 #include "fraction.h"
+#include "location.h"
 
 namespace Ms {
 class MasterScore;
@@ -25,6 +27,7 @@ class Measure;
 class XmlWriter;
 class Staff;
 class XmlReader;
+class LinkedElements;
 
 //---------------------------------------------------------
 //   @@ Excerpt
@@ -39,6 +42,15 @@ class Excerpt : public QObject
     QList<Part*> _parts;
     QMultiMap<int, int> _tracks;
 
+    // a part score which is not read yet, see setPartData()
+    QByteArray _partData;
+    qint64 _partLine            { 0 };
+    QString _docName;
+    QMap<int, QList<QPair<LinkedElements*, Location> > > _masterLinks;
+
+    static QList<int> initPartScore(Excerpt*);
+    static void layoutPartScore(Excerpt*);
+
 public:
     Excerpt(MasterScore* s = 0) { _oscore = s; }
     Excerpt(const Excerpt& ex, bool copyPartScore = true);
@@ -56,9 +68,14 @@ public:
     void setTracks(const QMultiMap<int, int>& t) { _tracks = t; }
 
     MasterScore* oscore() const { return _oscore; }
-    Score* partScore() const { return _partScore; }
+    Score* partScore() const { return _partScore; }     ///< may not be read yet, see readPartScores()
     void setPartScore(Score* s);
 
+    void setPartData(XmlReader& e, const QByteArray& data, qint64 line);
+    bool isPartScoreRead() const { return _partData.isEmpty(); }
+    QXmlStreamReader::Error readPartData(QString& message);
+    static void readPartScores(const QList<Excerpt*>&);
+
     void read(XmlReader&);
 
     bool operator!=(const Excerpt&) const;
@@ -70,6 +87,7 @@ public:
     static QList<Excerpt*> createAllExcerpt(MasterScore* score);
     static QString createName(const QString& partName, QList<Excerpt*>&);
     static void createExcerpt(Excerpt*);
+    static void createExcerpts(const QList<Excerpt*>&);
     static void cloneStaves(Score* oscore, Score* score, const QList<int>& sourceStavesIndexes, QMultiMap<int, int>& allTracks);
     static void cloneStaff(Staff* ostaff, Staff* nstaff);
     static void cloneStaff2(Staff* ostaff, Staff* nstaff, const Fraction& startTick, const Fraction& endTick);
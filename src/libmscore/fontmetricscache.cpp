@@ -0,0 +1,109 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include "fontmetricscache.h"
+
+#include "mscore.h"
+
+namespace Ms {
+//---------------------------------------------------------
+//   maxStrings
+//    strings remembered per font; a font which has
+//    measured more strings starts over
+//---------------------------------------------------------
+
+static const int maxStrings = 4096;
+
+//---------------------------------------------------------
+//   entry
+//---------------------------------------------------------
+
+FontMetricsCache::Entry* FontMetricsCache::entry(const QFont& font, QPaintDevice* device)
+{
+    Entry*& e = _entries[qMakePair(font, device)];
+    if (!e) {
+        e = new Entry(device ? QFontMetricsF(font, device) : QFontMetricsF(font));
+    }
+    return e;
+}
+
+//---------------------------------------------------------
+//   metrics
+//    metrics for MScore::paintDevice(), used for layout
+//---------------------------------------------------------
+
+const QFontMetricsF& FontMetricsCache::metrics(const QFont& font)
+{
+    return entry(font, MScore::paintDevice())->metrics;
+}
+
+//---------------------------------------------------------
+//   defaultMetrics
+//    same as QFontMetricsF(font)
+//---------------------------------------------------------
+
+const QFontMetricsF& FontMetricsCache::defaultMetrics(const QFont& font)
+{
+    return entry(font, nullptr)->metrics;
+}
+
+//---------------------------------------------------------
+//   width
+//    QFontMetricsF::width() of s for MScore::paintDevice()
+//---------------------------------------------------------
+
+qreal FontMetricsCache::width(const QFont& font, const QString& s)
+{
+    Entry* e = entry(font, MScore::paintDevice());
+    auto i = e->widths.constFind(s);
+    if (i != e->widths.constEnd()) {
+        return i.value();
+    }
+    if (e->widths.size() >= maxStrings) {
+        e->widths.clear();
+    }
+    qreal w = e->metrics.width(s);
+    e->widths.insert(s, w);
+    return w;
+}
+
+//---------------------------------------------------------
+//   tightBoundingRect
+//    QFontMetricsF::tightBoundingRect() of s for
+//    MScore::paintDevice()
+//---------------------------------------------------------
+
+QRectF FontMetricsCache::tightBoundingRect(const QFont& font, const QString& s)
+{
+    Entry* e = entry(font, MScore::paintDevice());
+    auto i = e->tightBoundingRects.constFind(s);
+    if (i != e->tightBoundingRects.constEnd()) {
+        return i.value();
+    }
+    if (e->tightBoundingRects.size() >= maxStrings) {
+        e->tightBoundingRects.clear();
+    }
+    QRectF r = e->metrics.tightBoundingRect(s);
+    e->tightBoundingRects.insert(s, r);
+    return r;
+}
+
+//---------------------------------------------------------
+//   clear
+//---------------------------------------------------------
+
+void FontMetricsCache::clear()
+{
+    qDeleteAll(_entries);
+    _entries.clear();
+}
+}     // namespace Ms
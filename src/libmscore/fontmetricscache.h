@@ -0,0 +1,69 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __FONTMETRICSCACHE_H__
+#define __FONTMETRICSCACHE_H__
+
+#include <QFont>
+#include <QFontMetricsF>
+#include <QHash>
+#include <QPair>
+#include <QRectF>
+
+class QPaintDevice;
+
+namespace Ms {
+//---------------------------------------------------------
+//   FontMetricsCache
+//    font metrics used by text layout, kept per score.
+//
+//    Creating a QFontMetricsF and measuring a string are
+//    expensive compared to the layout of a lyric syllable
+//    or chord symbol, which use the same few fonts and
+//    strings over and over. The cache keeps one metrics
+//    object per font and the widths and bounding rects of
+//    the strings measured with it. It is cleared when the
+//    style of the score changes.
+//---------------------------------------------------------
+
+class FontMetricsCache
+{
+    struct Entry {
+        QFontMetricsF metrics;
+        QHash<QString, qreal> widths;
+        QHash<QString, QRectF> tightBoundingRects;
+
+        Entry(const QFontMetricsF& fm)
+            : metrics(fm) {}
+    };
+
+    // the font and the device, null for the default device of QFontMetricsF(font)
+    QHash<QPair<QFont, QPaintDevice*>, Entry*> _entries;
+
+    Entry* entry(const QFont& font, QPaintDevice* device);
+
+public:
+    FontMetricsCache() = default;
+    FontMetricsCache(const FontMetricsCache&) = delete;
+    FontMetricsCache& operator=(const FontMetricsCache&) = delete;
+    ~FontMetricsCache() { clear(); }
+
+    const QFontMetricsF& metrics(const QFont& font);
+    const QFontMetricsF& defaultMetrics(const QFont& font);
+    qreal width(const QFont& font, const QString& s);
+    QRectF tightBoundingRect(const QFont& font, const QString& s);
+
+    int size() const { return _entries.size(); }
+    void clear();
+};
+}     // namespace Ms
+#endif
@@ -771,8 +771,7 @@ const ChordDescription* Harmony::parseHarmony(const QString& ss, int* root, int*
     if (useLiteral) {
         cd = descr(s);
     } else {
-        _parsedForm = new ParsedChord();
-        _parsedForm->parse(s, cl, syntaxOnly, preferMinor);
+        _parsedForm = new ParsedChord(cl->parse(s, syntaxOnly, preferMinor));
         // parser prepends "=" to name of implied minor chords
         // use this here as well
         if (preferMinor) {
@@ -1240,24 +1239,7 @@ const ChordDescription* Harmony::descr() const
 const ChordDescription* Harmony::descr(const QString& name, const ParsedChord* pc) const
 {
     const ChordList* cl = score()->style().chordList();
-    const ChordDescription* match = 0;
-    if (cl) {
-        for (const ChordDescription& cd : *cl) {
-            for (const QString& s : cd.names) {
-                if (s == name) {
-                    return &cd;
-                } else if (pc) {
-                    for (const ParsedChord& sParsed : cd.parsedChords) {
-                        if (sParsed == *pc) {
-                            match = &cd;
-                        }
-                    }
-                }
-            }
-        }
-    }
-    // exact match failed, so fall back on parsed match if one was found
-    return match;
+    return cl ? cl->description(name, pc) : 0;
 }
 
 //---------------------------------------------------------
@@ -1442,8 +1424,9 @@ QPoint Harmony::calculateBoundingRect()
         newy = yy;
     } else {
         QRectF bb;
+        FontMetricsCache& cache = score()->fontMetricsCache();
         for (TextSegment* ts : textList) {
-            bb |= ts->tightBoundingRect().translated(ts->x, ts->y);
+            bb |= cache.tightBoundingRect(ts->font, ts->text).translated(ts->x, ts->y);
         }
 
         qreal yy = -bb.y();      // Align::TOP
@@ -1652,7 +1635,7 @@ void Harmony::render(const QString& s, qreal& x, qreal& y)
         QFont f = _harmonyType != HarmonyType::ROMAN ? fontList[fontIdx] : font();
         TextSegment* ts = new TextSegment(s, f, x, y);
         textList.append(ts);
-        x += ts->width();
+        x += score()->fontMetricsCache().width(ts->font, ts->text);
     }
 }
 
@@ -1686,7 +1669,7 @@ void Harmony::render(const QList<RenderAction>& renderList, qreal& x, qreal& y,
                 ts->font.setPointSizeF(ts->font.pointSizeF() * nmag);
             }
             textList.append(ts);
-            x += ts->width();
+            x += score()->fontMetricsCache().width(ts->font, ts->text);
         } else if (a.type == RenderAction::RenderActionType::MOVE) {
             x += a.movex * mag * _spatium * .2;
             y += a.movey * mag * _spatium * .2;
@@ -1721,7 +1704,7 @@ void Harmony::render(const QList<RenderAction>& renderList, qreal& x, qreal& y,
                 ts->setText(c);
             }
             textList.append(ts);
-            x += ts->width();
+            x += score()->fontMetricsCache().width(ts->font, ts->text);
         } else if (a.type == RenderAction::RenderActionType::ACCIDENTAL) {
             QString c;
             QString acc;
@@ -1750,7 +1733,7 @@ void Harmony::render(const QList<RenderAction>& renderList, qreal& x, qreal& y,
                     ts->setText(acc);
                 }
                 textList.append(ts);
-                x += ts->width();
+                x += score()->fontMetricsCache().width(ts->font, ts->text);
             }
         } else {
             qDebug("unknown render action %d", static_cast<int>(a.type));
@@ -1998,8 +1981,7 @@ const ParsedChord* Harmony::parsedForm()
 {
     if (!_parsedForm) {
         ChordList* cl = score()->style().chordList();
-        _parsedForm = new ParsedChord();
-        _parsedForm->parse(_textName, cl, false);
+        _parsedForm = new ParsedChord(cl->parse(_textName));
     }
     return _parsedForm;
 }
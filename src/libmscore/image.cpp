@@ -354,9 +354,15 @@ void Image::read(XmlReader& e)
     bool loaded = false;
     // if a store path is given, attempt to get the image from the store
     if (!_storePath.isEmpty()) {
-        _storeItem = imageStore.getImage(_storePath);
+        {
+            // parts are read on several threads, which may clear unused images
+            std::lock_guard<std::recursive_mutex> lock(imageStore.mutex());
+            _storeItem = imageStore.getImage(_storePath);
+            if (_storeItem) {
+                _storeItem->reference(this);
+            }
+        }
         if (_storeItem) {
-            _storeItem->reference(this);
             loaded = true;
         }
         // if no image in store, attempt to load from path (for backward compatibility)
@@ -406,8 +412,11 @@ bool Image::load(const QString& ss)
 
     _linkIsValid = true;
     _linkPath = fi.canonicalFilePath();
-    _storeItem = imageStore.add(_linkPath, ba);
-    _storeItem->reference(this);
+    {
+        std::lock_guard<std::recursive_mutex> lock(imageStore.mutex());
+        _storeItem = imageStore.add(_linkPath, ba);
+        _storeItem->reference(this);
+    }
     if (path.endsWith(".svg")) {
         setImageType(ImageType::SVG);
     } else {
@@ -428,8 +437,11 @@ bool Image::loadFromData(const QString& ss, const QByteArray& ba)
 
     _linkIsValid = false;
     _linkPath = "";
-    _storeItem = imageStore.add(ss, ba);
-    _storeItem->reference(this);
+    {
+        std::lock_guard<std::recursive_mutex> lock(imageStore.mutex());
+        _storeItem = imageStore.add(ss, ba);
+        _storeItem->reference(this);
+    }
     if (ss.endsWith(".svg")) {
         setImageType(ImageType::SVG);
     } else {
@@ -14,6 +14,7 @@
 #include "imageStore.h"
 #include "score.h"
 #include "image.h"
+#include "thirdparty/qzip/qzipreader_p.h"
 
 namespace Ms {
 ImageStore imageStore;  // the global image store
@@ -34,6 +35,7 @@ ImageStoreItem::ImageStoreItem(const QString& p)
 
 void ImageStoreItem::dereference(Image* image)
 {
+    std::lock_guard<std::recursive_mutex> lock(imageStore.mutex());
     _references.removeOne(image);
 }
 
@@ -44,6 +46,7 @@ void ImageStoreItem::dereference(Image* image)
 
 void ImageStoreItem::reference(Image* image)
 {
+    std::lock_guard<std::recursive_mutex> lock(imageStore.mutex());
     _references.append(image);
 }
 
@@ -54,6 +57,7 @@ void ImageStoreItem::reference(Image* image)
 
 bool ImageStoreItem::isUsed(Score* score) const
 {
+    std::lock_guard<std::recursive_mutex> lock(imageStore.mutex());
     foreach (Image* image, _references) {
         if (image->score() == score) {
             return true;
@@ -62,13 +66,50 @@ bool ImageStoreItem::isUsed(Score* score) const
     return false;
 }
 
+bool ImageStoreItem::isUsed() const
+{
+    std::lock_guard<std::recursive_mutex> lock(imageStore.mutex());
+    return !_references.empty();
+}
+
+//---------------------------------------------------------
+//   buffer
+//    the image data, read on first use
+//---------------------------------------------------------
+
+QByteArray& ImageStoreItem::buffer()
+{
+    std::lock_guard<std::recursive_mutex> lock(imageStore.mutex());
+    if (!_scorePath.isEmpty()) {
+        load();
+    }
+    return _buffer;
+}
+
 //---------------------------------------------------------
 //   load
 //---------------------------------------------------------
 
 void ImageStoreItem::load()
 {
-    if (!_buffer.isEmpty()) {
+    std::lock_guard<std::recursive_mutex> lock(imageStore.mutex());
+    if (!_buffer.isEmpty() || _loadFailed) {
+        return;
+    }
+    if (!_scorePath.isEmpty()) {
+        // the score file may have been moved, deleted or replaced
+        // since the score was read; only take the image it was read with
+        MQZipReader uz(_scorePath);
+        QByteArray ba = uz.fileData(_path);
+        QCryptographicHash h(QCryptographicHash::Md4);
+        h.addData(ba);
+        if (ba.isEmpty() || h.result() != _hash) {
+            qWarning("Cannot read picture <%s> from <%s>", qPrintable(_path), qPrintable(_scorePath));
+            _loadFailed = true;
+        } else {
+            _buffer = ba;
+        }
+        _scorePath.clear();
         return;
     }
     QFile inFile(_path);
@@ -122,6 +163,38 @@ inline static int toInt(char c)
     return c - 'a' + 10;
 }
 
+//---------------------------------------------------------
+//   isHashName
+//---------------------------------------------------------
+
+static bool isHashName(const QString& s)
+{
+    if (s.size() != 32) {
+        return false;
+    }
+    for (const QChar& c : s) {
+        const ushort u = c.unicode();
+        if (!((u >= '0' && u <= '9') || (u >= 'a' && u <= 'f'))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//---------------------------------------------------------
+//   toHash
+//    decode the hash from a 32 digit hash name
+//---------------------------------------------------------
+
+static QByteArray toHash(const QString& s)
+{
+    QByteArray hash(16, 0);
+    for (int i = 0; i < 16; ++i) {
+        hash[i] = toInt(s[i * 2].toLatin1()) * 16 + toInt(s[i * 2 + 1].toLatin1());
+    }
+    return hash;
+}
+
 #if 0
 //---------------------------------------------------------
 //   dumpHash
@@ -156,6 +229,7 @@ ImageStore::~ImageStore()
 
 ImageStoreItem* ImageStore::getImage(const QString& path) const
 {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
     QString s = QFileInfo(path).completeBaseName();
     if (s.size() != 32) {
         //
@@ -174,10 +248,7 @@ ImageStoreItem* ImageStore::getImage(const QString& path) const
 
         return 0;
     }
-    QByteArray hash(16, 0);
-    for (int i = 0; i < 16; ++i) {
-        hash[i] = toInt(s[i * 2].toLatin1()) * 16 + toInt(s[i * 2 + 1].toLatin1());
-    }
+    QByteArray hash = toHash(s);
     for (ImageStoreItem* item : _items) {
         if (item->hash() == hash) {
             return item;
@@ -196,8 +267,12 @@ ImageStoreItem* ImageStore::add(const QString& path, const QByteArray& ba)
     QCryptographicHash h(QCryptographicHash::Md4);
     h.addData(ba);
     QByteArray hash = h.result();
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
     for (ImageStoreItem* item : _items) {
         if (item->hash() == hash) {
+            if (item->loadFailed()) {
+                item->set(ba, hash);
+            }
             return item;
         }
     }
@@ -207,12 +282,57 @@ ImageStoreItem* ImageStore::add(const QString& path, const QByteArray& ba)
     return item;
 }
 
+//---------------------------------------------------------
+//   addLazy
+//    add the image path of the compressed score file
+//    scorePath; it is read only when it is first used.
+//    The hash is taken from the hash name of the image
+//    and checked against the data read;
+//    return 0 for images with other names.
+//---------------------------------------------------------
+
+ImageStoreItem* ImageStore::addLazy(const QString& path, const QString& scorePath)
+{
+    QString s = QFileInfo(path).completeBaseName();
+    if (!isHashName(s)) {
+        return 0;
+    }
+    QByteArray hash = toHash(s);
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    for (ImageStoreItem* item : _items) {
+        if (item->hash() == hash) {
+            if (item->loadFailed()) {
+                item->setScorePath(scorePath, hash);
+            }
+            return item;
+        }
+    }
+    ImageStoreItem* item = new ImageStoreItem(path);
+    item->setScorePath(scorePath, hash);
+    _items.push_back(item);
+    return item;
+}
+
+//---------------------------------------------------------
+//   load
+//    read all images not read yet from their score files
+//---------------------------------------------------------
+
+void ImageStore::load()
+{
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    for (ImageStoreItem* item : _items) {
+        item->buffer();
+    }
+}
+
 //---------------------------------------------------------
 //   clearUnused
 //---------------------------------------------------------
 
 void ImageStore::clearUnused()
 {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
     _items.erase(
         std::remove_if(_items.begin(), _items.end(), [](ImageStoreItem* i) {
             const bool remove = !i->isUsed();
@@ -13,6 +13,7 @@
 #ifndef __IMAGE_CACHE_H__
 #define __IMAGE_CACHE_H__
 
+#include <mutex>
 #include <QList>
 #include <QString>
 #include <QByteArray>
@@ -32,6 +33,8 @@ class ImageStoreItem
     QString _type;                  // image type (file extension)
     QByteArray _buffer;
     QByteArray _hash;               // 16 byte md4 hash of _buffer
+    QString _scorePath;             // score file to read _buffer from on first use
+    bool _loadFailed { false };     // _buffer could not be read from the score file
 
 public:
     ImageStoreItem(const QString& p);
@@ -39,26 +42,33 @@ public:
     void reference(Image*);
 
     const QString& path() const { return _path; }
-    QByteArray& buffer() { return _buffer; }
-    const QByteArray& buffer() const { return _buffer; }
+    QByteArray& buffer();
+    const QByteArray& buffer() const { return const_cast<ImageStoreItem*>(this)->buffer(); }
     bool loaded() const { return !_buffer.isEmpty(); }
+    bool loadFailed() const { return _loadFailed; }
     void setPath(const QString& val);
     bool isUsed(Score*) const;
-    bool isUsed() const { return !_references.empty(); }
+    bool isUsed() const;
     void load();
     QString hashName() const;
     const QByteArray& hash() const { return _hash; }
-    void set(const QByteArray& b, const QByteArray& h) { _buffer = b; _hash = h; }
+    void set(const QByteArray& b, const QByteArray& h) { _buffer = b; _hash = h; _loadFailed = false; }
+    void setScorePath(const QString& path, const QByteArray& h) { _scorePath = path; _hash = h; _loadFailed = false; }
 };
 
 //---------------------------------------------------------
 //   ImageStore
+//    images are looked up, added, referenced and loaded by
+//    scores read and laid out on several threads; mutex()
+//    guards the store and the references and data of its
+//    items. Iterating the store is not guarded.
 //---------------------------------------------------------
 
 class ImageStore
 {
     typedef std::vector<ImageStoreItem*> ItemList;
     ItemList _items;
+    mutable std::recursive_mutex _mutex;
 
 public:
     ImageStore() = default;
@@ -68,7 +78,10 @@ public:
 
     ImageStoreItem* getImage(const QString& path) const;
     ImageStoreItem* add(const QString& path, const QByteArray&);
+    ImageStoreItem* addLazy(const QString& path, const QString& scorePath);
+    void load();
     void clearUnused();
+    std::recursive_mutex& mutex() const { return _mutex; }
 
     typedef ItemList::iterator iterator;
     typedef ItemList::const_iterator const_iterator;
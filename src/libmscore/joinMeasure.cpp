@@ -14,6 +14,7 @@
 #include "measure.h"
 #include "undo.h"
 #include "range.h"
+#include "excerpt.h"
 #include "spanner.h"
 
 namespace Ms {
@@ -28,6 +29,9 @@ void Score::cmdJoinMeasure(Measure* m1, Measure* m2)
         return;
     }
 
+    // the measures of every part score change
+    Excerpt::readPartScores(excerpts());
+
     for (int staffIdx = 0; staffIdx < nstaves(); ++staffIdx) {
         if (m1->isMeasureRepeatGroupWithPrevM(staffIdx) || m2->isMeasureRepeatGroupWithNextM(staffIdx)) {
             MScore::setError(CANNOT_SPLIT_MEASURE_REPEAT);
@@ -68,6 +68,7 @@
 #include "spacer.h"
 #include "fermata.h"
 #include "measurenumber.h"
+#include "measurewritecache.h"
 
 namespace Ms {
 // #define PAGE_DEBUG
@@ -1440,14 +1441,60 @@ void Score::hideEmptyStaves(System* system, bool isFirstSystem)
 
 void Score::connectTies(bool silent)
 {
-    int tracks = nstaves() * VOICES;
     Measure* m = firstMeasure();
     if (!m) {
         return;
     }
+    connectTies(m, nullptr, silent);
+}
+
+//---------------------------------------------------------
+//   connectTies
+///   Rebuild tie connections in the measures from stick
+///   to etick, usually the range of the current command.
+///   The range is widened by a measure at both ends for
+///   ties reaching into it; a negative stick means the
+///   whole score, a negative etick the end of the score.
+//---------------------------------------------------------
+
+void Score::connectTies(const Fraction& stick, const Fraction& etick, bool silent)
+{
+    Measure* lm = lastMeasure();
+    if (!lm) {
+        return;
+    }
+    if (stick < Fraction(0, 1)) {
+        connectTies(silent);
+        return;
+    }
+    Measure* sm = stick < lm->endTick() ? tick2measure(stick) : lm;
+    if (sm->prevMeasure()) {
+        sm = sm->prevMeasure();
+    }
+    Measure* em = etick >= Fraction(0, 1) && etick < lm->endTick() ? tick2measure(etick) : nullptr;
+    if (em) {
+        em = em->nextMeasure();
+        if (em) {
+            em = em->nextMeasure();
+        }
+    }
+    connectTies(sm, em, silent);
+}
 
+//---------------------------------------------------------
+//   connectTies
+///   Rebuild tie connections in the measures from sm up
+///   to, but not including, em.
+//---------------------------------------------------------
+
+void Score::connectTies(Measure* sm, Measure* em, bool silent)
+{
+    int tracks = nstaves() * VOICES;
     SegmentType st = SegmentType::ChordRest;
-    for (Segment* s = m->first(st); s; s = s->next1(st)) {
+    for (Segment* s = sm->first(st); s; s = s->next1(st)) {
+        if (em && s->tick() >= em->tick()) {
+            break;
+        }
         for (int i = 0; i < tracks; ++i) {
             Element* e = s->element(i);
             if (e == 0 || !e->isChord()) {
@@ -1576,6 +1623,7 @@ static void checkDivider(bool left, System* s, qreal yOffset, bool remove = fals
             divider->setGenerated(true);
             s->add(divider);
         }
+        const QRectF oldRect = divider->bbox().translated(divider->pos());
         divider->layout();
         divider->rypos() = divider->height() * .5 + yOffset;
         if (left) {
@@ -1586,6 +1634,9 @@ static void checkDivider(bool left, System* s, qreal yOffset, bool remove = fals
             divider->rxpos() =  s->score()->styleD(Sid::pagePrintableWidth) * DPI - divider->width();
             divider->rxpos() += s->score()->styleD(Sid::dividerRightX) * SPATIUM20;
         }
+        if (divider->bbox().translated(divider->pos()) != oldRect) {
+            s->rebuildBspTree();
+        }
     } else if (divider) {
         if (divider->generated()) {
             s->remove(divider);
@@ -2782,6 +2833,121 @@ std::pair<qreal, qreal> extendedStemLenWithTwoNoteTremolo(Tremolo* tremolo, qrea
     return { stemLen1, stemLen2 };
 }
 
+//---------------------------------------------------------
+//   measureLayoutFingerprint
+//    hash of the context the chords of m are laid out in:
+//    style, time signature and, for each staff, key, clef,
+//    staff type, instrument and visibility. The content of
+//    m itself is covered by Score::invalidateMeasureLayouts().
+//---------------------------------------------------------
+
+static quint64 measureLayoutFingerprint(const Score* score, const Measure* m)
+{
+    quint64 h = Q_UINT64_C(14695981039346656037);
+    auto add = [&h](quint64 v) {
+        h = (h ^ v) * Q_UINT64_C(1099511628211);
+    };
+    add(score->style().serial());
+    add(score->nstaves());
+    add(m->ticks().numerator());
+    add(m->ticks().denominator());
+    add(m->timesig().numerator());
+    add(m->timesig().denominator());
+
+    const Fraction tick = m->tick();
+    for (const Staff* staff : score->staves()) {
+        const KeySigEvent key = staff->keySigEvent(tick);
+        const Instrument* instrument = staff->part()->instrument();
+        add(int(key.key()));
+        add(key.custom() | key.isAtonal() << 1 | staff->show() << 2 | instrument->useDrumset() << 3);
+        add(int(staff->clef(tick)));
+        add(quintptr(staff->staffType(tick)));
+        add(quintptr(instrument));
+        add(qHash(staff->staffMag(tick)));
+    }
+    return h;
+}
+
+//---------------------------------------------------------
+//   canReuseLayout
+//    whether the chord layout of m depends on m alone:
+//    no beam reaching into m from the previous measure and
+//    no chord moved to another staff
+//---------------------------------------------------------
+
+static bool canReuseLayout(const Score* score, const Measure* m)
+{
+    if (m->isMMRest() || score->styleB(Sid::crossMeasureValues)) {
+        return false;
+    }
+    std::vector<bool> firstCR(score->ntracks(), true);
+    for (const Segment* s = m->first(SegmentType::ChordRest); s; s = s->next(SegmentType::ChordRest)) {
+        for (int track = 0; track < score->ntracks(); ++track) {
+            const ChordRest* cr = s->cr(track);
+            if (!cr) {
+                continue;
+            }
+            if (cr->staffMove()) {
+                return false;
+            }
+            if (firstCR[track]) {
+                firstCR[track] = false;
+                if (cr->beamMode() == Beam::Mode::MID || cr->beamMode() == Beam::Mode::END) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+//---------------------------------------------------------
+//   invalidateMeasureLayouts
+//    make the measures changed by a command lay out their
+//    chords anew, see Score::update()
+//---------------------------------------------------------
+
+void Score::invalidateMeasureLayouts(const CmdState& cs)
+{
+    Fraction stick;
+    Fraction etick;
+    if (cs.changedRange(undoStack()->changes(), _measureLayoutChanges, stick, etick)) {
+        invalidateMeasureLayouts(stick, etick);
+    }
+}
+
+//---------------------------------------------------------
+//   invalidateMeasureLayouts
+//    stick - etick, widened by a measure at both ends for
+//    ties and beams; a negative etick means the end of
+//    the score
+//---------------------------------------------------------
+
+void Score::invalidateMeasureLayouts(const Fraction& stick, const Fraction& etick)
+{
+    Measure* lm = lastMeasure();
+    if (!lm) {
+        return;
+    }
+    Measure* sm = stick < lm->endTick() ? tick2measure(stick) : lm;
+    if (sm->prevMeasure()) {
+        sm = sm->prevMeasure();
+    }
+    Measure* em = etick >= Fraction(0, 1) && etick < lm->endTick() ? tick2measure(etick) : lm;
+    if (em->nextMeasure()) {
+        em = em->nextMeasure();
+    }
+    for (Measure* m = sm; m; m = m->nextMeasure()) {
+        m->setLayoutFingerprint(0);
+        if (m->mmRest()) {
+            m->mmRest()->setLayoutFingerprint(0);
+        }
+        if (m == em) {
+            break;
+        }
+    }
+}
+
 //---------------------------------------------------------
 //   getNextMeasure
 //---------------------------------------------------------
@@ -2863,6 +3029,12 @@ void Score::getNextMeasure(LayoutContext& lc)
 
     measure->connectTremolo();
 
+    // measures whose content and context did not change since
+    // their last layout keep their chords, beams and shapes
+    const quint64 fingerprint = measureLayoutFingerprint(this, measure);
+    const bool reuse = lc.reuseMeasures && measure->layoutFingerprint() == fingerprint && fingerprint
+                       && measure->restoreLayoutShapes();
+
     //
     // calculate accidentals and note lines,
     // create stem and set stem direction
@@ -2886,6 +3058,9 @@ void Score::getNextMeasure(LayoutContext& lc)
                 as.init(staff->keySigEvent(tick), staff->clef(tick));
                 ks->layout();
             } else if (segment.isChordRestType()) {
+                if (reuse) {
+                    continue;
+                }
                 const StaffType* st = staff->staffTypeForElement(&segment);
                 int track     = staffIdx * VOICES;
                 int endTrack  = track + VOICES;
@@ -2957,12 +3132,16 @@ void Score::getNextMeasure(LayoutContext& lc)
         }
     }
 
-    createBeams(lc, measure);
+    if (!reuse) {
+        createBeams(lc, measure);
+    }
 
     for (int staffIdx = 0; staffIdx < score()->nstaves(); ++staffIdx) {
         for (Segment& segment : measure->segments()) {
             if (segment.isChordRestType()) {
-                layoutChords1(&segment, staffIdx);
+                if (!reuse) {
+                    layoutChords1(&segment, staffIdx);
+                }
                 for (int voice = 0; voice < VOICES; ++voice) {
                     ChordRest* cr = segment.cr(staffIdx * VOICES + voice);
                     if (cr) {
@@ -3020,6 +3199,9 @@ void Score::getNextMeasure(LayoutContext& lc)
         //      continue;
         // DEBUG: relayout grace notes as beaming/flags may have changed
         if (s.isChordRestType()) {
+            if (reuse) {
+                continue;
+            }
             for (Element* e : s.elist()) {
                 if (e && e->isChord()) {
                     Chord* chord = toChord(e);
@@ -3034,6 +3216,15 @@ void Score::getNextMeasure(LayoutContext& lc)
         s.createShapes();
     }
 
+    if (!reuse) {
+        if (canReuseLayout(this, measure)) {
+            measure->setLayoutFingerprint(fingerprint);
+            measure->saveLayoutShapes();
+        } else {
+            measure->setLayoutFingerprint(0);
+        }
+    }
+
     lc.tick += measure->ticks();
 }
 
@@ -3462,9 +3653,12 @@ void Score::layoutLyrics(System* system)
 
 //---------------------------------------------------------
 //   layoutTies
+//    the tie segments are queued in l and collected in
+//    segments; their shapes are added to the skyline after
+//    l has run
 //---------------------------------------------------------
 
-void layoutTies(Chord* ch, System* system, const Fraction& stick)
+void layoutTies(Chord* ch, System* system, const Fraction& stick, SlurTieLayout& l, std::vector<TieSegment*>& segments)
 {
     SysStaff* staff = system->staff(ch->staffIdx());
     if (!staff->show()) {
@@ -3473,17 +3667,17 @@ void layoutTies(Chord* ch, System* system, const Fraction& stick)
     for (Note* note : ch->notes()) {
         Tie* t = note->tieFor();
         if (t) {
-            TieSegment* ts = t->layoutFor(system);
-            if (ts && ts->addToSkyline()) {
-                staff->skyline().add(ts->shape().translated(ts->pos()));
+            TieSegment* ts = t->layoutFor(system, &l);
+            if (ts) {
+                segments.push_back(ts);
             }
         }
         t = note->tieBack();
         if (t) {
             if (t->startNote()->tick() < stick) {
-                TieSegment* ts = t->layoutBack(system);
-                if (ts && ts->addToSkyline()) {
-                    staff->skyline().add(ts->shape().translated(ts->pos()));
+                TieSegment* ts = t->layoutBack(system, &l);
+                if (ts) {
+                    segments.push_back(ts);
                 }
             }
         }
@@ -3695,15 +3889,23 @@ void alignHarmonies(const System* system, const std::vector<Segment*>& sl, bool
 //   processLines
 //---------------------------------------------------------
 
-static void processLines(System* system, std::vector<Spanner*> lines, bool align)
+static void processLines(System* system, std::vector<Spanner*> lines, bool align, SlurTieLayout* slurLayout = nullptr)
 {
     std::vector<SpannerSegment*> segments;
     for (Spanner* sp : lines) {
-        SpannerSegment* ss = sp->layoutSystem(system);         // create/layout spanner segment for this system
+        SpannerSegment* ss;
+        if (slurLayout && sp->isSlur()) {
+            ss = toSlur(sp)->layoutSystem(system, slurLayout);
+        } else {
+            ss = sp->layoutSystem(system);         // create/layout spanner segment for this system
+        }
         if (ss->autoplace()) {
             segments.push_back(ss);
         }
     }
+    if (slurLayout) {
+        slurLayout->run();
+    }
 
     if (align && segments.size() > 1) {
         const int nstaves = system->staves()->size();
@@ -4385,7 +4587,8 @@ void Score::layoutSystemElements(System* system, LayoutContext& lc)
             }
         }
     }
-    processLines(system, spanner, false);
+    SlurTieLayout slurTieLayout(system->staves()->size());
+    processLines(system, spanner, false, &slurTieLayout);
     for (auto s : spanner) {
         Slur* slur = toSlur(s);
         ChordRest* scr = s->startCR();
@@ -4398,18 +4601,32 @@ void Score::layoutSystemElements(System* system, LayoutContext& lc)
         }
     }
 
-    std::vector<Dynamic*> dynamics;
-    for (Segment* s : sl) {
-        for (Element* e : s->elist()) {
-            if (!e) {
-                continue;
-            }
-            if (e->isChord()) {
+    //-------------------------------------------------------------
+    // layout ties
+    //    the tie segments are laid out at once and added to the
+    //    skylines in the order of segments below
+    //-------------------------------------------------------------
+
+    std::vector<std::vector<TieSegment*> > ties(sl.size());
+    for (size_t i = 0; i < sl.size(); ++i) {
+        for (Element* e : sl[i]->elist()) {
+            if (e && e->isChord()) {
                 Chord* c = toChord(e);
                 for (Chord* ch : c->graceNotes()) {
-                    layoutTies(ch, system, stick);
+                    layoutTies(ch, system, stick, slurTieLayout, ties[i]);
                 }
-                layoutTies(c, system, stick);
+                layoutTies(c, system, stick, slurTieLayout, ties[i]);
+            }
+        }
+    }
+    slurTieLayout.run();
+
+    std::vector<Dynamic*> dynamics;
+    for (size_t i = 0; i < sl.size(); ++i) {
+        Segment* s = sl[i];
+        for (TieSegment* ts : ties[i]) {
+            if (ts->addToSkyline()) {
+                system->staff(ts->staffIdx())->skyline().add(ts->shape().translated(ts->pos()));
             }
         }
         for (Element* e : s->annotations()) {
@@ -4897,8 +5114,8 @@ void LayoutContext::collectPage()
         qreal height = s ? s->pos().y() + s->height() + s->minBottom() : page->tm();
         page->bbox().setRect(0.0, 0.0, score->loWidth(), height + page->bm());
     }
-
-    page->rebuildBspTree();
+    // the spatial index of systems which were (re)laid out has been
+    // invalidated by System::layout2(); systems only moved on this page keep theirs
 }
 
 //---------------------------------------------------------
@@ -4932,6 +5149,7 @@ void Score::doLayoutRange(const Fraction& st, const Fraction& et)
 {
     CmdStateLocker cmdStateLocker(this);
     LayoutContext lc(this);
+    ++_layoutSerial;
 
     Fraction stick(st);
     Fraction etick(et);
@@ -4957,6 +5175,7 @@ void Score::doLayoutRange(const Fraction& st, const Fraction& et)
     }
 
     lc.endTick     = etick;
+    lc.reuseMeasures = !layoutAll && undoStack()->changes() == _measureLayoutChanges;
     _scoreFont     = ScoreFont::fontFactory(style().value(Sid::MusicalSymbolFont).toString());
     _noteHeadWidth = _scoreFont->width(SymId::noteheadBlack, spatium() / SPATIUM20);
 
@@ -5008,6 +5227,9 @@ void Score::doLayoutRange(const Fraction& st, const Fraction& et)
         lc.nextMeasure = m;         //_showVBox ? first() : firstMeasure();
         lc.startTick   = m->tick();
         layoutLinear(layoutAll, lc);
+        if (_measureWriteCache) {
+            _measureWriteCache->clear();
+        }
         return;
     }
     if (!layoutAll && m->system()) {
@@ -5079,11 +5301,21 @@ void Score::doLayoutRange(const Fraction& st, const Fraction& et)
     }
 
     lc.prevMeasure = 0;
+    const Fraction layoutStart = lc.nextMeasure ? lc.nextMeasure->tick() : Fraction(0, 1);
 
     getNextMeasure(lc);
     lc.curSystem = collectSystem(lc);
 
     lc.layout();
+
+    // spanner segments are saved with the measures, see MeasureWriteCache
+    if (_measureWriteCache) {
+        if (layoutAll) {
+            _measureWriteCache->clear();
+        } else {
+            _measureWriteCache->invalidate(this, layoutStart, lc.nextMeasure ? lc.nextMeasure->tick() : Fraction(-1, 1));
+        }
+    }
 }
 
 //---------------------------------------------------------
@@ -5123,11 +5355,6 @@ void LayoutContext::layout()
         while (score->npages() > curPage) {
             delete score->pages().takeLast();
         }
-    } else {
-        Page* p = curSystem->page();
-        if (p && (p != page)) {
-            p->rebuildBspTree();
-        }
     }
     score->systems().append(systemList);       // TODO
 }
@@ -49,6 +49,7 @@ struct LayoutContext {
     int measureNo            { 0 };
     Fraction startTick;
     Fraction endTick;
+    bool reuseMeasures       { false };    // keep the chord layout of unchanged measures
 
     LayoutContext(Score* s)
         : score(s) {}
@@ -0,0 +1,204 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include "linkstage.h"
+
+#include "score.h"
+#include "scoreElement.h"
+#include "undo.h"
+
+namespace Ms {
+thread_local LinkStage* LinkStage::_current = nullptr;
+
+//---------------------------------------------------------
+//   LinkStage
+//---------------------------------------------------------
+
+LinkStage::LinkStage()
+{
+    _cmdState = new CmdState;
+}
+
+//---------------------------------------------------------
+//   ~LinkStage
+//    a merged stage is empty
+//---------------------------------------------------------
+
+LinkStage::~LinkStage()
+{
+    for (const Entry& en : _entries) {
+        delete en.list;
+    }
+    for (UndoCommand* cmd : _commands) {
+        delete cmd;
+    }
+    delete _cmdState;
+}
+
+//---------------------------------------------------------
+//   links
+//    the list e with the list l is linked to as seen by
+//    the thread of the stage
+//---------------------------------------------------------
+
+LinkedElements* LinkStage::links(const ScoreElement* e, LinkedElements* l) const
+{
+    if (l && _lists.contains(l)) {
+        return l;
+    }
+    auto i = _keys.find(l ? static_cast<const void*>(l) : e);
+    return i == _keys.end() ? l : _entries[i.value()].list;
+}
+
+//---------------------------------------------------------
+//   linkedElements
+//    return the private list to link an element to e;
+//    the list e belongs to is copied, e itself is not
+//    changed
+//---------------------------------------------------------
+
+LinkedElements* LinkStage::linkedElements(ScoreElement* e)
+{
+    LinkedElements* l = e->links();
+    if (l && _lists.contains(l)) {
+        return l;
+    }
+    Entry en;
+    en.list   = new LinkedElements(e->score(), -1);       // the id is given by merge()
+    en.base   = l;
+    en.anchor = l ? nullptr : e;
+    if (l) {
+        en.list->append(*l);
+    } else {
+        en.list->append(e);
+    }
+    en.baseSize = en.list->size();
+
+    int idx = int(_entries.size());
+    _entries.push_back(en);
+    _keys.insert(l ? static_cast<const void*>(l) : e, idx);
+    _lists.insert(en.list, idx);
+    return en.list;
+}
+
+//---------------------------------------------------------
+//   remove
+//    unlink e if it is in a private list;
+//    return false if e is not linked by the stage
+//---------------------------------------------------------
+
+bool LinkStage::remove(ScoreElement* e)
+{
+    auto i = _lists.find(e->links());
+    if (i == _lists.end()) {
+        return false;
+    }
+    Entry& en = _entries[i.value()];
+    int idx = en.list->indexOf(e);
+    Q_ASSERT(idx >= 0);
+    if (idx < en.baseSize) {
+        if (e != en.anchor) {
+            qWarning("LinkStage: cannot unlink an element of another score");
+            return false;
+        }
+        _keys.remove(e);
+        en.anchor   = nullptr;
+        en.baseSize = 0;
+    }
+    en.list->removeAt(idx);
+    e->setLinks(nullptr);
+    return true;
+}
+
+//---------------------------------------------------------
+//   merge
+//    add the links, undo commands and layout state of the
+//    stage to score; called after the thread of the stage
+//    has finished
+//---------------------------------------------------------
+
+void LinkStage::merge(MasterScore* score)
+{
+    Q_ASSERT(_current != this);
+
+    QHash<LinkedElements*, LinkedElements*> merged;
+    for (const Entry& en : _entries) {
+        LinkedElements* list   = en.list;
+        LinkedElements* target = en.base;
+        if (!target && en.anchor) {
+            // a previously merged stage may have created the list
+            target = en.anchor->links();
+            if (!target) {
+                if (en.anchor->isStaff()) {
+                    target = new LinkedElements(score, -1);
+                } else {
+                    target = new LinkedElements(score);
+                }
+                target->append(en.anchor);
+                en.anchor->setLinks(target);
+            }
+        }
+        if (!target) {
+            // the anchor was unlinked or deleted, the list only holds elements of the stage
+            if (list->empty()) {
+                merged.insert(list, nullptr);
+                delete list;
+            } else {
+                if (!list->front()->isStaff()) {
+                    list->setLid(score, score->linkId());
+                }
+                merged.insert(list, list);
+            }
+            continue;
+        }
+        for (int i = en.baseSize; i < list->size(); ++i) {
+            ScoreElement* e = list->at(i);
+            target->append(e);
+            e->setLinks(target);
+        }
+        merged.insert(list, target);
+        delete list;
+    }
+    _entries.clear();
+    _keys.clear();
+    _lists.clear();
+
+    UndoMacro* macro = score->undoStack()->current();
+    for (UndoCommand* cmd : _commands) {
+        if (!strcmp(cmd->name(), "Link") || !strcmp(cmd->name(), "Unlink")) {
+            LinkUnlink* lu = static_cast<LinkUnlink*>(cmd);
+            auto i = merged.find(lu->links());
+            if (i != merged.end()) {
+                lu->setLinks(i.value());
+            }
+        }
+        if (macro) {
+            macro->appendChild(cmd);
+        } else {
+            delete cmd;
+        }
+    }
+    _commands.clear();
+    score->undoStack()->countChange();
+
+    CmdState& cs = score->cmdState();
+    cs.layoutFlags |= _cmdState->layoutFlags;
+    if (_cmdState->startTick() >= Fraction(0, 1)) {
+        cs.setTick(_cmdState->startTick());
+        cs.setTick(_cmdState->endTick());
+    }
+    cs.setUpdateMode(_cmdState->updateMode());
+    cs._excerptsChanged    |= _cmdState->_excerptsChanged;
+    cs._instrumentsChanged |= _cmdState->_instrumentsChanged;
+    _cmdState->reset();
+}
+}     // namespace Ms
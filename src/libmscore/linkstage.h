@@ -0,0 +1,94 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __LINKSTAGE_H__
+#define __LINKSTAGE_H__
+
+#include <vector>
+
+#include <QHash>
+
+namespace Ms {
+class CmdState;
+class LinkedElements;
+class MasterScore;
+class ScoreElement;
+class UndoCommand;
+
+//---------------------------------------------------------
+//   LinkStage
+//    Links, undo commands and layout state created by a
+//    thread which builds a part score while other threads
+//    build other parts of the same master score, see
+//    Excerpt::createExcerpts().
+//
+//    While a stage is current, elements are linked into
+//    private copies of the linked elements lists, undo
+//    commands are executed and kept in the stage and the
+//    command state of the master score is replaced by one
+//    of the stage, so that the master score, its elements
+//    and its undo stack are only read.
+//    merge() adds everything to the master score; merging
+//    the stages in a fixed order gives the same link ids
+//    and undo history on every run.
+//---------------------------------------------------------
+
+class LinkStage
+{
+    struct Entry {
+        LinkedElements* list;         ///< private list
+        LinkedElements* base;         ///< list the private list was copied from, or null
+        ScoreElement* anchor;         ///< element which had no list, null if removed
+        int baseSize;                 ///< number of elements not added by the stage
+    };
+
+    std::vector<Entry> _entries;                  ///< in order of creation
+    QHash<const void*, int> _keys;                ///< base list or anchor -> entry
+    QHash<const LinkedElements*, int> _lists;     ///< private list -> entry
+    std::vector<UndoCommand*> _commands;
+    CmdState* _cmdState;
+
+    static thread_local LinkStage* _current;
+
+public:
+    LinkStage();
+    LinkStage(const LinkStage&) = delete;
+    LinkStage& operator=(const LinkStage&) = delete;
+    ~LinkStage();
+
+    static LinkStage* current() { return _current; }
+
+    LinkedElements* links(const ScoreElement* e, LinkedElements* l) const;
+    LinkedElements* linkedElements(ScoreElement* e);
+    bool remove(ScoreElement* e);
+    void addCommand(UndoCommand* cmd) { _commands.push_back(cmd); }
+    CmdState& cmdState() { return *_cmdState; }
+
+    void merge(MasterScore* score);
+
+    //---------------------------------------------------
+    //   Scope
+    //    make a stage current on this thread
+    //---------------------------------------------------
+
+    class Scope
+    {
+        LinkStage* _saved;
+
+    public:
+        Scope(LinkStage* stage)
+            : _saved(_current) { _current = stage; }
+        ~Scope() { _current = _saved; }
+    };
+};
+}     // namespace Ms
+#endif
@@ -1998,8 +1998,10 @@ void Measure::read(XmlReader& e, int staffIdx)
                                                                                                                   toString()));
             return;
         }
-        score()->sigmap()->add(tick().ticks(), SigEvent(_len, m_timesig));
-        score()->sigmap()->add((tick() + ticks()).ticks(), SigEvent(m_timesig));
+        if (!score()->readConcurrently()) {
+            score()->sigmap()->add(tick().ticks(), SigEvent(_len, m_timesig));
+            score()->sigmap()->add((tick() + ticks()).ticks(), SigEvent(m_timesig));
+        }
     } else {
         irregular = false;
     }
@@ -2288,11 +2290,15 @@ void Measure::readVoice(XmlReader& e, int staffIdx, bool irregular)
                 m_timesig    = ts->sig() / timeStretch;
 
                 if (irregular) {
-                    score()->sigmap()->add(tick().ticks(), SigEvent(_len, m_timesig));
-                    score()->sigmap()->add((tick() + ticks()).ticks(), SigEvent(m_timesig));
+                    if (!score()->readConcurrently()) {
+                        score()->sigmap()->add(tick().ticks(), SigEvent(_len, m_timesig));
+                        score()->sigmap()->add((tick() + ticks()).ticks(), SigEvent(m_timesig));
+                    }
                 } else {
                     _len = m_timesig;
-                    score()->sigmap()->add(tick().ticks(), SigEvent(m_timesig));
+                    if (!score()->readConcurrently()) {
+                        score()->sigmap()->add(tick().ticks(), SigEvent(m_timesig));
+                    }
                 }
             }
         } else if (tag == "KeySig") {
@@ -3678,6 +3684,47 @@ Fraction Measure::computeTicks()
     return minTick;
 }
 
+//---------------------------------------------------------
+//   saveLayoutShapes
+//    remember the shapes of the chord rest segments as
+//    Score::getNextMeasure() created them, before the
+//    system layout adjusts them to the beams
+//---------------------------------------------------------
+
+void Measure::saveLayoutShapes()
+{
+    m_layoutShapes.clear();
+    for (const Segment* s = first(SegmentType::ChordRest); s; s = s->next(SegmentType::ChordRest)) {
+        m_layoutShapes.push_back(s->shapes());
+    }
+}
+
+//---------------------------------------------------------
+//   restoreLayoutShapes
+//    returns false if the chord rest segments do not
+//    match the saved shapes any more
+//---------------------------------------------------------
+
+bool Measure::restoreLayoutShapes()
+{
+    const size_t staves = score()->nstaves();
+    size_t n = 0;
+    for (Segment* s = first(SegmentType::ChordRest); s; s = s->next(SegmentType::ChordRest)) {
+        if (n == m_layoutShapes.size() || m_layoutShapes[n].size() != staves) {
+            return false;
+        }
+        ++n;
+    }
+    if (n != m_layoutShapes.size()) {
+        return false;
+    }
+    n = 0;
+    for (Segment* s = first(SegmentType::ChordRest); s; s = s->next(SegmentType::ChordRest)) {
+        s->setShapes(m_layoutShapes[n++]);
+    }
+    return true;
+}
+
 //---------------------------------------------------------
 //   endBarLine
 //      return the first one
@@ -270,6 +270,11 @@ public:
 
     int playbackCount() const { return m_playbackCount; }
     void setPlaybackCount(int val) { m_playbackCount = val; }
+
+    quint64 layoutFingerprint() const { return m_layoutFingerprint; }
+    void setLayoutFingerprint(quint64 val) { m_layoutFingerprint = val; }
+    void saveLayoutShapes();
+    bool restoreLayoutShapes();
     QRectF staffabbox(int staffIdx) const;
 
     QVariant getProperty(Pid propertyId) const override;
@@ -350,6 +355,9 @@ private:
 
     MeasureNumberMode m_noMode;
     bool m_breakMultiMeasureRest;
+
+    quint64 m_layoutFingerprint { 0 };                  ///< context of the last chord layout, 0 to redo it
+    std::vector<std::vector<Shape> > m_layoutShapes;    ///< chord rest segment shapes after it
 };
 }     // namespace Ms
 #endif
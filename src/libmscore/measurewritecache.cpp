@@ -0,0 +1,224 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include "measurewritecache.h"
+
+#include "measure.h"
+#include "mscore.h"
+#include "score.h"
+#include "segment.h"
+#include "spanner.h"
+#include "undo.h"
+
+namespace Ms {
+//---------------------------------------------------------
+//   State
+//---------------------------------------------------------
+
+MeasureWriteCache::State::State(const XmlWriter& xml)
+    : curTick(xml.curTick()), tickDiff(xml.tickDiff()), curTrack(xml.curTrack()), trackDiff(xml.trackDiff()),
+    level(xml.level()), excerptmode(xml.excerptmode()), writeOmr(xml.writeOmr()), writeTrack(xml.writeTrack()),
+    writePosition(xml.writePosition()), debugMode(MScore::debugMode), linksIndexer(xml.linksIndexer())
+{
+}
+
+bool MeasureWriteCache::State::operator==(const State& s) const
+{
+    return curTick == s.curTick
+           && tickDiff == s.tickDiff
+           && curTrack == s.curTrack
+           && trackDiff == s.trackDiff
+           && level == s.level
+           && excerptmode == s.excerptmode
+           && writeOmr == s.writeOmr
+           && writeTrack == s.writeTrack
+           && writePosition == s.writePosition
+           && debugMode == s.debugMode
+           && linksIndexer == s.linksIndexer;
+}
+
+//---------------------------------------------------------
+//   canWrite
+//    whether fragments can be used with xml; only plain
+//    writes of whole scores are cached
+//---------------------------------------------------------
+
+bool MeasureWriteCache::canWrite(const XmlWriter& xml)
+{
+    return !xml.clipboardmode() && !xml.recordElements() && (xml.device() || xml.string());
+}
+
+//---------------------------------------------------------
+//   writtenSegments
+//    segments of m which Segment::write() marked written
+//    and whose output depends on it
+//---------------------------------------------------------
+
+std::vector<const Segment*> MeasureWriteCache::writtenSegments(const Measure* m)
+{
+    std::vector<const Segment*> sl;
+    for (const Segment* s = m->first(); s; s = s->next()) {
+        if (s->written() && !s->extraLeadingSpace().isZero()) {
+            sl.push_back(s);
+        }
+    }
+    return sl;
+}
+
+//---------------------------------------------------------
+//   sync
+//    drop everything if the score was changed since the
+//    cache last looked at the undo stack
+//---------------------------------------------------------
+
+void MeasureWriteCache::sync(Score* score)
+{
+    const int changes = score->undoStack()->changes();
+    if (changes != _undoChanges) {
+        clear();
+        _undoChanges = changes;
+    }
+}
+
+//---------------------------------------------------------
+//   write
+//    write staff staffIdx of m, from the cache if possible
+//---------------------------------------------------------
+
+void MeasureWriteCache::write(XmlWriter& xml, Measure* m, int staffIdx, bool writeSystemElements)
+{
+    const State in(xml);
+    const std::vector<const Segment*> writtenIn = writtenSegments(m);
+    const QPair<const Measure*, int> key(m, staffIdx);
+
+    Entry* e = _entries.value(key);
+    // the first staff resets the flags, see Score::writeSegments()
+    const bool firstStaff = staffIdx == 0;
+    if (e && e->tick == m->tick() && e->endTick == m->endTick() && e->in == in
+        && (firstStaff || e->writtenIn == writtenIn)) {
+        ++_hits;
+        xml << e->text;
+        xml.setCurTick(e->out.curTick);
+        xml.setTickDiff(e->out.tickDiff);
+        xml.setCurTrack(e->out.curTrack);
+        xml.setTrackDiff(e->out.trackDiff);
+        xml.setLinksIndexer(e->out.linksIndexer);
+        for (const auto& p : e->lidLocalIndices) {
+            xml.setLidLocalIndex(p.first, p.second);
+        }
+        if (firstStaff) {
+            for (const Segment* s : writtenIn) {
+                s->setWritten(false);
+            }
+        }
+        for (const Segment* s : e->writtenOut) {
+            s->setWritten(true);
+        }
+        return;
+    }
+
+    ++_misses;
+    if (!e) {
+        e = new Entry(xml);
+        _entries.insert(key, e);
+    }
+    e->tick       = m->tick();
+    e->endTick    = m->endTick();
+    e->in         = in;
+    e->writtenIn  = writtenIn;
+    e->text.clear();
+    e->lidLocalIndices.clear();
+
+    xml.beginFragment(&e->text);
+    xml.setLidLocalIndexLog(&e->lidLocalIndices);
+    m->write(xml, staffIdx, writeSystemElements, false);
+    xml.setLidLocalIndexLog(nullptr);
+    xml.endFragment();
+    xml << e->text;
+
+    e->out        = State(xml);
+    e->writtenOut = writtenSegments(m);
+}
+
+//---------------------------------------------------------
+//   invalidate
+//    drop the measures changed by a command, see
+//    Score::update()
+//---------------------------------------------------------
+
+void MeasureWriteCache::invalidate(Score* score, const CmdState& cs)
+{
+    Fraction stick;
+    Fraction etick;
+    if (cs.changedRange(score->undoStack()->changes(), _undoChanges, stick, etick)) {
+        invalidate(score, stick, etick);
+    }
+}
+
+//---------------------------------------------------------
+//   invalidate
+//    drop the measures overlapping stick - etick, a
+//    negative etick meaning the end of the score
+//---------------------------------------------------------
+
+void MeasureWriteCache::invalidate(Score* score, Fraction stick, Fraction etick)
+{
+    if (_entries.empty()) {
+        return;
+    }
+    if (stick <= Fraction(0, 1) && etick < Fraction(0, 1)) {
+        clear();
+        return;
+    }
+    if (etick < Fraction(0, 1)) {
+        etick = score->lastMeasure() ? score->lastMeasure()->endTick() : Fraction(0, 1);
+    }
+
+    // spanners are written with their start and end element
+    for (auto i : score->spannerMap().findOverlapping(stick.ticks(), etick.ticks())) {
+        Spanner* s = i.value;
+        stick = qMin(stick, s->tick());
+        etick = qMax(etick, s->tick2());
+    }
+    // ties are written with their start note and may end in the next measure
+    if (Measure* m = score->tick2measure(stick)) {
+        if (Measure* pm = m->prevMeasure()) {
+            stick = pm->tick();
+        }
+    }
+    if (Measure* m = score->tick2measure(etick)) {
+        if (Measure* nm = m->nextMeasure()) {
+            etick = nm->endTick();
+        }
+    }
+
+    for (auto i = _entries.begin(); i != _entries.end();) {
+        Entry* e = i.value();
+        if (e->endTick >= stick && e->tick <= etick) {
+            delete e;
+            i = _entries.erase(i);
+        } else {
+            ++i;
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   clear
+//---------------------------------------------------------
+
+void MeasureWriteCache::clear()
+{
+    qDeleteAll(_entries);
+    _entries.clear();
+}
+}     // namespace Ms
@@ -0,0 +1,114 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __MEASUREWRITECACHE_H__
+#define __MEASUREWRITECACHE_H__
+
+#include <vector>
+
+#include <QHash>
+#include <QPair>
+#include <QString>
+
+#include "fraction.h"
+#include "xml.h"
+
+namespace Ms {
+class CmdState;
+class Measure;
+class Score;
+class Segment;
+
+//---------------------------------------------------------
+//   MeasureWriteCache
+//    the xml written for each staff of each measure of a
+//    score by the last save, see Score::writeMovement().
+//
+//    A fragment is used again only if the measure is
+//    clean and the writer is in the same state as when it
+//    was written; the state the fragment left the writer
+//    in is then restored, so that the output is the same
+//    as that of a full write.
+//
+//    Measures are made dirty by tick range:
+//      - by the range of each command, see Score::update(),
+//        extended to the spanners overlapping it and to
+//        the neighbouring measures for ties,
+//      - by the range laid out, as the segments of
+//        spanners are written with their start element,
+//      - entirely, if the undo stack changed without a
+//        range, the style changed or the score was laid
+//        out entirely.
+//---------------------------------------------------------
+
+class MeasureWriteCache
+{
+    struct State {
+        Fraction curTick;
+        Fraction tickDiff;
+        int curTrack;
+        int trackDiff;
+        int level;
+        bool excerptmode;
+        bool writeOmr;
+        bool writeTrack;
+        bool writePosition;
+        bool debugMode;
+        LinksIndexer linksIndexer;
+
+        State(const XmlWriter& xml);
+        bool operator==(const State& s) const;
+        bool operator!=(const State& s) const { return !(*this == s); }
+    };
+
+    struct Entry {
+        Fraction tick;
+        Fraction endTick;
+        State in;
+        State out;
+        QString text;
+        std::vector<std::pair<int, int> > lidLocalIndices;    ///< set while writing
+        std::vector<const Segment*> writtenIn;                ///< segments with leading space written before
+        std::vector<const Segment*> writtenOut;               ///< and after the fragment
+
+        Entry(const XmlWriter& xml)
+            : in(xml), out(xml) {}
+    };
+
+    QHash<QPair<const Measure*, int>, Entry*> _entries;
+    int _undoChanges { -1 };          ///< undo stack changes seen by the cache
+    int _hits        { 0 };
+    int _misses      { 0 };
+
+    static std::vector<const Segment*> writtenSegments(const Measure* m);
+
+public:
+    MeasureWriteCache() = default;
+    MeasureWriteCache(const MeasureWriteCache&) = delete;
+    MeasureWriteCache& operator=(const MeasureWriteCache&) = delete;
+    ~MeasureWriteCache() { clear(); }
+
+    static bool canWrite(const XmlWriter& xml);
+
+    void sync(Score* score);
+    void write(XmlWriter& xml, Measure* m, int staffIdx, bool writeSystemElements);
+
+    void invalidate(Score* score, const CmdState& cs);
+    void invalidate(Score* score, Fraction stick, Fraction etick);
+    void clear();
+
+    int size() const { return _entries.size(); }
+    int hits() const { return _hits; }
+    int misses() const { return _misses; }
+};
+}     // namespace Ms
+#endif
@@ -105,13 +105,17 @@ qreal MScore::nudgeStep;
 qreal MScore::nudgeStep10;
 qreal MScore::nudgeStep50;
 int MScore::defaultPlayDuration;
+size_t MScore::undoMemoryLimit = 512 * 1024 * 1024;
+int MScore::undoDepthLimit     = 0;
 
-QString MScore::lastError;
+thread_local QString MScore::lastError;
 int MScore::division    = 480;     // 3840;   // pulses per quarter note (PPQ) // ticks per beat
 int MScore::sampleRate  = 44100;
 int MScore::mtcType;
 
 bool MScore::noExcerpts = false;
+bool MScore::lazyExcerpts = false;
+int MScore::readThreads = 0;
 bool MScore::noImages = false;
 bool MScore::pdfPrinting = false;
 bool MScore::svgPrinting = false;
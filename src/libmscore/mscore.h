@@ -356,7 +356,10 @@ public:
     static qreal nudgeStep10;
     static qreal nudgeStep50;
     static int defaultPlayDuration;
-    static QString lastError;
+    static thread_local QString lastError;     // scores are read and written on several threads
+
+    static size_t undoMemoryLimit;      // approximate bytes held by the undo stack, 0: unlimited
+    static int undoDepthLimit;          // max number of undo steps, 0: unlimited
 
 // #ifndef NDEBUG
     static bool noHorizontalStretch;
@@ -381,6 +384,8 @@ public:
     static bool noGui;
 
     static bool noExcerpts;
+    static bool lazyExcerpts;     ///< keep part scores to be read when they are first used, see Excerpt::readPartScores()
+    static int readThreads;       ///< threads to read parts and movements on, 0: one per core
     static bool noImages;
 
     static bool pdfPrinting;
@@ -323,6 +323,7 @@ public:
     Note(Score* s = 0);
     Note(const Note&, bool link = false);
     ~Note();
+    MS_POOLED_ELEMENT(Note)
 
     // Score Tree functions
     ScoreElement* treeParent() const override;
@@ -27,6 +27,7 @@ class NoteDot final : public Element
 {
 public:
     NoteDot(Score* = 0);
+    MS_POOLED_ELEMENT(NoteDot)
 
     NoteDot* clone() const override { return new NoteDot(*this); }
     ElementType type() const override { return ElementType::NOTEDOT; }
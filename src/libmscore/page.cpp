@@ -43,7 +43,6 @@ extern QString revision;
 Page::Page(Score* s)
     : Element(s, ElementFlag::NOT_SELECTABLE), _no(0)
 {
-    bspTreeValid = false;
 }
 
 Page::~Page()
@@ -57,10 +56,13 @@ Page::~Page()
 QList<Element*> Page::items(const QRectF& r)
 {
 #ifdef USE_BSP
-    if (!bspTreeValid) {
-        doRebuildBspTree();
+    QList<Element*> el;
+    for (System* s : qAsConst(_systems)) {
+        el.append(s->items(r));
+    }
+    if ((visible() || score()->showInvisible()) && pageBoundingRect().intersects(r)) {
+        el.append(this);
     }
-    QList<Element*> el = bspTree.items(r);
     return el;
 #else
     Q_UNUSED(r)
@@ -71,16 +73,32 @@ QList<Element*> Page::items(const QRectF& r)
 QList<Element*> Page::items(const QPointF& p)
 {
 #ifdef USE_BSP
-    if (!bspTreeValid) {
-        doRebuildBspTree();
+    QList<Element*> el;
+    for (System* s : qAsConst(_systems)) {
+        el.append(s->items(p));
     }
-    return bspTree.items(p);
+    if ((visible() || score()->showInvisible()) && contains(p)) {
+        el.append(this);
+    }
+    return el;
 #else
     Q_UNUSED(p)
     return QList<Element*>();
 #endif
 }
 
+//---------------------------------------------------------
+//   rebuildBspTree
+//    invalidate the spatial index of all systems
+//---------------------------------------------------------
+
+void Page::rebuildBspTree()
+{
+    for (System* s : qAsConst(_systems)) {
+        s->rebuildBspTree();
+    }
+}
+
 //---------------------------------------------------------
 //   appendSystem
 //---------------------------------------------------------
@@ -232,53 +250,6 @@ void Page::scanElements(void* data, void (* func)(void*, Element*), bool all)
     }
 }
 
-#ifdef USE_BSP
-//---------------------------------------------------------
-//   bspInsert
-//---------------------------------------------------------
-
-static void bspInsert(void* bspTree, Element* e)
-{
-    ((BspTree*)bspTree)->insert(e);
-}
-
-static void countElements(void* data, Element* /*e*/)
-{
-    ++(*(int*)data);
-}
-
-//---------------------------------------------------------
-//   doRebuildBspTree
-//---------------------------------------------------------
-
-void Page::doRebuildBspTree()
-{
-    int n = 0;
-    scanElements(&n, countElements, false);
-
-    QRectF r;
-    if (score()->layoutMode() == LayoutMode::LINE) {
-        qreal w = 0.0;
-        qreal h = 0.0;
-        if (!_systems.empty()) {
-            h = _systems.front()->height();
-            if (!_systems.front()->measures().empty()) {
-                MeasureBase* mb = _systems.front()->measures().back();
-                w = mb->x() + mb->width();
-            }
-        }
-        r = QRectF(0.0, 0.0, w, h);
-    } else {
-        r = abbox();
-    }
-
-    bspTree.initialize(r, n);
-    scanElements(&bspTree, &bspInsert, false);
-    bspTreeValid = true;
-}
-
-#endif
-
 //---------------------------------------------------------
 //   replaceTextMacros
 //   (keep in sync with toolTipHeaderFooter in EditStyle::EditStyle())
@@ -15,7 +15,6 @@
 
 #include "config.h"
 #include "element.h"
-#include "bsp.h"
 
 namespace Ms {
 class System;
@@ -34,11 +33,6 @@ class Page final : public Element
 {
     QList<System*> _systems;
     int _no;                        // page number
-#ifdef USE_BSP
-    BspTree bspTree;
-    void doRebuildBspTree();
-#endif
-    bool bspTreeValid;
 
     QString replaceTextMacros(const QString&) const;
     void drawHeaderFooter(QPainter*, int area, const QString&) const;
@@ -76,7 +70,7 @@ public:
 
     QList<Element*> items(const QRectF& r);
     QList<Element*> items(const QPointF& p);
-    void rebuildBspTree() { bspTreeValid = false; }
+    void rebuildBspTree();
     QPointF pagePos() const override { return QPointF(); }       ///< position in page coordinates
     QList<Element*> elements();                 ///< list of visible elements
     QRectF tbbox();                             // tight bounding box, excluding white space
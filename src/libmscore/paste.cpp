@@ -38,6 +38,7 @@
 #include "slur.h"
 #include "articulation.h"
 #include "sig.h"
+#include "staffclipboard.h"
 #include "undo.h"
 
 namespace Ms {
@@ -76,6 +77,61 @@ static void transposeChord(Chord* c, Interval srcTranspose, const Fraction& tick
     }
 }
 
+//---------------------------------------------------------
+//   fitPastedChordRest
+//    prepare the last chord rest of a pasted track for
+//    the gap made by makeGap1()
+//---------------------------------------------------------
+
+static void fitPastedChordRest(Score* score, ChordRest* cr, const Fraction& tick, const Fraction& dstTick,
+                               const Fraction& tickLen)
+{
+    // delete pending ties, they are not selected when copy
+    if ((tick - dstTick) + cr->actualTicks() >= tickLen) {
+        if (cr->isChord()) {
+            Chord* c = toChord(cr);
+            for (Note* note: c->notes()) {
+                Tie* tie = note->tieFor();
+                if (tie) {
+                    note->setTieFor(0);
+                    delete tie;
+                }
+            }
+        }
+    }
+    // shorten last cr to fit in the space made by makeGap
+    if ((tick - dstTick) + cr->actualTicks() > tickLen) {
+        Fraction newLength = tickLen - (tick - dstTick);
+        // check previous CR on same track, if it has tremolo, delete the tremolo
+        // we don't want a tremolo and two different chord durations
+        if (cr->isChord()) {
+            Segment* s = score->tick2leftSegment(tick - Fraction::fromTicks(1));
+            if (s) {
+                ChordRest* crt = toChordRest(s->element(cr->track()));
+                if (!crt) {
+                    crt = s->nextChordRest(cr->track(), true);
+                }
+                if (crt && crt->isChord()) {
+                    Chord* chrt = toChord(crt);
+                    Tremolo* tr = chrt->tremolo();
+                    if (tr) {
+                        tr->setChords(chrt, toChord(cr));
+                        chrt->remove(tr);
+                        delete tr;
+                    }
+                }
+            }
+        }
+        if (!cr->tuplet()) {
+            // shorten duration
+            // exempt notes in tuplets, since we don't allow copy of partial tuplet anyhow
+            // TODO: figure out a reasonable fudge factor to make sure shorten tuplets appropriately if we do ever copy a partial tuplet
+            cr->setTicks(newLength);
+            cr->setDurationType(newLength);
+        }
+    }
+}
+
 //---------------------------------------------------------
 //   pasteStaff
 //    return false if paste fails
@@ -287,50 +343,7 @@ bool Score::pasteStaff(XmlReader& e, Segment* dst, int dstStaff, Fraction scale)
                             }
                             graceNotes.clear();
                         }
-                        // delete pending ties, they are not selected when copy
-                        if ((tick - dstTick) + cr->actualTicks() >= tickLen) {
-                            if (cr->isChord()) {
-                                Chord* c = toChord(cr);
-                                for (Note* note: c->notes()) {
-                                    Tie* tie = note->tieFor();
-                                    if (tie) {
-                                        note->setTieFor(0);
-                                        delete tie;
-                                    }
-                                }
-                            }
-                        }
-                        // shorten last cr to fit in the space made by makeGap
-                        if ((tick - dstTick) + cr->actualTicks() > tickLen) {
-                            Fraction newLength = tickLen - (tick - dstTick);
-                            // check previous CR on same track, if it has tremolo, delete the tremolo
-                            // we don't want a tremolo and two different chord durations
-                            if (cr->isChord()) {
-                                Segment* s = tick2leftSegment(tick - Fraction::fromTicks(1));
-                                if (s) {
-                                    ChordRest* crt = toChordRest(s->element(cr->track()));
-                                    if (!crt) {
-                                        crt = s->nextChordRest(cr->track(), true);
-                                    }
-                                    if (crt && crt->isChord()) {
-                                        Chord* chrt = toChord(crt);
-                                        Tremolo* tr = chrt->tremolo();
-                                        if (tr) {
-                                            tr->setChords(chrt, toChord(cr));
-                                            chrt->remove(tr);
-                                            delete tr;
-                                        }
-                                    }
-                                }
-                            }
-                            if (!cr->tuplet()) {
-                                // shorten duration
-                                // exempt notes in tuplets, since we don't allow copy of partial tuplet anyhow
-                                // TODO: figure out a reasonable fudge factor to make sure shorten tuplets appropriately if we do ever copy a partial tuplet
-                                cr->setTicks(newLength);
-                                cr->setDurationType(newLength);
-                            }
-                        }
+                        fitPastedChordRest(this, cr, tick, dstTick, tickLen);
                         pasteChordRest(cr, tick, e.transpose());
                     }
                 } else if (tag == "Spanner") {
@@ -485,8 +498,19 @@ bool Score::pasteStaff(XmlReader& e, Segment* dst, int dstStaff, Fraction scale)
         }
     }
 
+    finishPasteStaff(dstTick, tickLen, dstStaff, staves, pasted);
+    return true;
+}
+
+//---------------------------------------------------------
+//   finishPasteStaff
+//    connect the pasted ties and select the pasted range
+//---------------------------------------------------------
+
+void Score::finishPasteStaff(const Fraction& dstTick, const Fraction& tickLen, int dstStaff, int staves, bool pasted)
+{
     for (Score* s : scoreList()) {     // for all parts
-        s->connectTies();
+        s->connectTies(dstTick, dstTick + tickLen);
     }
 
     if (pasted) {                         //select only if we pasted something
@@ -532,6 +556,100 @@ bool Score::pasteStaff(XmlReader& e, Segment* dst, int dstStaff, Fraction scale)
             _selection.setState(SelState::RANGE);
         }
     }
+}
+
+//---------------------------------------------------------
+//   pasteStaff
+//    paste a range copied from this score without going
+//    through xml, see StaffClipboard
+//    return false if paste fails
+//---------------------------------------------------------
+
+bool Score::pasteStaff(const StaffClipboard& clipboard, Segment* dst, int dstStaff, Fraction scale)
+{
+    Q_ASSERT(dst->isChordRestType());
+
+    Fraction dstTick = dst->tick();
+    Fraction tickLen = clipboard._tickLen * scale;
+    bool pasted = false;
+    bool doScale = (scale != Fraction(1, 1));
+    int trackOffset = (dstStaff - clipboard._staffStart) * VOICES;
+
+    for (const StaffClipboard::StaffData& sd : clipboard._staffData) {
+        int dstStaffIdx = sd.srcStaffIdx + dstStaff - clipboard._staffStart;
+        if (dstStaffIdx >= nstaves()) {
+            qDebug("paste beyond staves");
+            break;
+        }
+        pasted = true;
+        int voiceOffset[VOICES];
+        std::copy(sd.voiceOffset, sd.voiceOffset + VOICES, voiceOffset);
+        if (!makeGap1(dstTick, dstStaffIdx, tickLen, voiceOffset)) {
+            qDebug("cannot make gap in staff %d at tick %d", dstStaffIdx, dstTick.ticks());
+            break;
+        }
+
+        std::vector<Tie*> ties(sd.ties.size(), nullptr);
+        for (const StaffClipboard::Item& item : sd.items) {
+            Fraction tick = dstTick + item.rtick * scale;
+            int track = item.track + trackOffset;
+
+            if (!item.element->isChordRest()) {
+                Element* el = item.element->clone();
+                el->setTrack(track);
+                Measure* m = tick2measure(tick);
+                Segment* seg = m->undoGetSegment(SegmentType::ChordRest, tick);
+                el->setParent(seg);
+                undoAddElement(el);
+                continue;
+            }
+
+            ChordRest* cr = toChordRest(item.element->clone());
+            cr->setTrack(track);
+            // no paste into local time signature
+            if (staff(dstStaffIdx)->isLocalTimeSignature(tick)) {
+                MScore::setError(DEST_LOCAL_TIME_SIGNATURE);
+                delete cr;
+                return false;
+            }
+            if (tick2measure(tick)->isMeasureRepeatGroup(dstStaffIdx)) {
+                MeasureRepeat* mr = tick2measure(tick)->measureRepeatElement(dstStaffIdx);
+                score()->deleteItem(mr);    // resets any measures related to mr
+            }
+            if (doScale) {
+                Fraction d = cr->durationTypeTicks();
+                cr->setTicks(cr->ticks() * scale);
+                cr->setDurationType(d * scale);
+                for (Lyrics* l : cr->lyrics()) {
+                    l->setTicks(l->ticks() * scale);
+                }
+            }
+            if (cr->isChord()) {
+                Chord* chord = toChord(cr);
+                for (Chord* gc : chord->graceNotes()) {
+                    transposeChord(gc, sd.transpose, tick);
+                }
+                for (int i : item.tiesEnded) {
+                    Tie* tie = ties[i];
+                    if (tie) {
+                        Note* note = chord->notes()[sd.ties[i].endNote];
+                        tie->setEndNote(note);
+                        note->setTieBack(tie);
+                    }
+                }
+            }
+            fitPastedChordRest(this, cr, tick, dstTick, tickLen);
+            if (cr->isChord()) {
+                // remember the tie itself, pasteChordRest() may move it to a split off chord
+                for (int i : item.tiesStarted) {
+                    ties[i] = toChord(cr)->notes()[sd.ties[i].startNote]->tieFor();
+                }
+            }
+            pasteChordRest(cr, tick, sd.transpose);
+        }
+    }
+
+    finishPasteStaff(dstTick, tickLen, dstStaff, clipboard._staves, pasted);
     return true;
 }
 
@@ -1112,10 +1230,16 @@ void Score::cmdPaste(const QMimeData* ms, MuseScoreView* view, Fraction scale)
             if (MScore::debugMode) {
                 qDebug("paste <%s>", data.data());
             }
-            XmlReader e(data);
-            e.setPasteMode(true);
-            if (!pasteStaff(e, cr->segment(), cr->staffIdx(), scale)) {
-                return;
+            if (const StaffClipboard* clipboard = StaffClipboard::find(this, data)) {
+                if (!pasteStaff(*clipboard, cr->segment(), cr->staffIdx(), scale)) {
+                    return;
+                }
+            } else {
+                XmlReader e(data);
+                e.setPasteMode(true);
+                if (!pasteStaff(e, cr->segment(), cr->staffIdx(), scale)) {
+                    return;
+                }
             }
         }
     } else if (ms->hasFormat(mimeSymbolListFormat)) {
@@ -14,6 +14,11 @@
 //  algorithmus from Emilios Cambouropoulos as published in:
 //  "Automatic Pitch Spelling: From Numbers to Sharps and Flats"
 
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <thread>
+
 #include "note.h"
 #include "key.h"
 #include "pitchspelling.h"
@@ -22,6 +27,7 @@
 #include "score.h"
 #include "part.h"
 #include "utils.h"
+#include "concurrent.h"
 
 #include "framework/midi_old/event.h"
 
@@ -692,12 +698,16 @@ void changeAllTpcs(Note* n, int tpc1)
 }
 
 //---------------------------------------------------------
-//   spell
+//   spellTpcsWindowed
+//    the sliding window spelling spellNotelist() used
+//    before spellTpcs(), kept to compare against; -1 for
+//    notes it does not respell
 //---------------------------------------------------------
 
-void Score::spellNotelist(std::vector<Note*>& notes)
+std::vector<int> spellTpcsWindowed(const std::vector<Note*>& notes)
 {
     int n = int(notes.size());
+    std::vector<int> tpcs(n, -1);
 
     int start = 0;
     while (start < n) {
@@ -715,18 +725,18 @@ void Score::spellNotelist(std::vector<Note*>& notes)
         }
 
         if (start == 0) {
-            changeAllTpcs(notes[0], tab[(notes[0]->pitch() % 12) * 2 + (opt & 1)]);
+            tpcs[0] = tab[(notes[0]->pitch() % 12) * 2 + (opt & 1)];
             if (n > 1) {
-                changeAllTpcs(notes[1], tab[(notes[1]->pitch() % 12) * 2 + ((opt & 2) >> 1)]);
+                tpcs[1] = tab[(notes[1]->pitch() % 12) * 2 + ((opt & 2) >> 1)];
             }
             if (n > 2) {
-                changeAllTpcs(notes[2], tab[(notes[2]->pitch() % 12) * 2 + ((opt & 4) >> 2)]);
+                tpcs[2] = tab[(notes[2]->pitch() % 12) * 2 + ((opt & 4) >> 2)];
             }
         }
         if ((end - start) >= 6) {
-            changeAllTpcs(notes[start + 3], tab[(notes[start + 3]->pitch() % 12) * 2 + ((opt & 8) >> 3)]);
-            changeAllTpcs(notes[start + 4], tab[(notes[start + 4]->pitch() % 12) * 2 + ((opt & 16) >> 4)]);
-            changeAllTpcs(notes[start + 5], tab[(notes[start + 5]->pitch() % 12) * 2 + ((opt & 32) >> 5)]);
+            tpcs[start + 3] = tab[(notes[start + 3]->pitch() % 12) * 2 + ((opt & 8) >> 3)];
+            tpcs[start + 4] = tab[(notes[start + 4]->pitch() % 12) * 2 + ((opt & 16) >> 4)];
+            tpcs[start + 5] = tab[(notes[start + 5]->pitch() % 12) * 2 + ((opt & 32) >> 5)];
         }
         if (end == n) {
             int n1 = end - start;
@@ -734,21 +744,166 @@ void Score::spellNotelist(std::vector<Note*>& notes)
             switch (n1 - 6) {
             case 3:
                 k = end - start - 3;
-                changeAllTpcs(notes[end - 3], tab[(notes[end - 3]->pitch() % 12) * 2 + ((opt & (1 << k)) >> k)]);
+                tpcs[end - 3] = tab[(notes[end - 3]->pitch() % 12) * 2 + ((opt & (1 << k)) >> k)];
                 Q_FALLTHROUGH();
             case 2:
                 k = end - start - 2;
-                changeAllTpcs(notes[end - 2], tab[(notes[end - 2]->pitch() % 12) * 2 + ((opt & (1 << k)) >> k)]);
+                tpcs[end - 2] = tab[(notes[end - 2]->pitch() % 12) * 2 + ((opt & (1 << k)) >> k)];
                 Q_FALLTHROUGH();
             case 1:
                 k = end - start - 1;
-                changeAllTpcs(notes[end - 1], tab[(notes[end - 1]->pitch() % 12) * 2 + ((opt & (1 << k)) >> k)]);
+                tpcs[end - 1] = tab[(notes[end - 1]->pitch() % 12) * 2 + ((opt & (1 << k)) >> k)];
             }
             break;
         }
         // advance to next window
         start += 3;
     }
+    return tpcs;
+}
+
+//---------------------------------------------------------
+//   spellingKey
+//    key of note as index into enharmonicSpelling
+//---------------------------------------------------------
+
+static int spellingKey(const Note* note)
+{
+    Fraction tick = note->chord()->tick();
+    int k = int(note->staff()->key(tick)) + 7;
+    if (k < 0 || k > 14) {
+        qDebug("illegal key at tick %d: %d", tick.ticks(), k - 7);
+        return 7;
+    }
+    return k;
+}
+
+//---------------------------------------------------------
+//   spellTpcs
+//    spell notes by the minimum sum of penalty() over all
+//    pairs of neighbouring notes.
+//
+//    The penalty of a note only depends on the spelling of
+//    the previous note, so a Viterbi search with the
+//    spelling of the last note as state finds the best
+//    spelling of the whole list in linear time. Each note
+//    can be spelled with the entries of tab1 and tab2 for
+//    its pitch; ties go to the first of them.
+//---------------------------------------------------------
+
+std::vector<int> spellTpcs(const std::vector<Note*>& notes)
+{
+    static const int STATES = 4;
+    const int n = int(notes.size());
+    std::vector<int> tpcs(n, -1);
+    if (n == 0) {
+        return tpcs;
+    }
+
+    // candidate spellings of each note, unused entries -1
+    std::vector<std::array<int, STATES> > lof(n);
+    // predecessor state of each state
+    std::vector<std::array<signed char, STATES> > prev(n);
+    std::array<int, STATES> cost;
+    std::array<int, STATES> nextCost;
+
+    for (int i = 0; i < n; ++i) {
+        int l = (notes[i]->pitch() % 12) * 2;
+        const int spellings[STATES] = { tab1[l], tab1[l + 1], tab2[l], tab2[l + 1] };
+        int k = 0;
+        for (int t : spellings) {
+            if (std::find(lof[i].begin(), lof[i].begin() + k, t) == lof[i].begin() + k) {
+                lof[i][k++] = t;
+            }
+        }
+        for (; k < STATES; ++k) {
+            lof[i][k] = -1;
+        }
+    }
+
+    for (int s = 0; s < STATES; ++s) {
+        cost[s] = lof[0][s] == -1 ? INT_MAX : 0;
+    }
+    for (int i = 1; i < n; ++i) {
+        int key = spellingKey(notes[i]);
+        for (int s = 0; s < STATES; ++s) {
+            nextCost[s] = INT_MAX;
+            prev[i][s]  = -1;
+            if (lof[i][s] == -1) {
+                continue;
+            }
+            for (int ps = 0; ps < STATES; ++ps) {
+                if (cost[ps] == INT_MAX) {
+                    continue;
+                }
+                int c = cost[ps] + penalty(lof[i - 1][ps], lof[i][s], key);
+                if (c < nextCost[s]) {
+                    nextCost[s] = c;
+                    prev[i][s]  = ps;
+                }
+            }
+        }
+        cost = nextCost;
+    }
+
+    int s = int(std::min_element(cost.begin(), cost.end()) - cost.begin());
+    for (int i = n - 1; i >= 0; --i) {
+        tpcs[i] = lof[i][s];
+        if (i > 0) {
+            s = prev[i][s];
+        }
+    }
+    return tpcs;
+}
+
+//---------------------------------------------------------
+//   spellingPenalty
+//    the sum minimized by spellTpcs() for the spelling
+//    tpcs of notes
+//---------------------------------------------------------
+
+int spellingPenalty(const std::vector<Note*>& notes, const std::vector<int>& tpcs)
+{
+    int p = 0;
+    for (int i = 1; i < int(notes.size()); ++i) {
+        p += penalty(tpcs[i - 1], tpcs[i], spellingKey(notes[i]));
+    }
+    return p;
+}
+
+//---------------------------------------------------------
+//   spell
+//---------------------------------------------------------
+
+void Score::spellNotelist(std::vector<Note*>& notes)
+{
+    std::vector<int> tpcs = spellTpcs(notes);
+    for (int i = 0; i < int(notes.size()); ++i) {
+        changeAllTpcs(notes[i], tpcs[i]);
+    }
+}
+
+//---------------------------------------------------------
+//   spellNotelists
+//    spell each list on its own; the spellings are
+//    computed on several threads and applied in order
+//---------------------------------------------------------
+
+void Score::spellNotelists(const std::vector<std::vector<Note*> >& lists)
+{
+    const int n = int(lists.size());
+    std::vector<std::vector<int> > tpcs(n);
+    int threads = qMin(n, int(std::thread::hardware_concurrency()));
+
+    forEachConcurrently(n, threads, [&](int i) {
+        tpcs[i] = spellTpcs(lists[i]);
+    });
+
+    for (int i = 0; i < n; ++i) {
+        for (int k = 0; k < int(lists[i].size()); ++k) {
+            changeAllTpcs(lists[i][k], tpcs[i][k]);
+        }
+    }
 }
 
 //---------------------------------------------------------
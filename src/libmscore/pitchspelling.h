@@ -79,6 +79,9 @@ extern int pitch2tpc(int pitch, Key, Prefer prefer);
 
 extern int computeWindow(const std::vector<Note*>& notes, int start, int end);
 extern int tpc(int idx, int pitch, int opt);
+extern std::vector<int> spellTpcs(const std::vector<Note*>& notes);
+extern std::vector<int> spellTpcsWindowed(const std::vector<Note*>& notes);
+extern int spellingPenalty(const std::vector<Note*>& notes, const std::vector<int>& tpcs);
 extern QString tpc2name(int tpc, NoteSpellingType spelling, NoteCaseType noteCase, bool explicitAccidental = false);
 extern void tpc2name(int tpc, NoteSpellingType noteSpelling, NoteCaseType noteCase, QString& s, QString& acc,
                      bool explicitAccidental = false);
@@ -10,6 +10,11 @@
 //  the file LICENSE.GPL
 //=============================================================================
 
+#include <thread>
+
+#include <QFontDatabase>
+#include <QXmlStreamWriter>
+
 #include "xml.h"
 #include "score.h"
 #include "staff.h"
@@ -23,15 +28,215 @@
 #include "barline.h"
 #include "excerpt.h"
 #include "spanner.h"
+#include "linkstage.h"
+#include "concurrent.h"
 
 namespace Ms {
 //---------------------------------------------------------
+//   Subtree
+//    a copy of the element a reader is at, with everything
+//    it contains, to be read by another reader
+//---------------------------------------------------------
+
+struct Subtree {
+    QByteArray data;
+    qint64 line;          ///< line of the element in the file
+    QString name;         ///< text of its <name> child
+
+    Subtree(XmlReader& e);
+};
+
+Subtree::Subtree(XmlReader& e)
+    : line(e.lineNumber() - 1)
+{
+    QXmlStreamWriter w(&data);
+    w.writeCurrentToken(e);
+    bool inName = false;
+    for (int depth = 1; depth > 0 && !e.atEnd();) {
+        e.readNext();
+        if (e.isStartElement()) {
+            inName = ++depth == 2 && e.name() == "name";
+        } else if (e.isEndElement()) {
+            --depth;
+            inName = false;
+        } else if (inName && e.isCharacters()) {
+            name += e.text();
+        }
+        w.writeCurrentToken(e);
+    }
+}
+
+//---------------------------------------------------------
+//   maxReadThreads
+//    the number of threads the part scores and movements
+//    of a file may be read on, see MScore::readThreads
+//---------------------------------------------------------
+
+static int maxReadThreads()
+{
+    if (!QFontDatabase::supportsThreadedFontRendering()) {
+        return 1;
+    }
+    return MScore::readThreads > 0 ? MScore::readThreads : int(std::thread::hardware_concurrency());
+}
+
+//---------------------------------------------------------
+//   readError
+//---------------------------------------------------------
+
+static QString readError(const XmlReader& e)
+{
+    if (e.error() == QXmlStreamReader::CustomError) {
+        return e.errorString();
+    }
+    return QObject::tr("XML read error at line %1, column %2: %3").arg(e.lineNumber() + e.offsetLines()).arg(
+        e.columnNumber()).arg(e.name().toString());
+}
+
+//---------------------------------------------------------
+//   readPartsConcurrently
+//    read the part scores kept by Excerpt::setPartData();
+//    every part is read on a worker thread by its own
+//    reader, which starts with the links of the master
+//    score, and links its elements through a LinkStage.
+//    The stages are merged in the order of parts.
+//    return the read error of every part
+//---------------------------------------------------------
+
+static std::vector<QXmlStreamReader::Error> readPartsConcurrently(MasterScore* m, const std::vector<Excerpt*>& parts,
+                                                                  std::vector<QString>& messages)
+{
+    const int n = int(parts.size());
+    std::vector<LinkStage> stages(n);
+    std::vector<QXmlStreamReader::Error> errors(n, QXmlStreamReader::NoError);
+    messages.assign(n, QString());
+
+    forEachConcurrently(n, maxReadThreads(), [&](int i) {
+        LinkStage::Scope scope(&stages[i]);
+        errors[i] = parts[i]->readPartData(messages[i]);
+    });
+
+    for (LinkStage& stage : stages) {
+        stage.merge(m);
+    }
+    return errors;
+}
+
+//---------------------------------------------------------
+//   readParts
+//    read the part scores of m kept while e read it
+//    return false on error
+//---------------------------------------------------------
+
+static bool readParts(MasterScore* m, XmlReader& e, const std::vector<Excerpt*>& parts)
+{
+    std::vector<QString> messages;
+    const std::vector<QXmlStreamReader::Error> errors = readPartsConcurrently(m, parts, messages);
+
+    bool ok = true;
+    for (size_t i = 0; i < parts.size(); ++i) {
+        m->addExcerpt(parts[i]);
+        if (ok && errors[i] != QXmlStreamReader::NoError) {
+            ok = false;
+            MScore::lastError = messages[i];
+            if (errors[i] == QXmlStreamReader::CustomError) {
+                e.raiseError(messages[i]);
+            }
+        }
+    }
+    return ok;
+}
+
+//---------------------------------------------------------
+//   readPartData
+//    read the part score kept by setPartData(), on the
+//    thread of the caller
+//    return the read error and set message to its text
+//---------------------------------------------------------
+
+QXmlStreamReader::Error Excerpt::readPartData(QString& message)
+{
+    XmlReader e(_partData, _docName);
+    e.setOffsetLines(_partLine);
+    e.staffLinkedElements() = _masterLinks;
+    _partData.clear();
+    _masterLinks.clear();
+    _parts.clear();           // set from the staves read, see MasterScore::setExcerptParts()
+
+    QXmlStreamReader::Error error = QXmlStreamReader::NoError;
+    e.readNextStartElement();
+    if (!_partScore->read(e)) {
+        error   = e.error();
+        message = readError(e);
+    }
+    _tracks = e.tracks();
+    return error;
+}
+
+//---------------------------------------------------------
+//   readPartScores
+//    read and lay out the part scores of excerpts which
+//    are not read yet, see MScore::lazyExcerpts. The links
+//    of the master score must still be the ones it was
+//    read with: the edits which may change the elements
+//    of a part read it first, see Score::startCmd().
+//---------------------------------------------------------
+
+void Excerpt::readPartScores(const QList<Excerpt*>& excerpts)
+{
+    std::vector<Excerpt*> parts;
+    for (Excerpt* ex : excerpts) {
+        if (!ex->isPartScoreRead()) {
+            parts.push_back(ex);
+        }
+    }
+    if (parts.empty()) {
+        return;
+    }
+
+    MasterScore* m = parts.front()->oscore();
+    std::vector<QString> messages;
+    std::vector<QXmlStreamReader::Error> errors;
+    {
+        ScoreLoad sl;
+        errors = readPartsConcurrently(m, parts, messages);
+    }
+    for (size_t i = 0; i < parts.size(); ++i) {
+        if (errors[i] != QXmlStreamReader::NoError) {
+            qWarning("Excerpt::readPartScores: %s", qPrintable(messages[i]));
+        }
+        m->setExcerptParts(parts[i]);
+    }
+    m->rebuildMidiMapping();
+    m->updateChannel();
+
+    for (Excerpt* ex : parts) {
+        ex->partScore()->setLayoutAll();
+        ex->partScore()->doLayout();
+    }
+}
+
+//---------------------------------------------------------
+//   readConcurrently
+//    true while a part score is read on a worker thread,
+//    see readParts(); the master score is then only read
+//---------------------------------------------------------
+
+bool Score::readConcurrently() const
+{
+    return !isMaster() && LinkStage::current();
+}
+//---------------------------------------------------------
 //   read
 //    return false on error
 //---------------------------------------------------------
 
 bool Score::read(XmlReader& e)
 {
+    // the part scores of a master score are read after it
+    std::vector<Excerpt*> parts;
+    const bool concurrentParts = isMaster() && maxReadThreads() > 1;
+
     while (e.readNextStartElement()) {
         e.setTrack(-1);
         const QStringRef& tag(e.name());
@@ -43,7 +248,10 @@ bool Score::read(XmlReader& e)
             _audio = new Audio;
             _audio->read(e);
         } else if (tag == "showOmr") {
-            masterScore()->setShowOmr(e.readInt());
+            bool showOmr = e.readInt();
+            if (!readConcurrently()) {
+                masterScore()->setShowOmr(showOmr);
+            }
         } else if (tag == "playMode") {
             _playMode = PlayMode(e.readInt());
         } else if (tag == "LayerTag") {
@@ -150,10 +358,21 @@ bool Score::read(XmlReader& e)
                 Excerpt* ex    = new Excerpt(m);
 
                 ex->setPartScore(s);
-                e.setLastMeasure(nullptr);
-                s->read(e);
-                ex->setTracks(e.tracks());
-                m->addExcerpt(ex);
+                if (MScore::lazyExcerpts) {
+                    Subtree t(e);
+                    ex->setTitle(t.name);
+                    ex->setPartData(e, t.data, t.line);
+                    m->excerpts().append(ex);
+                } else if (concurrentParts) {
+                    Subtree t(e);
+                    ex->setPartData(e, t.data, t.line);
+                    parts.push_back(ex);
+                } else {
+                    e.setLastMeasure(nullptr);
+                    s->read(e);
+                    ex->setTracks(e.tracks());
+                    m->addExcerpt(ex);
+                }
             }
         } else if (tag == "name") {
             QString n = e.readElementText();
@@ -173,17 +392,15 @@ bool Score::read(XmlReader& e)
             e.unknown();
         }
     }
+    if (!parts.empty() && !readParts(masterScore(), e, parts)) {
+        return false;
+    }
     e.reconnectBrokenConnectors();
     if (e.error() != QXmlStreamReader::NoError) {
         qDebug("%s: xml read error at line %lld col %lld: %s",
-               qPrintable(e.getDocName()), e.lineNumber(), e.columnNumber(),
+               qPrintable(e.getDocName()), e.lineNumber() + e.offsetLines(), e.columnNumber(),
                e.name().toUtf8().data());
-        if (e.error() == QXmlStreamReader::CustomError) {
-            MScore::lastError = e.errorString();
-        } else {
-            MScore::lastError = QObject::tr("XML read error at line %1, column %2: %3").arg(e.lineNumber()).arg(
-                e.columnNumber()).arg(e.name().toString());
-        }
+        MScore::lastError = readError(e);
         return false;
     }
 
@@ -246,7 +463,7 @@ bool Score::read(XmlReader& e)
     }
 #endif
 
-    if (!masterScore()->omr()) {
+    if (!masterScore()->omr() && !readConcurrently()) {
         masterScore()->setShowOmr(false);
     }
 
@@ -256,8 +473,10 @@ bool Score::read(XmlReader& e)
         p->updateHarmonyChannels(false);
     }
 
-    masterScore()->rebuildMidiMapping();
-    masterScore()->updateChannel();
+    if (!readConcurrently()) {     // else done once all parts are read
+        masterScore()->rebuildMidiMapping();
+        masterScore()->updateChannel();
+    }
 
 //      createPlayEvents();
     return true;
@@ -305,6 +524,10 @@ void MasterScore::addMovement(MasterScore* score)
 Score::FileError MasterScore::read301(XmlReader& e)
 {
     bool top = true;
+    // the movements after the first one are independent scores, read after it
+    std::vector<std::pair<MasterScore*, Subtree> > movements;
+    const bool concurrentMovements = maxReadThreads() > 1;
+
     while (e.readNextStartElement()) {
         const QStringRef& tag(e.name());
         if (tag == "programVersion") {
@@ -321,6 +544,10 @@ Score::FileError MasterScore::read301(XmlReader& e)
                 score = new MasterScore();
                 score->setMscVersion(mscVersion());
                 addMovement(score);
+                if (concurrentMovements) {
+                    movements.emplace_back(score, Subtree(e));
+                    continue;
+                }
             }
             if (!score->read(e)) {
                 if (e.error() == QXmlStreamReader::CustomError) {
@@ -334,6 +561,27 @@ Score::FileError MasterScore::read301(XmlReader& e)
             revisions()->add(revision);
         }
     }
+
+    const int n = int(movements.size());
+    std::vector<FileError> errors(n, FileError::FILE_NO_ERROR);
+    std::vector<QString> messages(n);
+    forEachConcurrently(n, maxReadThreads(), [&](int i) {
+        const Subtree& t = movements[i].second;
+        XmlReader r(t.data, e.getDocName());
+        r.setOffsetLines(t.line);
+        r.readNextStartElement();
+        if (!movements[i].first->read(r)) {
+            errors[i] = r.error() == QXmlStreamReader::CustomError ? FileError::FILE_CRITICALLY_CORRUPTED
+                        : FileError::FILE_BAD_FORMAT;
+            messages[i] = readError(r);
+        }
+    });
+    for (int i = 0; i < n; ++i) {
+        if (errors[i] != FileError::FILE_NO_ERROR) {
+            MScore::lastError = messages[i];
+            return errors[i];
+        }
+    }
     return FileError::FILE_NO_ERROR;
 }
 }
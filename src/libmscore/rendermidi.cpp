@@ -2279,6 +2279,19 @@ void Score::createGraceNotesPlayEvents(const Fraction& tick, Chord* chord, int&
 //---------------------------------------------------------
 
 void Score::createPlayEvents(Chord* chord)
+{
+    QList<NoteEventList> el = defaultPlayEvents(chord);
+    if (chord->playEventType() == PlayEventType::Auto) {
+        chord->setNoteEventLists(el);
+    }
+    // don't change event list if type is PlayEventType::User
+}
+
+//---------------------------------------------------------
+//   defaultPlayEvents
+//---------------------------------------------------------
+
+QList<NoteEventList> Score::defaultPlayEvents(Chord* chord)
 {
     int gateTime = 100;
 
@@ -2314,18 +2327,40 @@ void Score::createPlayEvents(Chord* chord)
     //
     //    render normal (and articulated) chords
     //
-    QList<NoteEventList> el = renderChord(chord, gateTime, ontime, trailtime);
-    if (chord->playEventType() == PlayEventType::Auto) {
-        chord->setNoteEventLists(el);
-    }
-    // don't change event list if type is PlayEventType::User
+    return renderChord(chord, gateTime, ontime, trailtime);
 }
 
+//---------------------------------------------------------
+//   createPlayEvents
+//    create the play events of the measures from start
+//    up to end, skipping the measures which are still up
+//    to date. Without arguments all play events are
+//    created anew.
+//---------------------------------------------------------
+
 void Score::createPlayEvents(Measure const* start, Measure const* const end)
 {
+    if (!start && !end) {
+        invalidatePlayEvents();
+    } else if (undoStack()->changes() != _playEventsChanges) {
+        // changed without passing Score::update()
+        invalidatePlayEvents(cmdState());
+    }
     if (!start) {
         start = firstMeasure();
     }
+    if (!start) {
+        return;
+    }
+
+    const Fraction validTo = _playEventsValidTo;
+    const bool contiguous = start->tick() <= validTo;
+    while (start != end && start->endTick() <= validTo) {
+        start = start->nextMeasure();
+        if (!start) {
+            return;
+        }
+    }
 
     int etrack = nstaves() * VOICES;
     for (int track = 0; track < etrack; ++track) {
@@ -2355,6 +2390,10 @@ void Score::createPlayEvents(Measure const* start, Measure const* const end)
                 }
             }
 
+            // skip measures still up to date
+            if (m->endTick() <= validTo) {
+                continue;
+            }
             // skip linked staves, except primary
             if (!m->score()->staff(track / VOICES)->primaryStaff()) {
                 continue;
@@ -2368,6 +2407,84 @@ void Score::createPlayEvents(Measure const* start, Measure const* const end)
             }
         }
     }
+
+    if (contiguous) {
+        _playEventsValidTo = qMax(validTo, end ? end->tick() : lastMeasure()->endTick());
+    }
+}
+
+//---------------------------------------------------------
+//   invalidatePlayEvents
+//    forget the play events from the measure containing
+//    tick on. Swing and instrument changes affect all
+//    later chords, so nothing after tick is kept.
+//---------------------------------------------------------
+
+void Score::invalidatePlayEvents(const Fraction& tick)
+{
+    if (tick < _playEventsValidTo) {
+        _playEventsValidTo = qMax(tick, Fraction(0, 1));
+    }
+}
+
+//---------------------------------------------------------
+//   playEventsStart
+//    first tick whose play events may depend on the range
+//    stick-etick: the measure before the range, or the
+//    start of a tie chain or of a note spanner (glissando)
+//    reaching into it
+//---------------------------------------------------------
+
+static Fraction playEventsStart(Score* score, const Fraction& stick, const Fraction& etick)
+{
+    Measure* m = stick < score->endTick() ? score->tick2measure(stick) : score->lastMeasure();
+    if (!m) {
+        return Fraction(0, 1);
+    }
+    if (m->prevMeasure()) {
+        m = m->prevMeasure();
+    }
+    Fraction start = qMin(stick, m->tick());
+
+    // a tie chain reaching into the range passes through this measure
+    int tracks = score->nstaves() * VOICES;
+    for (Segment* s = m->first(SegmentType::ChordRest); s; s = s->next(SegmentType::ChordRest)) {
+        for (int track = 0; track < tracks; ++track) {
+            Element* e = s->element(track);
+            if (!e || !e->isChord()) {
+                continue;
+            }
+            for (Note* n : toChord(e)->notes()) {
+                if (n->tieBack()) {
+                    start = qMin(start, n->firstTiedNote()->chord()->tick());
+                }
+            }
+        }
+    }
+
+    Fraction end = etick < Fraction(0, 1) ? score->endTick() : qMax(etick, stick);
+    for (auto i : score->spannerMap().findOverlapping(start.ticks(), end.ticks())) {
+        Spanner* sp = i.value;
+        if (sp->anchor() == Spanner::Anchor::NOTE && sp->tick() < start) {
+            start = sp->tick();
+        }
+    }
+    return start;
+}
+
+//---------------------------------------------------------
+//   invalidatePlayEvents
+//    forget the play events changed by a command, see
+//    Score::update()
+//---------------------------------------------------------
+
+void Score::invalidatePlayEvents(const CmdState& cs)
+{
+    Fraction stick;
+    Fraction etick;
+    if (cs.changedRange(undoStack()->changes(), _playEventsChanges, stick, etick)) {
+        invalidatePlayEvents(playEventsStart(this, stick, etick));
+    }
 }
 
 //---------------------------------------------------------
@@ -101,8 +101,6 @@ void RepeatSegment::popMeasure()
 RepeatList::RepeatList(Score* s)
 {
     _score = s;
-    idx1  = 0;
-    idx2  = 0;
 }
 
 //---------------------------------------------------------
@@ -167,6 +165,32 @@ void RepeatList::updateTempo()
     }
 }
 
+//---------------------------------------------------------
+//   segmentIdxByUTick
+//    index of the last segment starting at or before tick,
+//    -1 if there is none; segments are sorted by utick
+//---------------------------------------------------------
+
+int RepeatList::segmentIdxByUTick(int tick) const
+{
+    auto i = std::upper_bound(cbegin(), cend(), tick, [](int t, const RepeatSegment* rs) {
+            return t < rs->utick;
+        });
+    return int(i - cbegin()) - 1;
+}
+
+//---------------------------------------------------------
+//   segmentIdxByUTime
+//---------------------------------------------------------
+
+int RepeatList::segmentIdxByUTime(qreal t) const
+{
+    auto i = std::upper_bound(cbegin(), cend(), t, [](qreal tt, const RepeatSegment* rs) {
+            return tt < rs->utime;
+        });
+    return int(i - cbegin()) - 1;
+}
+
 //---------------------------------------------------------
 //   utick2tick
 //---------------------------------------------------------
@@ -180,12 +204,9 @@ int RepeatList::utick2tick(int tick) const
     if (tick < 0) {
         return 0;
     }
-    unsigned ii = (idx1 < n) && (tick >= at(idx1)->utick) ? idx1 : 0;
-    for (unsigned i = ii; i < n; ++i) {
-        if ((tick >= at(i)->utick) && ((i + 1 == n) || (tick < at(i + 1)->utick))) {
-            idx1 = i;
-            return tick - (at(i)->utick - at(i)->tick);
-        }
+    int i = segmentIdxByUTick(tick);
+    if (i >= 0) {
+        return tick - (at(i)->utick - at(i)->tick);
     }
     if (MScore::debugMode) {
         qFatal("tick %d not found in RepeatList", tick);
@@ -216,14 +237,11 @@ int RepeatList::tick2utick(int tick) const
 
 qreal RepeatList::utick2utime(int tick) const
 {
-    unsigned n = size();
-    unsigned ii = (idx1 < n) && (tick >= at(idx1)->utick) ? idx1 : 0;
-    for (unsigned i = ii; i < n; ++i) {
-        if ((tick >= at(i)->utick) && ((i + 1 == n) || (tick < at(i + 1)->utick))) {
-            int t     = tick - (at(i)->utick - at(i)->tick);
-            qreal tt = _score->tempomap()->tick2time(t) + at(i)->timeOffset;
-            return tt;
-        }
+    int i = segmentIdxByUTick(tick);
+    if (i >= 0) {
+        int t     = tick - (at(i)->utick - at(i)->tick);
+        qreal tt = _score->tempomap()->tick2time(t) + at(i)->timeOffset;
+        return tt;
     }
     return 0.0;
 }
@@ -234,13 +252,9 @@ qreal RepeatList::utick2utime(int tick) const
 
 int RepeatList::utime2utick(qreal t) const
 {
-    unsigned n = size();
-    unsigned ii = (idx2 < n) && (t >= at(idx2)->utime) ? idx2 : 0;
-    for (unsigned i = ii; i < n; ++i) {
-        if ((t >= at(i)->utime) && ((i + 1 == n) || (t < at(i + 1)->utime))) {
-            idx2 = i;
-            return _score->tempomap()->time2tick(t - at(i)->timeOffset) + (at(i)->utick - at(i)->tick);
-        }
+    int i = segmentIdxByUTime(t);
+    if (i >= 0) {
+        return _score->tempomap()->time2tick(t - at(i)->timeOffset) + (at(i)->utick - at(i)->tick);
     }
     if (MScore::debugMode) {
         qFatal("time %f not found in RepeatList", t);
@@ -61,7 +61,6 @@ public:
 class RepeatList : public QList<RepeatSegment*>
 {
     Score* _score;
-    mutable unsigned idx1, idx2;     // cached values
 
     bool _expanded = false;
     bool _scoreChanged = true;
@@ -78,6 +77,8 @@ class RepeatList : public QList<RepeatSegment*>
                      Volta const** const activeVolta, RepeatListElement const** const startRepeatReference) const;
     void unwind();
     void flatten();
+    int segmentIdxByUTick(int tick) const;
+    int segmentIdxByUTime(qreal time) const;
 
 public:
     RepeatList(Score* s);
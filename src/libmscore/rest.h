@@ -31,6 +31,7 @@ public:
     Rest(Score* s = 0);
     Rest(Score*, const TDuration&);
     Rest(const Rest&, bool link = false);
+    MS_POOLED_ELEMENT(Rest)
     ~Rest() { qDeleteAll(m_dots); }
 
     // Score Tree functions
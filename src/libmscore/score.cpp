@@ -17,6 +17,7 @@
 
 #include <assert.h>
 #include <cmath>
+#include <mutex>
 #include <QBuffer>
 
 #include "score.h"
@@ -39,6 +40,7 @@
 #include "rest.h"
 #include "slur.h"
 #include "staff.h"
+#include "staffclipboard.h"
 #include "part.h"
 #include "style.h"
 #include "tuplet.h"
@@ -73,10 +75,12 @@
 #include "breath.h"
 #include "instrchange.h"
 #include "synthesizerstate.h"
+#include "measurewritecache.h"
 
 namespace Ms {
 MasterScore* gscore;                 ///< system score, used for palettes etc.
 std::set<Score*> Score::validScores;
+static std::mutex validScoresMutex;   ///< scores are created and deleted on threads reading movements
 
 bool noSeq           = false;
 bool noMidi          = false;
@@ -283,7 +287,10 @@ void MeasureBaseList::fixupSystems()
 Score::Score()
     : ScoreElement(this), _headersText(MAX_HEADERS, nullptr), _footersText(MAX_FOOTERS, nullptr), _selection(this), _selectionFilter(this)
 {
-    Score::validScores.insert(this);
+    {
+        std::lock_guard<std::mutex> lock(validScoresMutex);
+        Score::validScores.insert(this);
+    }
     _masterScore = 0;
     Layer l;
     l.name          = "default";
@@ -302,7 +309,10 @@ Score::Score()
 Score::Score(MasterScore* parent, bool forcePartStyle /* = true */)
     : Score{}
 {
-    Score::validScores.insert(this);
+    {
+        std::lock_guard<std::mutex> lock(validScoresMutex);
+        Score::validScores.insert(this);
+    }
     _masterScore = parent;
     if (MScore::defaultStyleForParts()) {
         _style = *MScore::defaultStyleForParts();
@@ -344,7 +354,10 @@ Score::Score(MasterScore* parent, bool forcePartStyle /* = true */)
 Score::Score(MasterScore* parent, const MStyle& s)
     : Score{parent}
 {
-    Score::validScores.insert(this);
+    {
+        std::lock_guard<std::mutex> lock(validScoresMutex);
+        Score::validScores.insert(this);
+    }
     _style  = s;
 }
 
@@ -354,7 +367,11 @@ Score::Score(MasterScore* parent, const MStyle& s)
 
 Score::~Score()
 {
-    Score::validScores.erase(this);
+    {
+        std::lock_guard<std::mutex> lock(validScoresMutex);
+        Score::validScores.erase(this);
+    }
+    StaffClipboard::release(this);
 
     foreach (MuseScoreView* v, viewer) {
         v->removeScore();
@@ -380,6 +397,7 @@ Score::~Score()
     qDeleteAll(_staves);
 //      qDeleteAll(_pages);         // TODO: check
     _masterScore = 0;
+    delete _measureWriteCache;
 
     imageStore.clearUnused();
 }
@@ -422,10 +440,16 @@ Score* Score::clone()
 void Score::onElementDestruction(Element* e)
 {
     Score* score = e->score();
-    if (!score || Score::validScores.find(score) == Score::validScores.end()) {
-        // No score or the score is already deleted
+    if (!score) {
         return;
     }
+    {
+        std::lock_guard<std::mutex> lock(validScoresMutex);
+        if (Score::validScores.find(score) == Score::validScores.end()) {
+            // the score is already deleted
+            return;
+        }
+    }
     score->selection().remove(e);
     score->cmdState().unsetElement(e);
     for (MuseScoreView* v : score->viewer) {
@@ -495,7 +519,7 @@ void Score::fixTicks()
         tick += measureTicks;
     }
     // Now done in getNextMeasure(), do we keep?
-    if (tempomap()->empty()) {
+    if (tempomap()->empty() && !readConcurrently()) {
         tempomap()->setTempo(0, _defaultTempo);
     }
 }
@@ -814,6 +838,7 @@ void MasterScore::setPlaylistDirty()
 
 void Score::spell()
 {
+    std::vector<std::vector<Note*> > lists;
     for (int i = 0; i < nstaves(); ++i) {
         std::vector<Note*> notes;
         for (Segment* s = firstSegment(SegmentType::All); s; s = s->next1()) {
@@ -828,12 +853,14 @@ void Score::spell()
                 }
             }
         }
-        spellNotelist(notes);
+        lists.push_back(notes);
     }
+    spellNotelists(lists);
 }
 
 void Score::spell(int startStaff, int endStaff, Segment* startSegment, Segment* endSegment)
 {
+    std::vector<std::vector<Note*> > lists;
     for (int i = startStaff; i < endStaff; ++i) {
         std::vector<Note*> notes;
         for (Segment* s = startSegment; s && s != endSegment; s = s->next()) {
@@ -848,8 +875,9 @@ void Score::spell(int startStaff, int endStaff, Segment* startSegment, Segment*
                 }
             }
         }
-        spellNotelist(notes);
+        lists.push_back(notes);
     }
+    spellNotelists(lists);
 }
 
 //---------------------------------------------------------
@@ -1366,6 +1394,10 @@ static void updateStyle(void*, Element* e)
 
 void Score::styleChanged()
 {
+    _fontMetricsCache.clear();
+    if (_measureWriteCache) {
+        _measureWriteCache->clear();
+    }
     scanElements(0, updateStyle);
     for (int i = 0; i < MAX_HEADERS; i++) {
         if (headerText(i)) {
@@ -1380,6 +1412,32 @@ void Score::styleChanged()
     setLayoutAll();
 }
 
+//---------------------------------------------------------
+//   deleteMeasureWriteCache
+//---------------------------------------------------------
+
+void Score::deleteMeasureWriteCache()
+{
+    delete _measureWriteCache;
+    _measureWriteCache = nullptr;
+}
+
+//---------------------------------------------------------
+//   setMeasureWriteCacheEnabled
+//    keep the xml of the measures of the score and its
+//    parts between saves, see MeasureWriteCache
+//---------------------------------------------------------
+
+void MasterScore::setMeasureWriteCacheEnabled(bool val)
+{
+    _measureWriteCacheEnabled = val;
+    if (!val) {
+        for (Score* s : scoreList()) {
+            s->deleteMeasureWriteCache();
+        }
+    }
+}
+
 //---------------------------------------------------------
 //   getCreateMeasure
 //    - return Measure for tick
@@ -2048,6 +2106,19 @@ void Score::setMetaTag(const QString& tag, const QString& val)
 //---------------------------------------------------------
 
 void MasterScore::addExcerpt(Excerpt* ex)
+{
+    setExcerptParts(ex);
+    excerpts().append(ex);
+    setExcerptsChanged(true);
+}
+
+//---------------------------------------------------------
+//   setExcerptParts
+//    set the parts of an excerpt from the staves of its
+//    part score, and its tracks if they are not known
+//---------------------------------------------------------
+
+void MasterScore::setExcerptParts(Excerpt* ex)
 {
     Score* score = ex->partScore();
 
@@ -2094,8 +2165,6 @@ void MasterScore::addExcerpt(Excerpt* ex)
         }
         ex->setTracks(tracks);
     }
-    excerpts().append(ex);
-    setExcerptsChanged(true);
 }
 
 //---------------------------------------------------------
@@ -3286,7 +3355,7 @@ void Score::selectAdd(Element* e)
             selState = SelState::RANGE;
             _selection.updateSelectedElements();
         }
-    } else if (!_selection.elements().contains(e)) {
+    } else if (!_selection.contains(e)) {
         addRefresh(e->abbox());
         selState = SelState::LIST;
         _selection.add(e);
@@ -3913,6 +3982,7 @@ void Score::undo(UndoCommand* cmd, EditData* ed) const
 
 int Score::linkId()
 {
+    Q_ASSERT(!LinkStage::current());      // ids are given when a stage is merged
     return (masterScore()->_linkId)++;
 }
 
@@ -3937,7 +4007,7 @@ QList<Score*> Score::scoreList()
     Score* root = masterScore();
     scores.append(root);
     for (const Excerpt* ex : root->excerpts()) {
-        if (ex->partScore()) {
+        if (ex->partScore() && ex->isPartScoreRead()) {     // a part score not read yet is not linked
             scores.append(ex->partScore());
         }
     }
@@ -5114,7 +5184,7 @@ Staff* Score::staff(const QString& staffId) const
 
 void MasterScore::setUpdateAll()
 {
-    _cmdState.setUpdateMode(UpdateMode::UpdateAll);
+    cmdState().setUpdateMode(UpdateMode::UpdateAll);
 }
 
 //---------------------------------------------------------
@@ -5123,17 +5193,17 @@ void MasterScore::setUpdateAll()
 
 void MasterScore::setLayoutAll(int staff, const Element* e)
 {
-    _cmdState.setTick(Fraction(0,1));
-    _cmdState.setTick(measures()->last() ? measures()->last()->endTick() : Fraction(0,1));
+    cmdState().setTick(Fraction(0,1));
+    cmdState().setTick(measures()->last() ? measures()->last()->endTick() : Fraction(0,1));
 
     if (e && e->score() == this) {
         // TODO: map staff number properly
         const int startStaff = staff == -1 ? 0 : staff;
         const int endStaff = staff == -1 ? (nstaves() - 1) : staff;
-        _cmdState.setStaff(startStaff);
-        _cmdState.setStaff(endStaff);
+        cmdState().setStaff(startStaff);
+        cmdState().setStaff(endStaff);
 
-        _cmdState.setElement(e);
+        cmdState().setElement(e);
     }
 }
 
@@ -5144,31 +5214,31 @@ void MasterScore::setLayoutAll(int staff, const Element* e)
 void MasterScore::setLayout(const Fraction& t, int staff, const Element* e)
 {
     if (t >= Fraction(0,1)) {
-        _cmdState.setTick(t);
+        cmdState().setTick(t);
     }
 
     if (e && e->score() == this) {
         // TODO: map staff number properly
-        _cmdState.setStaff(staff);
-        _cmdState.setElement(e);
+        cmdState().setStaff(staff);
+        cmdState().setElement(e);
     }
 }
 
 void MasterScore::setLayout(const Fraction& tick1, const Fraction& tick2, int staff1, int staff2, const Element* e)
 {
     if (tick1 >= Fraction(0,1)) {
-        _cmdState.setTick(tick1);
+        cmdState().setTick(tick1);
     }
     if (tick2 >= Fraction(0,1)) {
-        _cmdState.setTick(tick2);
+        cmdState().setTick(tick2);
     }
 
     if (e && e->score() == this) {
         // TODO: map staff number properly
-        _cmdState.setStaff(staff1);
-        _cmdState.setStaff(staff2);
+        cmdState().setStaff(staff1);
+        cmdState().setStaff(staff2);
 
-        _cmdState.setElement(e);
+        cmdState().setElement(e);
     }
 }
 
@@ -5311,7 +5381,8 @@ Movements::~Movements()
 //    Usually pushes and pops to the undo stack are only
 //    valid inside a startCmd() - endCmd(). Exceptions
 //    occurred during score loading.
+//    Scores may be loaded on several threads at once.
 //---------------------------------------------------------
 
-int ScoreLoad::_loading = 0;
+std::atomic<int> ScoreLoad::_loading { 0 };
 }
@@ -18,6 +18,7 @@
  Definition of Score class.
 */
 
+#include <atomic>
 #include <set>
 #include <QFileInfo>
 #include <QQueue>
@@ -32,6 +33,8 @@
 #include "spannermap.h"
 #include "layoutbreak.h"
 #include "property.h"
+#include "linkstage.h"
+#include "fontmetricscache.h"
 
 namespace mu {
 namespace notation {
@@ -70,8 +73,10 @@ class Lyrics;
 class MasterSynthesizer;
 class Measure;
 class MeasureBase;
+class MeasureWriteCache;
 class MuseScoreView;
 class Note;
+class NoteEventList;
 class Omr;
 class Page;
 class Parameter;
@@ -86,6 +91,7 @@ class SigEvent;
 class Slur;
 class Spanner;
 class Staff;
+class StaffClipboard;
 class System;
 class TempoMap;
 class Text;
@@ -317,6 +323,7 @@ public:
     int startStaff() const { return _startStaff; }
     int endStaff() const { return _endStaff; }
     const Element* element() const;
+    bool changedRange(int changes, int& seenChanges, Fraction& stick, Fraction& etick) const;
 
     void lock() { _locked = true; }
     void unlock() { _locked = false; }
@@ -458,6 +465,7 @@ private:
     int _pageNumberOffset { 0 };          ///< Offset for page numbers.
 
     UpdateState _updateState;
+    int _layoutSerial { 0 };              ///< incremented on every layout, to invalidate caches of layout results
 
     MeasureBaseList _measures;            // here are the notes
     QList<Part*> _parts;
@@ -509,6 +517,11 @@ private:
     PlayMode _playMode { PlayMode::SYNTHESIZER };
 
     qreal _noteHeadWidth { 0.0 };         // cached value
+    FontMetricsCache _fontMetricsCache;
+    MeasureWriteCache* _measureWriteCache { nullptr };    ///< created by writeMovement() if enabled
+    Fraction _playEventsValidTo { 0, 1 };  ///< play events of the chords before this tick are up to date
+    int _playEventsChanges { -1 };         ///< undo stack changes seen by the play events
+    int _measureLayoutChanges { -1 };      ///< undo stack changes seen by the measure layout fingerprints
     QString accInfo;                      ///< information about selected element(s) for use by screen-readers
     QString accMessage;                   ///< temporary status message for use by screen-readers
 
@@ -557,6 +570,7 @@ private:
     void addAudioTrack();
     QList<Fraction> splitGapToMeasureBoundaries(ChordRest*, Fraction);
     void pasteChordRest(ChordRest* cr, const Fraction& tick, const Interval&);
+    void finishPasteStaff(const Fraction& dstTick, const Fraction& tickLen, int dstStaff, int staves, bool pasted);
 
     void selectSingle(Element* e, int staffIdx);
     void selectAdd(Element* e);
@@ -584,7 +598,9 @@ protected:
     LayoutMode _layoutMode { LayoutMode::PAGE };
     SynthesizerState _synthesizerState;
 
+    void connectTies(Measure* sm, Measure* em, bool silent);
     void createPlayEvents(Chord*);
+    QList<NoteEventList> defaultPlayEvents(Chord*);
     void createGraceNotesPlayEvents(const Fraction& tick, Chord* chord, int& ontime, int& trailtime);
     void cmdPitchUp();
     void cmdPitchDown();
@@ -638,6 +654,7 @@ public:
     void addMeasure(MeasureBase*, MeasureBase*);
     void readStaff(XmlReader&);
     bool read(XmlReader&);
+    bool readConcurrently() const;
 
     Excerpt* excerpt() { return _excerpt; }
     void setExcerpt(Excerpt* e) { _excerpt = e; }
@@ -699,6 +716,7 @@ public:
     void undoChangePitch(Note* note, int pitch, int tpc1, int tpc2);
     void undoChangeFretting(Note* note, int pitch, int string, int fret, int tpc1, int tpc2);
     void spellNotelist(std::vector<Note*>& notes);
+    void spellNotelists(const std::vector<std::vector<Note*> >& lists);
     void undoChangeTpc(Note* note, int tpc);
     void undoChangeChordRestLen(ChordRest* cr, const TDuration&);
     void undoTransposeHarmony(Harmony*, int, int);
@@ -995,6 +1013,7 @@ public:
 
     void cmdPaste(const QMimeData* ms, MuseScoreView* view, Fraction scale = Fraction(1, 1));
     bool pasteStaff(XmlReader&, Segment* dst, int staffIdx, Fraction scale = Fraction(1, 1));
+    bool pasteStaff(const StaffClipboard&, Segment* dst, int staffIdx, Fraction scale = Fraction(1, 1));
     void readAddConnector(ConnectorInfoReader* info, bool pasteMode) override;
     void pasteSymbols(XmlReader& e, ChordRest* dst);
     void renderMidi(EventMap* events, const SynthesizerState& synthState);
@@ -1009,6 +1028,9 @@ public:
 
     void updateSwing();
     void createPlayEvents(Measure const* start = nullptr, Measure const* const end = nullptr);
+    void invalidatePlayEvents(const Fraction& tick = Fraction(0, 1));
+    void invalidatePlayEvents(const CmdState&);
+    Fraction playEventsValidTo() const { return _playEventsValidTo; }
 
     void updateCapo();
     void updateVelo();
@@ -1092,6 +1114,9 @@ public:
     Segment* lastSegmentMM() const;
 
     void connectTies(bool silent = false);
+    void connectTies(const Fraction& stick, const Fraction& etick, bool silent = false);
+    void invalidateMeasureLayouts(const CmdState&);
+    void invalidateMeasureLayouts(const Fraction& stick, const Fraction& etick);
     void relayoutForStyles();
 
     qreal point(const Spatium sp) const { return sp.val() * spatium(); }
@@ -1117,6 +1142,7 @@ public:
 
     void doLayout();
     void doLayoutRange(const Fraction&, const Fraction&);
+    int layoutSerial() const { return _layoutSerial; }
     void layoutLinear(bool layoutAll, LayoutContext& lc);
 
     void layoutChords1(Segment* segment, int staffIdx);
@@ -1225,6 +1251,10 @@ public:
     qreal noteHeadWidth() const { return _noteHeadWidth; }
     void setNoteHeadWidth(qreal n) { _noteHeadWidth = n; }
 
+    FontMetricsCache& fontMetricsCache() { return _fontMetricsCache; }
+    MeasureWriteCache* measureWriteCache() const { return _measureWriteCache; }
+    void deleteMeasureWriteCache();
+
     QList<int> uniqueStaves() const;
     void transpositionChanged(Part*, Interval, Fraction tickStart = { 0, 1 }, Fraction tickEnd = { -1, 1 });
 
@@ -1277,6 +1307,8 @@ public:
 
     bool checkKeys();
     bool checkClefs();
+    bool checkTies();
+    bool checkPlayEvents();
 
     void switchToPageMode();
 
@@ -1348,6 +1380,7 @@ class MasterScore : public Score
     Movements* _movements   { 0 };
 
     bool _readOnly          { false };
+    bool _measureWriteCacheEnabled { false };
 
     CmdState _cmdState;       // modified during cmd processing
 
@@ -1389,6 +1422,8 @@ public:
     virtual bool isMaster() const override { return true; }
     virtual bool readOnly() const override { return _readOnly; }
     void setReadOnly(bool ro) { _readOnly = ro; }
+    bool measureWriteCacheEnabled() const { return _measureWriteCacheEnabled; }
+    void setMeasureWriteCacheEnabled(bool val);
     virtual UndoStack* undoStack() const override { return _movements->undo(); }
     virtual TimeSigMap* sigmap() const override { return _sigmap; }
     virtual TempoMap* tempomap() const override { return _tempomap; }
@@ -1420,14 +1455,15 @@ public:
     void setLayout(const Fraction& tick, int staff, const Element* e = nullptr);
     void setLayout(const Fraction& tick1, const Fraction& tick2, int staff1, int staff2, const Element* e = nullptr);
 
-    virtual CmdState& cmdState() override { return _cmdState; }
-    const CmdState& cmdState() const override { return _cmdState; }
-    virtual void addLayoutFlags(LayoutFlags val) override { _cmdState.layoutFlags |= val; }
-    virtual void setInstrumentsChanged(bool val) override { _cmdState._instrumentsChanged = val; }
+    // a part built on a worker thread uses the state of its LinkStage
+    virtual CmdState& cmdState() override { return LinkStage::current() ? LinkStage::current()->cmdState() : _cmdState; }
+    const CmdState& cmdState() const override { return LinkStage::current() ? LinkStage::current()->cmdState() : _cmdState; }
+    virtual void addLayoutFlags(LayoutFlags val) override { cmdState().layoutFlags |= val; }
+    virtual void setInstrumentsChanged(bool val) override { cmdState()._instrumentsChanged = val; }
 
-    void setExcerptsChanged(bool val) { _cmdState._excerptsChanged = val; }
-    bool excerptsChanged() const { return _cmdState._excerptsChanged; }
-    bool instrumentsChanged() const { return _cmdState._instrumentsChanged; }
+    void setExcerptsChanged(bool val) { cmdState()._excerptsChanged = val; }
+    bool excerptsChanged() const { return cmdState()._excerptsChanged; }
+    bool instrumentsChanged() const { return cmdState()._instrumentsChanged; }
 
     Revisions* revisions() { return _revisions; }
 
@@ -1478,6 +1514,7 @@ public:
     void setPos(POS pos, Fraction tick);
 
     void addExcerpt(Excerpt*);
+    void setExcerptParts(Excerpt*);
     void removeExcerpt(Excerpt*);
     void deleteExcerpt(Excerpt*);
 
@@ -1512,7 +1549,7 @@ public:
 
 class ScoreLoad
 {
-    static int _loading;
+    static std::atomic<int> _loading;
 
 public:
     ScoreLoad() { ++_loading; }
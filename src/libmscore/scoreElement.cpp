@@ -171,7 +171,9 @@ ScoreElement::ScoreElement(const ScoreElement& se)
 
 ScoreElement::~ScoreElement()
 {
-    if (_links) {
+    LinkStage* stage = LinkStage::current();
+    bool staged = stage && stage->remove(this);     // linked by a part built on this thread
+    if (_links && !staged) {
         _links->removeOne(this);
         if (_links->empty()) {
             delete _links;
@@ -306,6 +308,8 @@ static void changeProperty(ScoreElement* e, Pid t, const QVariant& st, PropertyF
         if (e->isBracketItem()) {
             BracketItem* bi = toBracketItem(e);
             e->score()->undo(new ChangeBracketProperty(bi->staff(), bi->column(), t, st, ps));
+        } else if (e->score()->undoStack()->propertyBatchActive()) {
+            e->score()->undoStack()->pushBatchedProperty(e, t, st, ps);
         } else {
             e->score()->undo(new ChangeProperty(e, t, st, ps));
         }
@@ -591,7 +595,9 @@ void ScoreElement::linkTo(ScoreElement* element)
     Q_ASSERT(element != this);
     Q_ASSERT(!_links);
 
-    if (element->links()) {
+    if (LinkStage* stage = LinkStage::current()) {
+        _links = stage->linkedElements(element);
+    } else if (element->links()) {
         _links = element->_links;
         Q_ASSERT(_links->contains(element));
     } else {
@@ -613,6 +619,10 @@ void ScoreElement::linkTo(ScoreElement* element)
 
 void ScoreElement::unlink()
 {
+    LinkStage* stage = LinkStage::current();
+    if (stage && stage->remove(this)) {
+        return;
+    }
     Q_ASSERT(_links);
     Q_ASSERT(_links->contains(this));
     _links->removeOne(this);
@@ -635,15 +645,16 @@ void ScoreElement::unlink()
 
 bool ScoreElement::isLinked(ScoreElement* se) const
 {
-    if (se == this || !_links) {
+    LinkedElements* le = links();
+    if (se == this || !le) {
         return false;
     }
 
     if (se == nullptr) {
-        return !_links->isEmpty() && _links->mainElement() != this;
+        return !le->isEmpty() && le->mainElement() != this;
     }
 
-    return _links->contains(se);
+    return le->contains(se);
 }
 
 //---------------------------------------------------------
@@ -652,7 +663,7 @@ bool ScoreElement::isLinked(ScoreElement* se) const
 
 void ScoreElement::undoUnlink()
 {
-    if (_links) {
+    if (links()) {
         _score->undo(new Unlink(this));
     }
 }
@@ -664,8 +675,8 @@ void ScoreElement::undoUnlink()
 QList<ScoreElement*> ScoreElement::linkList() const
 {
     QList<ScoreElement*> el;
-    if (_links) {
-        el = *_links;
+    if (LinkedElements* le = links()) {
+        el = *le;
     } else {
         el.append(const_cast<ScoreElement*>(this));
     }
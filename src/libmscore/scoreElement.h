@@ -15,6 +15,7 @@
 
 #include "types.h"
 #include "style.h"
+#include "linkstage.h"
 
 namespace Ms {
 class ScoreElement;
@@ -285,7 +286,11 @@ public:
 
     virtual void undoUnlink();
     int lid() const { return _links ? _links->lid() : 0; }
-    LinkedElements* links() const { return _links; }
+    LinkedElements* links() const
+    {
+        LinkStage* stage = LinkStage::current();
+        return stage ? stage->links(this, _links) : _links;
+    }
     void setLinks(LinkedElements* le) { _links = le; }
 
     //---------------------------------------------------
@@ -47,6 +47,7 @@
 #include "imageStore.h"
 #include "audio.h"
 #include "barline.h"
+#include "measurewritecache.h"
 #include "thirdparty/qzip/qzipreader_p.h"
 #include "thirdparty/qzip/qzipwriter_p.h"
 #ifdef Q_OS_WIN
@@ -58,12 +59,15 @@ namespace Ms {
 //   writeMeasure
 //---------------------------------------------------------
 
-static void writeMeasure(XmlWriter& xml, MeasureBase* m, int staffIdx, bool writeSystemElements, bool forceTimeSig)
+static void writeMeasure(XmlWriter& xml, MeasureBase* m, int staffIdx, bool writeSystemElements, bool forceTimeSig,
+                         MeasureWriteCache* cache)
 {
     //
     // special case multi measure rest
     //
-    if (m->isMeasure() || staffIdx == 0) {
+    if (cache && m->isMeasure() && !forceTimeSig) {
+        cache->write(xml, toMeasure(m), staffIdx, writeSystemElements);
+    } else if (m->isMeasure() || staffIdx == 0) {
         m->write(xml, staffIdx, writeSystemElements, forceTimeSig);
     }
 
@@ -80,6 +84,11 @@ static void writeMeasure(XmlWriter& xml, MeasureBase* m, int staffIdx, bool writ
 
 void Score::writeMovement(XmlWriter& xml, bool selectionOnly)
 {
+    // elements are written with the links of all part scores
+    if (isMaster()) {
+        Excerpt::readPartScores(excerpts());
+    }
+
     // if we have multi measure rests and some parts are hidden,
     // then some layout information is missing:
     // relayout with all parts set visible
@@ -214,6 +223,16 @@ void Score::writeMovement(XmlWriter& xml, bool selectionOnly)
         }
     }
 
+    // fragments of the last save are used for clean measures
+    MeasureWriteCache* cache = nullptr;
+    if (!selectionOnly && !unhide && masterScore()->measureWriteCacheEnabled() && MeasureWriteCache::canWrite(xml)) {
+        if (!_measureWriteCache) {
+            _measureWriteCache = new MeasureWriteCache;
+        }
+        cache = _measureWriteCache;
+        cache->sync(this);
+    }
+
     xml.setCurTrack(0);
     xml.setTrackDiff(-staffStart * VOICES);
     if (measureStart) {
@@ -235,7 +254,7 @@ void Score::writeMovement(XmlWriter& xml, bool selectionOnly)
                         forceTimeSig = false;
                     }
                 }
-                writeMeasure(xml, m, staffIdx, writeSystemElements, forceTimeSig);
+                writeMeasure(xml, m, staffIdx, writeSystemElements, forceTimeSig, cache);
             }
             xml.etag();
         }
@@ -514,6 +533,25 @@ bool MasterScore::saveFile(bool generateBackup)
     return true;
 }
 
+//---------------------------------------------------------
+//   readImages
+//    read the images not read yet from their score files;
+//    return false if an image of score could not be read,
+//    as it would be missing from the saved file
+//---------------------------------------------------------
+
+static bool readImages(Score* score)
+{
+    imageStore.load();
+    for (ImageStoreItem* ip : imageStore) {
+        if (ip->isUsed(score) && ip->loadFailed()) {
+            MScore::lastError = QObject::tr("Cannot read picture %1 from the file the score was read from").arg(ip->path());
+            return false;
+        }
+    }
+    return true;
+}
+
 //---------------------------------------------------------
 //   saveCompressedFile
 //---------------------------------------------------------
@@ -523,6 +561,9 @@ bool Score::saveCompressedFile(QFileInfo& info, bool onlySelection, bool createT
     if (readOnly() && info == *masterScore()->fileInfo()) {
         return false;
     }
+    if (!readImages(this)) {  // the images may still be in the file about to be overwritten
+        return false;
+    }
     QFile fp(info.filePath());
     if (!fp.open(QIODevice::WriteOnly)) {
         MScore::lastError = tr("Open File\n%1\nfailed: %2").arg(info.filePath(), strerror(errno));
@@ -582,6 +623,9 @@ QImage Score::createThumbnail()
 
 bool Score::saveCompressedFile(QIODevice* f, const QString& fn, bool onlySelection, bool doCreateThumbnail)
 {
+    if (!readImages(this)) {
+        return false;
+    }
     MQZipWriter uz(f);
 
     QBuffer cbuf;
@@ -822,26 +866,35 @@ Score::FileError MasterScore::loadCompressedMsc(QIODevice* io, bool ignoreVersio
     }
 
     //
-    // load images
+    // load images; they are read from a score file only when
+    // they are first laid out
     //
     if (!MScore::noImages) {
+        QFile* file = qobject_cast<QFile*>(io);
         foreach (const QString& s, sl) {
-            QByteArray dbuf = uz.fileData(s);
-            imageStore.add(s, dbuf);
+            if (!file || !imageStore.addLazy(s, QFileInfo(file->fileName()).absoluteFilePath())) {
+                imageStore.add(s, uz.fileData(s));
+            }
         }
     }
 
-    QByteArray dbuf = uz.fileData(rootfile);
-    if (dbuf.isEmpty()) {
+    //
+    // the score is inflated while it is read
+    //
+    QScopedPointer<QIODevice> dev(uz.openFile(rootfile));
+    if (!dev) {
         QVector<MQZipReader::FileInfo> fil = uz.fileInfoList();
         foreach (const MQZipReader::FileInfo& fi, fil) {
             if (fi.filePath.endsWith(".mscx")) {
-                dbuf = uz.fileData(fi.filePath);
+                dev.reset(uz.openFile(fi.filePath));
                 break;
             }
         }
     }
-    XmlReader e(dbuf);
+    if (!dev) {
+        return FileError::FILE_CORRUPTED;
+    }
+    XmlReader e(dev.data());
     e.setDocName(masterScore()->fileInfo()->completeBaseName());
 
     FileError retval = read1(e, ignoreVersionError);
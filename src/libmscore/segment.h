@@ -75,6 +75,7 @@ public:
     Segment(Measure*, SegmentType, const Fraction&);
     Segment(const Segment&);
     ~Segment();
+    MS_POOLED_ELEMENT(Segment)
 
     // Score Tree functions
     ScoreElement* treeParent() const override;
@@ -222,6 +223,7 @@ public:
 
     std::vector<Shape> shapes() { return _shapes; }
     const std::vector<Shape>& shapes() const { return _shapes; }
+    void setShapes(const std::vector<Shape>& shapes) { _shapes = shapes; }
     const Shape& staffShape(int staffIdx) const { return _shapes[staffIdx]; }
     Shape& staffShape(int staffIdx) { return _shapes[staffIdx]; }
     void createShapes();
@@ -362,7 +362,7 @@ void Selection::clear()
             e->score()->addRefresh(changeSelection(e, false));
         }
     }
-    _el.clear();
+    clearElements();
     _startSegment  = 0;
     _endSegment    = 0;
     _activeSegment = 0;
@@ -378,7 +378,7 @@ void Selection::clear()
 
 void Selection::remove(Element* el)
 {
-    const bool removed = _el.removeOne(el);
+    const bool removed = removeElement(el);
     el->setSelected(false);
     if (removed) {
         updateState();
@@ -395,8 +395,49 @@ void Selection::add(Element* el)
         LOGE() << "selection locked, reason: " << lockReason();
         return;
     }
-    _el.append(el);
-    update();
+    appendElement(el);
+    // elements added before are already marked as selected
+    el->setSelected(true);
+    updateState();
+}
+
+//---------------------------------------------------------
+//   appendElement
+//    append to _el and keep the membership index in sync
+//---------------------------------------------------------
+
+void Selection::appendElement(Element* e)
+{
+    _el.append(e);
+    ++_elCount[e];
+}
+
+//---------------------------------------------------------
+//   removeElement
+//    remove one occurrence of e, return false if e
+//    is not selected
+//---------------------------------------------------------
+
+bool Selection::removeElement(Element* e)
+{
+    auto i = _elCount.find(e);
+    if (i == _elCount.end()) {
+        return false;
+    }
+    if (--i.value() == 0) {
+        _elCount.erase(i);
+    }
+    return _el.removeOne(e);
+}
+
+//---------------------------------------------------------
+//   clearElements
+//---------------------------------------------------------
+
+void Selection::clearElements()
+{
+    _el.clear();
+    _elCount.clear();
 }
 
 //---------------------------------------------------------
@@ -497,7 +538,7 @@ void Selection::appendFiltered(Element* e)
         return;
     }
     if (selectionFilter().canSelect(e)) {
-        _el.append(e);
+        appendElement(e);
     }
 }
 
@@ -511,34 +552,34 @@ void Selection::appendChord(Chord* chord)
         LOGE() << "selection locked, reason: " << lockReason();
         return;
     }
-    if (chord->beam() && !_el.contains(chord->beam())) {
-        _el.append(chord->beam());
+    if (chord->beam() && !contains(chord->beam())) {
+        appendElement(chord->beam());
     }
     if (chord->stem()) {
-        _el.append(chord->stem());
+        appendElement(chord->stem());
     }
     if (chord->hook()) {
-        _el.append(chord->hook());
+        appendElement(chord->hook());
     }
     if (chord->arpeggio()) {
         appendFiltered(chord->arpeggio());
     }
     if (chord->stemSlash()) {
-        _el.append(chord->stemSlash());
+        appendElement(chord->stemSlash());
     }
     if (chord->tremolo()) {
         appendFiltered(chord->tremolo());
     }
     for (Note* note : chord->notes()) {
-        _el.append(note);
+        appendElement(note);
         if (note->accidental()) {
-            _el.append(note->accidental());
+            appendElement(note->accidental());
         }
         foreach (Element* el, note->el()) {
             appendFiltered(el);
         }
         for (NoteDot* dot : note->dots()) {
-            _el.append(dot);
+            appendElement(dot);
         }
 
         if (note->tieFor() && (note->tieFor()->endElement() != 0)) {
@@ -546,7 +587,7 @@ void Selection::appendChord(Chord* chord)
                 Note* endNote = toNote(note->tieFor()->endElement());
                 Segment* s = endNote->chord()->segment();
                 if (s->tick() < tickEnd()) {
-                    _el.append(note->tieFor());
+                    appendElement(note->tieFor());
                 }
             }
         }
@@ -555,7 +596,7 @@ void Selection::appendChord(Chord* chord)
                 Note* endNote = toNote(sp->endElement());
                 Segment* s = endNote->chord()->segment();
                 if (s->tick() < tickEnd()) {
-                    _el.append(sp);
+                    appendElement(sp);
                 }
             }
         }
@@ -604,7 +645,7 @@ void Selection::updateSelectedElements()
     for (Element* e : _el) {
         e->setSelected(false);
     }
-    _el.clear();
+    clearElements();
 
     // assert:
     int staves = _score->nstaves();
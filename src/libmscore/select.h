@@ -140,6 +140,7 @@ class Selection
     Score* _score;
     SelState _state;
     QList<Element*> _el;            // valid in mode SelState::LIST
+    QHash<const Element*, int> _elCount;  // membership index for _el, counts duplicates
 
     int _staffStart;                // valid if selState is SelState::RANGE
     int _staffEnd;
@@ -166,6 +167,9 @@ class Selection
     bool canSelectVoice(int track) const { return selectionFilter().canSelectVoice(track); }
     void appendFiltered(Element* e);
     void appendChord(Chord* chord);
+    void appendElement(Element* e);
+    bool removeElement(Element* e);
+    void clearElements();
 
 public:
     Selection() { _score = 0; _state = SelState::NONE; }
@@ -184,6 +188,7 @@ public:
     const QString& lockReason() const { return _lockReason; }
 
     const QList<Element*>& elements() const { return _el; }
+    bool contains(const Element* e) const { return _elCount.contains(e); }
     std::vector<Note*> noteList(int track = -1) const;
 
     const QList<Element*> uniqueElements() const;
@@ -1019,6 +1019,17 @@ static bool isDirectionMixture(Chord* c1, Chord* c2)
 //---------------------------------------------------------
 
 SpannerSegment* Slur::layoutSystem(System* system)
+{
+    return layoutSystem(system, nullptr);
+}
+
+//---------------------------------------------------------
+//   layoutSystem
+//    create and place slurSegment for system; if l is
+//    given, the Bezier layout of the segment is queued
+//---------------------------------------------------------
+
+SpannerSegment* Slur::layoutSystem(System* system, SlurTieLayout* l)
 {
     Fraction stick = system->firstMeasure()->tick();
     Fraction etick = system->lastMeasure()->endTick();
@@ -1107,20 +1118,20 @@ SpannerSegment* Slur::layoutSystem(System* system)
 
     switch (sst) {
     case SpannerSegmentType::SINGLE:
-        slurSegment->layoutSegment(sPos.p1, sPos.p2);
+        layoutSegment(slurSegment, sPos.p1, sPos.p2, l);
         break;
     case SpannerSegmentType::BEGIN:
-        slurSegment->layoutSegment(sPos.p1, QPointF(system->bbox().width(), sPos.p1.y()));
+        layoutSegment(slurSegment, sPos.p1, QPointF(system->bbox().width(), sPos.p1.y()), l);
         break;
     case SpannerSegmentType::MIDDLE: {
         qreal x1 = firstNoteRestSegmentX(system);
         qreal x2 = system->bbox().width();
         qreal y  = staffIdx() > system->staves()->size() ? system->y() : system->staff(staffIdx())->y();
-        slurSegment->layoutSegment(QPointF(x1, y), QPointF(x2, y));
+        layoutSegment(slurSegment, QPointF(x1, y), QPointF(x2, y), l);
     }
     break;
     case SpannerSegmentType::END:
-        slurSegment->layoutSegment(QPointF(firstNoteRestSegmentX(system), sPos.p2.y()), sPos.p2);
+        layoutSegment(slurSegment, QPointF(firstNoteRestSegmentX(system), sPos.p2.y()), sPos.p2, l);
         break;
     }
 
@@ -38,7 +38,7 @@ public:
     int subtype() const override { return static_cast<int>(spanner()->type()); }
     void draw(QPainter*) const override;
 
-    void layoutSegment(const QPointF& p1, const QPointF& p2);
+    void layoutSegment(const QPointF& p1, const QPointF& p2) override;
 
     bool isEdited() const;
     bool edit(EditData&) override;
@@ -65,6 +65,7 @@ public:
     void write(XmlWriter& xml) const override;
     void layout() override;
     SpannerSegment* layoutSystem(System*) override;
+    SpannerSegment* layoutSystem(System*, SlurTieLayout*);
     void setTrack(int val) override;
     void slurPos(SlurPos*) override;
 
@@ -10,6 +10,8 @@
 //  the file LICENCE.GPL
 //=============================================================================
 
+#include <thread>
+
 #include "log.h"
 
 #include "measure.h"
@@ -20,6 +22,7 @@
 #include "tie.h"
 #include "chord.h"
 #include "page.h"
+#include "concurrent.h"
 
 namespace Ms {
 //---------------------------------------------------------
@@ -611,6 +614,78 @@ void SlurTie::fixupSegments(unsigned nsegs)
     Spanner::fixupSegments(nsegs, [this]() { return newSlurTieSegment(); });
 }
 
+//---------------------------------------------------------
+//   layoutSegment
+//    lay out segment s now or queue it in l
+//---------------------------------------------------------
+
+void SlurTie::layoutSegment(SlurTieSegment* s, const QPointF& p1, const QPointF& p2, SlurTieLayout* l)
+{
+    if (l) {
+        l->add(s, p1, p2);
+    } else {
+        s->layoutSegment(p1, p2);
+    }
+}
+
+//---------------------------------------------------------
+//   SlurTieLayout
+//---------------------------------------------------------
+
+int SlurTieLayout::_maxThreads = 0;       // 0: one thread per core for large queues
+
+//---------------------------------------------------------
+//   add
+//---------------------------------------------------------
+
+void SlurTieLayout::add(SlurTieSegment* s, const QPointF& p1, const QPointF& p2)
+{
+    int idx = s->staffIdx();
+    if (idx < 0 || idx >= int(_staves.size())) {
+        idx = 0;
+    }
+    _staves[idx].push_back({ s, p1, p2 });
+    ++_size;
+}
+
+//---------------------------------------------------------
+//   run
+//    lay out the queued segments; every staff is handled
+//    by one thread in the order of queueing. The layout of
+//    a segment only reads the segment shapes of its system,
+//    so the result does not depend on the number of threads.
+//---------------------------------------------------------
+
+void SlurTieLayout::run()
+{
+    // below this a thread costs more than the segments it lays out
+    static constexpr int minSegmentsPerThread = 64;
+
+    std::vector<std::vector<Item>*> staves;
+    for (std::vector<Item>& items : _staves) {
+        if (!items.empty()) {
+            staves.push_back(&items);
+        }
+    }
+    const int n = int(staves.size());
+    int threads;
+    if (_maxThreads > 0) {
+        threads = qMin(n, _maxThreads);
+    } else {
+        threads = qMin(n, qMin(int(std::thread::hardware_concurrency()), _size / minSegmentsPerThread));
+    }
+
+    forEachConcurrently(n, threads, [&](int idx) {
+        for (const Item& i : *staves[idx]) {
+            i.segment->layoutSegment(i.p1, i.p2);
+        }
+    });
+    for (std::vector<Item>& items : _staves) {
+        items.clear();
+    }
+    _size = 0;
+}
+
 //---------------------------------------------------------
 //   reset
 //---------------------------------------------------------
@@ -124,6 +124,43 @@ public:
     void read(XmlReader&) override;
     virtual void drawEditMode(QPainter*, EditData&) override;
     virtual void computeBezier(QPointF so = QPointF()) = 0;
+    virtual void layoutSegment(const QPointF& p1, const QPointF& p2) = 0;
+};
+
+//---------------------------------------------------------
+//   SlurTieLayout
+//    Queue of slur and tie segments of one system whose
+//    Bezier curves and collision checks are still to be
+//    computed. The segments are queued per staff after
+//    they were created and attached to the system; run()
+//    lays them out concurrently. Adding their shapes to
+//    the skylines is left to the caller.
+//    By default threads are used for large queues only;
+//    setMaxThreads() forces up to n threads.
+//---------------------------------------------------------
+
+class SlurTieLayout
+{
+    struct Item {
+        SlurTieSegment* segment;
+        QPointF p1;
+        QPointF p2;
+    };
+    std::vector<std::vector<Item> > _staves;
+    int _size { 0 };
+
+    static int _maxThreads;
+
+public:
+    SlurTieLayout(int nstaves)
+        : _staves(nstaves) {}
+
+    void add(SlurTieSegment*, const QPointF& p1, const QPointF& p2);
+    void run();
+    int size() const { return _size; }
+
+    static int maxThreads() { return _maxThreads; }
+    static void setMaxThreads(int n) { _maxThreads = n; }
 };
 
 //-------------------------------------------------------------------
@@ -142,6 +179,7 @@ protected:
     Direction _slurDirection;
     qreal firstNoteRestSegmentX(System* system);
     void fixupSegments(unsigned nsegs);
+    void layoutSegment(SlurTieSegment*, const QPointF& p1, const QPointF& p2, SlurTieLayout*);
 
 public:
     SlurTie(Score*);
@@ -377,6 +377,9 @@ Spanner::Spanner(const Spanner& s)
 
 Spanner::~Spanner()
 {
+    if (_mapNode) {
+        _mapNode->spanner = nullptr;
+    }
     qDeleteAll(segments);
     qDeleteAll(unusedSegments);
 }
@@ -1196,9 +1199,7 @@ Element* Spanner::prevSegmentElement()
 void Spanner::setTick(const Fraction& v)
 {
     _tick = v;
-    if (score()) {
-        score()->spannerMap().setDirty();
-    }
+    SpannerMap::updateSpanner(this);
 }
 
 //---------------------------------------------------------
@@ -1217,9 +1218,7 @@ void Spanner::setTick2(const Fraction& f)
 void Spanner::setTicks(const Fraction& f)
 {
     _ticks = f;
-    if (score()) {
-        score()->spannerMap().setDirty();
-    }
+    SpannerMap::updateSpanner(this);
 }
 
 //---------------------------------------------------------
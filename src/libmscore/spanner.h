@@ -19,6 +19,7 @@
 
 namespace Ms {
 class Spanner;
+struct SpannerMapNode;
 
 //---------------------------------------------------------
 //   SpannerSegmentType
@@ -146,6 +147,7 @@ private:
     Fraction _ticks        { Fraction(0, 1) };
     int _track2            { -1 };
     bool _broken           { false };
+    SpannerMapNode* _mapNode { nullptr };         // entry in the spanner map of the score, not copied
 
     std::vector<SpannerSegment*> segments;
     std::deque<SpannerSegment*> unusedSegments;   // Currently unused segments which can be reused later.
@@ -193,6 +195,9 @@ public:
     void setTick2(const Fraction&);
     void setTicks(const Fraction&);
 
+    SpannerMapNode* mapNode() const { return _mapNode; }
+    void setMapNode(SpannerMapNode* n) { _mapNode = n; }
+
     int track2() const { return _track2; }
     void setTrack2(int v) { _track2 = v; }
     int effectiveTrack2() const { return _track2 == -1 ? track() : _track2; }
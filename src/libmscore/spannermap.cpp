@@ -10,33 +10,261 @@
 //  the file LICENCE.GPL
 //=============================================================================
 
+#include <algorithm>
+#include <cstdlib>
+
 #include "spannermap.h"
 #include "spanner.h"
 
 namespace Ms {
 //---------------------------------------------------------
-//   SpannerMap
+//   height
+//---------------------------------------------------------
+
+static int height(const SpannerMapNode* n)
+{
+    return n ? n->height : 0;
+}
+
+//---------------------------------------------------------
+//   before
+//    order of the tree: start tick, then insertion
+//---------------------------------------------------------
+
+static bool before(const SpannerMapNode* a, const SpannerMapNode* b)
+{
+    return a->start < b->start || (a->start == b->start && a->serial < b->serial);
+}
+
+//---------------------------------------------------------
+//   fixup
+//    recompute height and maxStop of n from its children
+//---------------------------------------------------------
+
+static void fixup(SpannerMapNode* n)
+{
+    n->height  = 1 + std::max(height(n->left), height(n->right));
+    n->maxStop = n->stop;
+    if (n->left) {
+        n->maxStop = std::max(n->maxStop, n->left->maxStop);
+    }
+    if (n->right) {
+        n->maxStop = std::max(n->maxStop, n->right->maxStop);
+    }
+}
+
+//---------------------------------------------------------
+//   rotateLeft
+//---------------------------------------------------------
+
+static SpannerMapNode* rotateLeft(SpannerMapNode* n)
+{
+    SpannerMapNode* r = n->right;
+    n->right = r->left;
+    r->left  = n;
+    fixup(n);
+    fixup(r);
+    return r;
+}
+
+//---------------------------------------------------------
+//   rotateRight
+//---------------------------------------------------------
+
+static SpannerMapNode* rotateRight(SpannerMapNode* n)
+{
+    SpannerMapNode* l = n->left;
+    n->left  = l->right;
+    l->right = n;
+    fixup(n);
+    fixup(l);
+    return l;
+}
+
+//---------------------------------------------------------
+//   balance
+//    restore the AVL condition at n after one of its
+//    subtrees changed height by one; return the new root
+//    of the subtree
+//---------------------------------------------------------
+
+static SpannerMapNode* balance(SpannerMapNode* n)
+{
+    fixup(n);
+    int bf = height(n->left) - height(n->right);
+    if (bf > 1) {
+        if (height(n->left->left) < height(n->left->right)) {
+            n->left = rotateLeft(n->left);
+        }
+        return rotateRight(n);
+    }
+    if (bf < -1) {
+        if (height(n->right->right) < height(n->right->left)) {
+            n->right = rotateRight(n->right);
+        }
+        return rotateLeft(n);
+    }
+    return n;
+}
+
+//---------------------------------------------------------
+//   insertNode
+//---------------------------------------------------------
+
+static SpannerMapNode* insertNode(SpannerMapNode* t, SpannerMapNode* n)
+{
+    if (!t) {
+        n->left  = nullptr;
+        n->right = nullptr;
+        fixup(n);
+        return n;
+    }
+    if (before(n, t)) {
+        t->left = insertNode(t->left, n);
+    } else {
+        t->right = insertNode(t->right, n);
+    }
+    return balance(t);
+}
+
+//---------------------------------------------------------
+//   removeFirst
+//    detach the first node of t into first
 //---------------------------------------------------------
 
-SpannerMap::SpannerMap()
-    : std::multimap<int, Spanner*>()
+static SpannerMapNode* removeFirst(SpannerMapNode* t, SpannerMapNode*& first)
 {
-    dirty = true;
+    if (!t->left) {
+        first = t;
+        return t->right;
+    }
+    t->left = removeFirst(t->left, first);
+    return balance(t);
+}
+
+//---------------------------------------------------------
+//   removeNode
+//    detach n from t; n must be in t with the start it
+//    was inserted with
+//---------------------------------------------------------
+
+static SpannerMapNode* removeNode(SpannerMapNode* t, SpannerMapNode* n)
+{
+    Q_ASSERT(t);
+    if (t == n) {
+        if (!t->left) {
+            return t->right;
+        }
+        if (!t->right) {
+            return t->left;
+        }
+        SpannerMapNode* next;
+        SpannerMapNode* right = removeFirst(t->right, next);
+        next->left  = t->left;
+        next->right = right;
+        return balance(next);
+    }
+    if (before(n, t)) {
+        t->left = removeNode(t->left, n);
+    } else {
+        t->right = removeNode(t->right, n);
+    }
+    return balance(t);
+}
+
+//---------------------------------------------------------
+//   deleteNodes
+//---------------------------------------------------------
+
+static void deleteNodes(SpannerMapNode* t)
+{
+    while (t) {
+        deleteNodes(t->left);
+        if (t->spanner) {
+            t->spanner->setMapNode(nullptr);
+        }
+        SpannerMapNode* right = t->right;
+        delete t;
+        t = right;
+    }
+}
+
+//---------------------------------------------------------
+//   findOverlapping
+//---------------------------------------------------------
+
+static void findOverlapping(const SpannerMapNode* t, int start, int stop, std::vector<Interval<Spanner*> >& results)
+{
+    while (t && t->maxStop >= start) {
+        findOverlapping(t->left, start, stop, results);
+        if (t->start > stop) {
+            return;
+        }
+        if (t->stop >= start) {
+            results.push_back(Interval<Spanner*>(t->start, t->stop, t->spanner));
+        }
+        t = t->right;
+    }
+}
+
+//---------------------------------------------------------
+//   findContained
+//---------------------------------------------------------
+
+static void findContained(const SpannerMapNode* t, int start, int stop, std::vector<Interval<Spanner*> >& results)
+{
+    while (t) {
+        if (t->start >= start) {
+            findContained(t->left, start, stop, results);
+        }
+        if (t->start > stop) {
+            return;
+        }
+        if (t->start >= start && t->stop <= stop) {
+            results.push_back(Interval<Spanner*>(t->start, t->stop, t->spanner));
+        }
+        t = t->right;
+    }
+}
+
+//---------------------------------------------------------
+//   ~SpannerMap
+//---------------------------------------------------------
+
+SpannerMap::~SpannerMap()
+{
+    deleteNodes(_root);
 }
 
 //---------------------------------------------------------
 //   update
-//   updates the internal lookup tree, not the map itself
+//    move n to the current ticks of its spanner
 //---------------------------------------------------------
 
-void SpannerMap::update() const
+void SpannerMap::update(SpannerMapNode* n)
 {
-    std::vector< ::Interval<Spanner*> > intervals;
-    for (auto i : *this) {
-        intervals.push_back(Interval<Spanner*>(i.second->tick().ticks(), i.second->tick2().ticks(), i.second));
+    int start = n->spanner->tick().ticks();
+    int stop  = n->spanner->tick2().ticks();
+    if (start == n->start && stop == n->stop) {
+        return;
+    }
+    _root    = removeNode(_root, n);
+    n->start = start;
+    n->stop  = stop;
+    _root    = insertNode(_root, n);
+}
+
+//---------------------------------------------------------
+//   updateSpanner
+//    update the map of s, if any, after the ticks of s
+//    changed
+//---------------------------------------------------------
+
+void SpannerMap::updateSpanner(Spanner* s)
+{
+    if (SpannerMapNode* n = s->mapNode()) {
+        n->map->update(n);
     }
-    tree = IntervalTree<Spanner*>(intervals);
-    dirty = false;
 }
 
 //---------------------------------------------------------
@@ -45,11 +273,8 @@ void SpannerMap::update() const
 
 const std::vector<Interval<Spanner*> >& SpannerMap::findContained(int start, int stop)
 {
-    if (dirty) {
-        update();
-    }
     results.clear();
-    tree.findContained(start, stop, results);
+    Ms::findContained(_root, start, stop, results);
     return results;
 }
 
@@ -59,11 +284,8 @@ const std::vector<Interval<Spanner*> >& SpannerMap::findContained(int start, int
 
 const std::vector<Interval<Spanner*> >& SpannerMap::findOverlapping(int start, int stop)
 {
-    if (dirty) {
-        update();
-    }
     results.clear();
-    tree.findOverlapping(start, stop, results);
+    Ms::findOverlapping(_root, start, stop, results);
     return results;
 }
 
@@ -73,35 +295,53 @@ const std::vector<Interval<Spanner*> >& SpannerMap::findOverlapping(int start, i
 
 void SpannerMap::addSpanner(Spanner* s)
 {
-#if 0
-#ifndef NDEBUG
-    // check if spanner already in list
-    for (auto i = begin(); i != end(); ++i) {
-        if (i->second == s) {
-            qFatal("SpannerMap::addSpanner: %s already in list %p", s->name(), s);
+    if (SpannerMapNode* n = s->mapNode()) {
+        if (n->map == this) {
+            qDebug("SpannerMap::addSpanner: %s already in list %p", s->name(), s);
+            return;
         }
+        n->map->removeSpanner(s);
     }
-#endif
-#endif
-    insert(std::pair<int,Spanner*>(s->tick().ticks(), s));
-    dirty = true;
+    SpannerMapNode* n = new SpannerMapNode;
+    n->map     = this;
+    n->spanner = s;
+    n->entry   = insert(std::pair<int,Spanner*>(s->tick().ticks(), s));
+    n->start   = s->tick().ticks();
+    n->stop    = s->tick2().ticks();
+    n->serial  = _serial++;
+    _root      = insertNode(_root, n);
+    s->setMapNode(n);
 }
 
 //---------------------------------------------------------
 //   removeSpanner
+//    the node of s is the handle to its entry, no search
+//    is needed
 //---------------------------------------------------------
 
 bool SpannerMap::removeSpanner(Spanner* s)
 {
-    for (auto i = begin(); i != end(); ++i) {
-        if (i->second == s) {
-            erase(i);
-            dirty = true;
-            return true;
-        }
+    SpannerMapNode* n = s->mapNode();
+    if (!n || n->map != this) {
+        qDebug("%s (%p) not found", s->name(), s);
+        return false;
     }
-    qDebug("%s (%p) not found", s->name(), s);
-    return false;
+    erase(n->entry);
+    _root = removeNode(_root, n);
+    s->setMapNode(nullptr);
+    delete n;
+    return true;
+}
+
+//---------------------------------------------------------
+//   clear
+//---------------------------------------------------------
+
+void SpannerMap::clear()
+{
+    std::multimap<int, Spanner*>::clear();
+    deleteNodes(_root);
+    _root = nullptr;
 }
 
 #ifndef NDEBUG
@@ -117,5 +357,51 @@ void SpannerMap::dump() const
     }
 }
 
+//---------------------------------------------------------
+//   checkNode
+//    return the number of nodes of t, -1 if t is broken
+//---------------------------------------------------------
+
+static int checkNode(const SpannerMapNode* t, const SpannerMap* map)
+{
+    if (!t) {
+        return 0;
+    }
+    int nl = checkNode(t->left, map);
+    int nr = checkNode(t->right, map);
+    if (nl < 0 || nr < 0) {
+        return -1;
+    }
+    int maxStop = t->stop;
+    if (t->left) {
+        maxStop = std::max(maxStop, t->left->maxStop);
+    }
+    if (t->right) {
+        maxStop = std::max(maxStop, t->right->maxStop);
+    }
+    if (t->map != map || t->maxStop != maxStop
+        || t->height != 1 + std::max(height(t->left), height(t->right))
+        || std::abs(height(t->left) - height(t->right)) > 1
+        || (t->left && !before(t->left, t))
+        || (t->right && !before(t, t->right))
+        || (t->spanner && (t->spanner->mapNode() != t
+                           || t->spanner->tick().ticks() != t->start
+                           || t->spanner->tick2().ticks() != t->stop))) {
+        return -1;
+    }
+    return nl + nr + 1;
+}
+
+//---------------------------------------------------------
+//   check
+//    verify the tree against the map and the ticks of the
+//    spanners
+//---------------------------------------------------------
+
+bool SpannerMap::check() const
+{
+    return checkNode(_root, this) == int(size());
+}
+
 #endif
 }     // namespace Ms
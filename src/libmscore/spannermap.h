@@ -18,19 +18,53 @@
 
 namespace Ms {
 class Spanner;
+class SpannerMap;
+
+//---------------------------------------------------------
+//   SpannerMapNode
+//    node of the interval tree of a SpannerMap; also the
+//    handle of a spanner in the map, see Spanner::mapNode
+//---------------------------------------------------------
+
+struct SpannerMapNode {
+    SpannerMap* map;
+    Spanner* spanner;                               ///< null if the spanner was deleted
+    std::multimap<int, Spanner*>::iterator entry;
+    int start;
+    int stop;
+    int serial;                                     ///< orders spanners with the same start
+    int maxStop;                                    ///< largest stop of the subtree
+    int height;
+    SpannerMapNode* left  { nullptr };
+    SpannerMapNode* right { nullptr };
+};
 
 //---------------------------------------------------------
 //   SpannerMap
+//    the spanners of a score by start tick.
+//
+//    An augmented AVL tree ordered by start tick and
+//    insertion order, with the largest stop tick of each
+//    subtree, answers the interval queries. It is updated
+//    on every insertion, removal or change of the ticks of
+//    a spanner, so that queries never rebuild it. Results
+//    are in the order of the tree.
 //---------------------------------------------------------
 
 class SpannerMap : std::multimap<int, Spanner*>
 {
-    mutable bool dirty;
-    mutable IntervalTree<Spanner*> tree;
+    SpannerMapNode* _root { nullptr };
+    int _serial           { 0 };
     std::vector< ::Interval<Spanner*> > results;
 
+    void update(SpannerMapNode* n);
+
 public:
-    SpannerMap();
+    SpannerMap() = default;
+    SpannerMap(const SpannerMap&) = delete;
+    SpannerMap& operator=(const SpannerMap&) = delete;
+    ~SpannerMap();
+
     const std::vector< ::Interval<Spanner*> >& findContained(int start, int stop);
     const std::vector< ::Interval<Spanner*> >& findOverlapping(int start, int stop);
     const std::multimap<int, Spanner*>& map() const { return *this; }
@@ -44,11 +78,11 @@ public:
     std::multimap<int,Spanner*>::const_iterator cend() const { return std::multimap<int, Spanner*>::cend(); }
     void addSpanner(Spanner* s);
     bool removeSpanner(Spanner* s);
-    void clear() { std::multimap<int, Spanner*>::clear(); dirty = true; }
-    void update() const;
-    void setDirty() const { dirty = true; }     // must be called if a spanner changes start/length
+    void clear();
+    static void updateSpanner(Spanner* s);     // must be called if a spanner changes start/length
 #ifndef NDEBUG
     void dump() const;
+    bool check() const;
 #endif
 };
 }     // namespace Ms
@@ -14,6 +14,7 @@
 #include "measure.h"
 #include "segment.h"
 #include "chordrest.h"
+#include "excerpt.h"
 #include "range.h"
 #include "tuplet.h"
 #include "spanner.h"
@@ -48,6 +49,9 @@ void Score::splitMeasure(Segment* segment)
         MScore::setError(CANNOT_SPLIT_MEASURE_TUPLET);
         return;
     }
+
+    // the measures of every part score change
+    Excerpt::readPartScores(excerpts());
     Measure* measure = segment->measure();
     for (int staffIdx = 0; staffIdx < nstaves(); ++staffIdx) {
         if (measure->isMeasureRepeatGroup(staffIdx)) {
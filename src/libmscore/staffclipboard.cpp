@@ -0,0 +1,290 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include "staffclipboard.h"
+
+#include "beam.h"
+#include "chord.h"
+#include "instrument.h"
+#include "measure.h"
+#include "note.h"
+#include "part.h"
+#include "score.h"
+#include "segment.h"
+#include "select.h"
+#include "spannermap.h"
+#include "staff.h"
+#include "tie.h"
+#include "tremolo.h"
+
+namespace Ms {
+//---------------------------------------------------------
+//   current
+//---------------------------------------------------------
+
+StaffClipboard*& StaffClipboard::current()
+{
+    static StaffClipboard* clipboard = nullptr;
+    return clipboard;
+}
+
+//---------------------------------------------------------
+//   ~StaffClipboard
+//---------------------------------------------------------
+
+StaffClipboard::~StaffClipboard()
+{
+    for (StaffData& sd : _staffData) {
+        for (Item& item : sd.items) {
+            delete item.element;
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   copy
+//    remember the selection next to the xml put on
+//    the clipboard; a selection which cannot be pasted
+//    from memory clears the previous one
+//---------------------------------------------------------
+
+void StaffClipboard::copy(const Selection& selection, const QByteArray& mimeData)
+{
+    clear();
+    if (!selection.isRange() || mimeData.isEmpty()) {
+        return;
+    }
+    StaffClipboard* clipboard = new StaffClipboard;
+    if (!clipboard->build(selection)) {
+        delete clipboard;
+        return;
+    }
+    clipboard->_mimeData = mimeData;
+    current() = clipboard;
+}
+
+//---------------------------------------------------------
+//   find
+//    return the clipboard if mimeData is the xml it was
+//    copied with and it can be pasted into score
+//---------------------------------------------------------
+
+const StaffClipboard* StaffClipboard::find(const Score* score, const QByteArray& mimeData)
+{
+    const StaffClipboard* clipboard = current();
+    if (!clipboard || clipboard->_score != score || clipboard->_mimeData != mimeData) {
+        return nullptr;
+    }
+    return clipboard;
+}
+
+//---------------------------------------------------------
+//   release
+//    called when score is deleted
+//---------------------------------------------------------
+
+void StaffClipboard::release(const Score* score)
+{
+    if (current() && current()->_score == score) {
+        clear();
+    }
+}
+
+//---------------------------------------------------------
+//   clear
+//---------------------------------------------------------
+
+void StaffClipboard::clear()
+{
+    delete current();
+    current() = nullptr;
+}
+
+//---------------------------------------------------------
+//   canCloneChordRest
+//    chord rests which paste from xml exactly like
+//    their clone
+//---------------------------------------------------------
+
+static bool canCloneChordRest(const ChordRest* cr)
+{
+    if (cr->isMeasureRepeat() || cr->tuplet()) {
+        return false;
+    }
+    // see ChordRest::writeBeam()
+    Beam* b = cr->beam();
+    if (b && (MScore::testMode || !b->generated())) {
+        return false;
+    }
+    if (!cr->isChord()) {
+        return true;
+    }
+    const Chord* c = toChord(cr);
+    if (c->tremolo() && c->tremolo()->twoNotes()) {
+        return false;
+    }
+    for (const Note* n : c->notes()) {
+        if (!n->spannerFor().empty() || !n->spannerBack().empty()) {
+            return false;
+        }
+    }
+    for (const Chord* gc : c->graceNotes()) {
+        for (const Note* n : gc->notes()) {
+            if (n->tieFor() || n->tieBack() || !n->spannerFor().empty() || !n->spannerBack().empty()) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+//---------------------------------------------------------
+//   canCloneAnnotation
+//---------------------------------------------------------
+
+static bool canCloneAnnotation(const Element* e)
+{
+    switch (e->type()) {
+    case ElementType::DYNAMIC:
+    case ElementType::STAFF_TEXT:
+    case ElementType::STICKING:
+    case ElementType::SYMBOL:
+        return true;
+    default:
+        return false;
+    }
+}
+
+//---------------------------------------------------------
+//   build
+//    clone the selected range in the order
+//    Score::writeSegments() writes it;
+//    return false if it has to be pasted from xml
+//---------------------------------------------------------
+
+bool StaffClipboard::build(const Selection& selection)
+{
+    Score* score = selection.score();
+    Segment* seg1 = selection.startSegment();
+    Segment* seg2 = selection.endSegment();
+    if (!score || !seg1) {
+        return false;
+    }
+    if (score->selectionFilter().filtered() != int(SelectionFilterType::ALL)) {
+        return false;
+    }
+    if (score->styleB(Sid::createMultiMeasureRests)) {
+        return false;
+    }
+
+    const Fraction tickStart = selection.tickStart();
+    const Fraction tickEnd = selection.tickEnd();
+    const int strack = selection.staffStart() * VOICES;
+    const int etrack = selection.staffEnd() * VOICES;
+
+    // spanners are only pasted from xml
+    for (auto i : score->spannerMap().findOverlapping(seg1->tick().ticks(), tickEnd.ticks())) {
+        Spanner* s = i.value;
+        if (s->generated() || s->isVolta()) {
+            continue;
+        }
+        if ((s->track() >= strack && s->track() < etrack)
+            || (s->effectiveTrack2() >= strack && s->effectiveTrack2() < etrack)) {
+            return false;
+        }
+    }
+
+    _score      = score;
+    _tickLen    = tickEnd - tickStart;
+    _staffStart = selection.staffStart();
+    _staves     = selection.staffEnd() - selection.staffStart();
+
+    for (int staffIdx = selection.staffStart(); staffIdx < selection.staffEnd(); ++staffIdx) {
+        _staffData.push_back(StaffData());
+        StaffData& sd = _staffData.back();
+        sd.srcStaffIdx = staffIdx;
+        sd.transpose = score->staff(staffIdx)->part()->instrument(seg1->tick())->transpose();
+        std::fill(sd.voiceOffset, sd.voiceOffset + VOICES, -1);
+
+        std::map<const Chord*, int> chordItem;
+        int startTrack = staffIdx * VOICES;
+        for (int track = startTrack; track < startTrack + VOICES; ++track) {
+            for (Segment* s = seg1; s && s != seg2; s = s->next1()) {
+                if (!s->enabled()) {
+                    continue;
+                }
+                Element* e = s->element(track);
+                if (e && sd.voiceOffset[track - startTrack] == -1) {
+                    sd.voiceOffset[track - startTrack] = (s->tick() - tickStart).ticks();
+                }
+                for (Element* a : s->annotations()) {
+                    if (a->track() != track || a->generated() || a->systemFlag()) {
+                        continue;
+                    }
+                    if (!canCloneAnnotation(a)) {
+                        return false;
+                    }
+                    Element* c = a->clone();
+                    c->setParent(nullptr);
+                    sd.items.push_back({ s->tick() - tickStart, track, c, {}, {} });
+                }
+                if (!e || e->generated()) {
+                    continue;
+                }
+                if (e->isClef() || e->isBreath()) {
+                    return false;
+                }
+                if (!e->isChordRest()) {
+                    continue;                       // not pasted
+                }
+                ChordRest* cr = toChordRest(e);
+                if (!canCloneChordRest(cr)) {
+                    return false;
+                }
+                if (cr->isChord()) {
+                    chordItem[toChord(cr)] = int(sd.items.size());
+                }
+                ChordRest* c = toChordRest(cr->clone());
+                c->setParent(nullptr);
+                sd.items.push_back({ s->tick() - tickStart, track, c, {}, {} });
+            }
+        }
+
+        // ties; the clones only keep the tie start
+        for (const auto& ci : chordItem) {
+            const Chord* chord = ci.first;
+            const std::vector<Note*>& nl = chord->notes();
+            for (int i = 0; i < int(nl.size()); ++i) {
+                Tie* tie = nl[i]->tieFor();
+                if (!tie) {
+                    continue;
+                }
+                Note* endNote = tie->endNote();
+                auto ei = endNote ? chordItem.find(endNote->chord()) : chordItem.end();
+                if (ei == chordItem.end() || ei->second < ci.second || endNote->track() != chord->track()) {
+                    // a tie out of the range is deleted on paste, see Score::pasteStaff()
+                    if (chord->tick() + chord->actualTicks() < tickEnd) {
+                        return false;
+                    }
+                    continue;
+                }
+                const std::vector<Note*>& enl = ei->first->notes();
+                int endIdx = int(std::find(enl.begin(), enl.end(), endNote) - enl.begin());
+                sd.items[ci.second].tiesStarted.push_back(int(sd.ties.size()));
+                sd.items[ei->second].tiesEnded.push_back(int(sd.ties.size()));
+                sd.ties.push_back({ i, endIdx });
+            }
+        }
+    }
+    return true;
+}
+}     // namespace Ms
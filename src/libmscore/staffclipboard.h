@@ -0,0 +1,90 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __STAFFCLIPBOARD_H__
+#define __STAFFCLIPBOARD_H__
+
+#include <QByteArray>
+
+#include "fraction.h"
+#include "interval.h"
+#include "mscore.h"
+
+namespace Ms {
+class Element;
+class Score;
+class Selection;
+
+//---------------------------------------------------------
+//   StaffClipboard
+//    In process copy of a range selection, kept next to
+//    the StaffList xml put on the system clipboard.
+//
+//    It holds clones of the copied chords, rests and
+//    annotations together with the ties connecting them,
+//    so that pasting into the score they were copied from
+//    does not need to write and parse the xml again.
+//    Only ranges which paste exactly like their xml are
+//    taken (no tuplets, manual beams, spanners, clefs...);
+//    for everything else, and for any data coming from
+//    another process or score, the xml is used.
+//---------------------------------------------------------
+
+class StaffClipboard
+{
+    struct Item {
+        Fraction rtick;                     ///< relative to the start of the range
+        int track;                          ///< source track
+        Element* element;                   ///< ChordRest or annotation, not part of any score
+        std::vector<int> tiesStarted;       ///< index into StaffData::ties
+        std::vector<int> tiesEnded;
+    };
+
+    struct TieLink {
+        int startNote;                      ///< index into the notes of the start chord
+        int endNote;                        ///< index into the notes of the end chord
+    };
+
+    struct StaffData {
+        int srcStaffIdx;
+        Interval transpose;
+        int voiceOffset[VOICES];
+        std::vector<Item> items;            ///< in the order the xml writes them
+        std::vector<TieLink> ties;
+    };
+
+    const Score* _score { nullptr };
+    QByteArray _mimeData;
+    Fraction _tickLen;
+    int _staffStart { 0 };
+    int _staves { 0 };
+    std::vector<StaffData> _staffData;
+
+    static StaffClipboard*& current();
+
+    bool build(const Selection& selection);
+
+    friend class Score;                     // Score::pasteStaff()
+
+public:
+    StaffClipboard() = default;
+    StaffClipboard(const StaffClipboard&) = delete;
+    StaffClipboard& operator=(const StaffClipboard&) = delete;
+    ~StaffClipboard();
+
+    static void copy(const Selection& selection, const QByteArray& mimeData);
+    static const StaffClipboard* find(const Score* score, const QByteArray& mimeData);
+    static void release(const Score* score);
+    static void clear();
+};
+}     // namespace Ms
+#endif
@@ -32,6 +32,7 @@ class Stem final : public Element
 
 public:
     Stem(Score* = 0);
+    MS_POOLED_ELEMENT(Stem)
     Stem& operator=(const Stem&) = delete;
 
     Stem* clone() const override { return new Stem(*this); }
@@ -10,6 +10,7 @@
 //  the file LICENCE.GPL
 //=============================================================================
 
+#include <atomic>
 #include <QDebug>
 
 #include "mscore.h"
@@ -2618,8 +2619,11 @@ void MStyle::setChordList(ChordList* cl, bool custom)
 
 void MStyle::set(const Sid t, const QVariant& val)
 {
+    static std::atomic<int> serials { 0 };
+
     const int idx = int(t);
     _values[idx] = val;
+    _serial = ++serials;
     if (t == Sid::spatium) {
         precomputeValues();
     } else {
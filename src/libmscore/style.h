@@ -1346,6 +1346,7 @@ class MStyle
 
     ChordList _chordList;
     bool _customChordList;          // if true, chordlist will be saved as part of score
+    int _serial { 0 };              // changes with every value set
 
 public:
     MStyle();
@@ -1354,6 +1355,7 @@ public:
     const QVariant& value(Sid idx) const;
     qreal pvalue(Sid idx) const { return _precomputedValues[int(idx)]; }
     void set(Sid idx, const QVariant& v);
+    int serial() const { return _serial; }
 
     bool isDefault(Sid idx) const;
 
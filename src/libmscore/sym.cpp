@@ -11,6 +11,7 @@
 //=============================================================================
 
 #include <cmath>
+#include <mutex>
 #include <QFontDatabase>
 #include <QJsonParseError>
 #include <QJsonDocument>
@@ -6670,12 +6671,21 @@ void ScoreFont::load()
 #endif
 }
 
+//---------------------------------------------------------
+//   fontLoadMutex
+//    fonts are loaded on first use, which may happen on
+//    several threads reading or laying out part scores
+//---------------------------------------------------------
+
+static std::recursive_mutex fontLoadMutex;
+
 //---------------------------------------------------------
 //   fontFactory
 //---------------------------------------------------------
 
 ScoreFont* ScoreFont::fontFactory(QString s)
 {
+    std::lock_guard<std::recursive_mutex> lock(fontLoadMutex);
     ScoreFont* f = 0;
     for (ScoreFont& sf : _scoreFonts) {
         if (sf.name().toLower() == s.toLower()) {     // ignore letter case
@@ -6704,6 +6714,7 @@ ScoreFont* ScoreFont::fontFactory(QString s)
 
 ScoreFont* ScoreFont::fallbackFont()
 {
+    std::lock_guard<std::recursive_mutex> lock(fontLoadMutex);
     ScoreFont* f = &_scoreFonts[FALLBACK_FONT];
     if (!f->face) {
         f->load();
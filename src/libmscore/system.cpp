@@ -107,8 +107,85 @@ void System::clear()
     }
     _spannerSegments.clear();
     // _systemDividers are reused
+    rebuildBspTree();
 }
 
+//---------------------------------------------------------
+//   items
+//    The spatial index is kept per system so that a layout
+//    only invalidates the systems it actually touched;
+//    systems which are only moved on the page stay valid.
+//---------------------------------------------------------
+
+QList<Element*> System::items(const QRectF& r)
+{
+#ifdef USE_BSP
+    if (!bspTreeValid) {
+        doRebuildBspTree();
+    }
+    if (!bspRect.translated(pos()).intersects(r)) {
+        return QList<Element*>();
+    }
+    bspTree.setOrigin(pos());
+    return bspTree.items(r);
+#else
+    Q_UNUSED(r)
+    return QList<Element*>();
+#endif
+}
+
+QList<Element*> System::items(const QPointF& p)
+{
+#ifdef USE_BSP
+    if (!bspTreeValid) {
+        doRebuildBspTree();
+    }
+    if (!bspRect.translated(pos()).contains(p)) {
+        return QList<Element*>();
+    }
+    bspTree.setOrigin(pos());
+    return bspTree.items(p);
+#else
+    Q_UNUSED(p)
+    return QList<Element*>();
+#endif
+}
+
+#ifdef USE_BSP
+//---------------------------------------------------------
+//   collectElements
+//---------------------------------------------------------
+
+static void collectElements(void* data, Element* e)
+{
+    static_cast<QList<Element*>*>(data)->append(e);
+}
+
+//---------------------------------------------------------
+//   doRebuildBspTree
+//---------------------------------------------------------
+
+void System::doRebuildBspTree()
+{
+    QList<Element*> el;
+    scanElements(&el, collectElements, false);
+
+    const QPointF origin = pos();
+    QRectF r;
+    for (const Element* e : el) {
+        r |= e->pageBoundingRect().translated(-origin);
+    }
+    bspTree.initialize(r, el.size());
+    bspTree.setOrigin(origin);
+    for (Element* e : el) {
+        bspTree.insert(e);
+    }
+    bspRect = r;
+    bspTreeValid = true;
+}
+
+#endif
+
 //---------------------------------------------------------
 //   appendMeasure
 //---------------------------------------------------------
@@ -209,6 +286,7 @@ void System::adjustStavesNumber(int nstaves)
 
 void System::layoutSystem(qreal xo1)
 {
+    rebuildBspTree();
     if (_staves.empty()) {                 // ignore vbox
         return;
     }
@@ -515,6 +593,7 @@ int System::firstVisibleStaff() const
 
 void System::layout2()
 {
+    rebuildBspTree();
     Box* vb = vbox();
     if (vb) {
         vb->layout();
@@ -990,6 +1069,7 @@ void System::add(Element* el)
         return;
     }
 // qDebug("%p System::add: %p %s", this, el, el->name());
+    rebuildBspTree();
 
     el->setParent(this);
     switch (el->type()) {
@@ -1079,6 +1159,7 @@ void System::add(Element* el)
 
 void System::remove(Element* el)
 {
+    rebuildBspTree();
     switch (el->type()) {
     case ElementType::INSTRUMENT_NAME:
         _staves[el->staffIdx()]->instrumentNames.removeOne(toInstrumentName(el));
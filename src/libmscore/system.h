@@ -22,6 +22,7 @@
 #include "spatium.h"
 #include "symbol.h"
 #include "skyline.h"
+#include "bsp.h"
 
 namespace Ms {
 class Staff;
@@ -95,6 +96,13 @@ class System final : public Element
     mutable bool fixedDownDistance { false };
     qreal _distance                { 0.0 };         // temp. variable used during layout
 
+#ifdef USE_BSP
+    BspTree bspTree;                                // in system coordinates, independent of system position
+    QRectF bspRect;                                 // bounding rectangle of all indexed elements
+    void doRebuildBspTree();
+#endif
+    bool bspTreeValid              { false };
+
     int firstVisibleSysStaff() const;
     int lastVisibleSysStaff() const;
 
@@ -135,6 +143,10 @@ public:
     void layout2();                       ///< Called after Measure layout.
     void clear();                         ///< Clear measure list.
 
+    QList<Element*> items(const QRectF& r);       // r in page coordinates
+    QList<Element*> items(const QPointF& p);
+    void rebuildBspTree() { bspTreeValid = false; }
+
     QRectF bboxStaff(int staff) const { return _staves[staff]->bbox(); }
     QList<SysStaff*>* staves() { return &_staves; }
     const QList<SysStaff*>* staves() const { return &_staves; }
@@ -12,6 +12,7 @@
 
 #include "tempo.h"
 
+#include <algorithm>
 #include <cmath>
 
 #include "xml.h"
@@ -117,6 +118,22 @@ void TempoMap::normalize()
         tempo = e->second.tempo;
     }
     ++_tempoSN;
+    updateTimeIndex();
+}
+
+//---------------------------------------------------------
+//   updateTimeIndex
+//    event times are increasing with ticks, so a copy of
+//    the events in map order can be searched by time
+//---------------------------------------------------------
+
+void TempoMap::updateTimeIndex()
+{
+    _timeIndex.clear();
+    _timeIndex.reserve(size());
+    for (auto e = begin(); e != end(); ++e) {
+        _timeIndex.push_back({ e->second.time, e->second.pause, e->second.tempo, e->first });
+    }
 }
 
 //---------------------------------------------------------
@@ -140,6 +157,7 @@ void TempoMap::clear()
 {
     std::map<int,TEvent>::clear();
     ++_tempoSN;
+    updateTimeIndex();
 }
 
 //---------------------------------------------------------
@@ -157,6 +175,7 @@ void TempoMap::clearRange(int tick1, int tick2)
     }
     erase(first, last);
     ++_tempoSN;
+    updateTimeIndex();
 }
 
 //---------------------------------------------------------
@@ -291,23 +310,22 @@ qreal TempoMap::tick2time(int tick, int* sn) const
 int TempoMap::time2tick(qreal time, int* sn) const
 {
     int tick     = 0;
-    qreal delta = time;
-    qreal tempo = _tempo;
+    qreal delta = 0.0;
+    qreal tempo = 2.0;
 
-    delta = 0.0;
-    tempo = 2.0;
-    for (auto e = begin(); e != end(); ++e) {
-        // if in a pause period, wait on previous tick
-        if ((time <= e->second.time) && (time > e->second.time - e->second.pause)) {
-            delta = (time - (e->second.time - e->second.pause) + delta);
-            break;
-        }
-        if (e->second.time >= time) {
-            break;
-        }
-        delta = e->second.time;
-        tick  = e->first;
-        tempo = e->second.tempo;
+    // first event not before time
+    auto e = std::lower_bound(_timeIndex.begin(), _timeIndex.end(), time, [](const TimeIndexEntry& te, qreal t) {
+            return te.time < t;
+        });
+    if (e != _timeIndex.begin()) {
+        auto pe = e - 1;
+        delta = pe->time;
+        tick  = pe->tick;
+        tempo = pe->tempo;
+    }
+    // if in a pause period, wait on previous tick
+    if (e != _timeIndex.end() && time > e->time - e->pause) {
+        delta = (time - (e->time - e->pause) + delta);
     }
     delta = time - delta;
     tick += lrint(delta * _relTempo * MScore::division * tempo);
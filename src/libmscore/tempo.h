@@ -14,6 +14,7 @@
 #define __AL_TEMPO_H__
 
 #include <map>
+#include <vector>
 #include <QFlags>
 
 namespace Ms {
@@ -48,12 +49,21 @@ struct TEvent {
 
 class TempoMap : public std::map<int, TEvent>
 {
+    struct TimeIndexEntry {
+        qreal time;
+        qreal pause;
+        qreal tempo;
+        int tick;
+    };
+
     int _tempoSN;             // serial no to track tempo changes
     qreal _tempo;             // tempo if not using tempo list (beats per second)
     qreal _relTempo;          // rel. tempo
+    std::vector<TimeIndexEntry> _timeIndex;     // events in map order for binary search by time
 
     void normalize();
     void del(int tick);
+    void updateTimeIndex();
 
 public:
     TempoMap();
@@ -259,7 +259,7 @@ QRectF TextCursor::cursorRect() const
     const TextFragment* fragment = tline.fragment(column());
 
     QFont _font  = fragment ? fragment->font(_text) : _text->font();
-    qreal ascent = QFontMetricsF(_font, MScore::paintDevice()).ascent();
+    qreal ascent = _text->score()->fontMetricsCache().metrics(_font).ascent();
     qreal h = ascent;
     qreal x = tline.xpos(column(), _text);
     qreal y = tline.y() - ascent * .9;
@@ -1000,7 +1000,7 @@ QFont TextFragment::font(const TextBase* t) const
 
         // check if all symbols are available
         font.setFamily(family);
-        QFontMetricsF fm(font);
+        const QFontMetricsF& fm = t->score()->fontMetricsCache().defaultMetrics(font);
 
         bool fail = false;
         for (int i = 0; i < text.size(); ++i) {
@@ -1100,7 +1100,7 @@ void TextBlock::layout(TextBase* t)
         auto fi = _fragments.begin();
         TextFragment& f = *fi;
         f.pos.setX(x);
-        QFontMetricsF fm(f.font(t), MScore::paintDevice());
+        const QFontMetricsF& fm = t->score()->fontMetricsCache().metrics(f.font(t));
         if (f.format.valign() != VerticalAlignment::AlignNormal) {
             qreal voffset = fm.xHeight() / subScriptSize;   // use original height
             if (f.format.valign() == VerticalAlignment::AlignSubScript) {
@@ -1118,11 +1118,13 @@ void TextBlock::layout(TextBase* t)
         _bbox |= temp;
         _lineSpacing = qMax(_lineSpacing, fm.lineSpacing());
     } else {
+        FontMetricsCache& cache = t->score()->fontMetricsCache();
         const auto fiLast = --_fragments.end();
         for (auto fi = _fragments.begin(); fi != _fragments.end(); ++fi) {
             TextFragment& f = *fi;
             f.pos.setX(x);
-            QFontMetricsF fm(f.font(t), MScore::paintDevice());
+            const QFont font = f.font(t);
+            const QFontMetricsF& fm = cache.metrics(font);
             if (f.format.valign() != VerticalAlignment::AlignNormal) {
                 qreal voffset = fm.xHeight() / subScriptSize;           // use original height
                 if (f.format.valign() == VerticalAlignment::AlignSubScript) {
@@ -1138,11 +1140,11 @@ void TextBlock::layout(TextBase* t)
             // Optimization: don't calculate character position
             // for the next fragment if there is no next fragment
             if (fi != fiLast) {
-                const qreal w  = fm.width(f.text);
+                const qreal w  = cache.width(font, f.text);
                 x += w;
             }
 
-            _bbox   |= fm.tightBoundingRect(f.text).translated(f.pos);
+            _bbox   |= cache.tightBoundingRect(font, f.text).translated(f.pos);
             _lineSpacing = qMax(_lineSpacing, fm.lineSpacing());
         }
     }
@@ -1190,7 +1192,7 @@ qreal TextBlock::xpos(int column, const TextBase* t) const
         if (column == col) {
             return f.pos.x();
         }
-        QFontMetricsF fm(f.font(t), MScore::paintDevice());
+        const QFontMetricsF& fm = t->score()->fontMetricsCache().metrics(f.font(t));
         int idx = 0;
         for (const QChar& c : f.text) {
             ++idx;
@@ -1290,12 +1292,12 @@ int TextBlock::column(qreal x, TextBase* t) const
             return col;
         }
         qreal px = 0.0;
+        const QFontMetricsF& fm = t->score()->fontMetricsCache().metrics(f.font(t));
         for (const QChar& c : f.text) {
             ++idx;
             if (c.isHighSurrogate()) {
                 continue;
             }
-            QFontMetricsF fm(f.font(t), MScore::paintDevice());
             qreal xo = fm.width(f.text.left(idx));
             if (x <= f.pos.x() + px + (xo - px) * .5) {
                 return col;
@@ -2043,7 +2045,7 @@ void TextBase::layoutFrame()
 //      if (empty()) {    // or bbox.width() <= 1.0
     if (bbox().width() <= 1.0 || bbox().height() < 1.0) {      // or bbox.width() <= 1.0
         // this does not work for Harmony:
-        QFontMetricsF fm = QFontMetricsF(font(), MScore::paintDevice());
+        const QFontMetricsF& fm = score()->fontMetricsCache().metrics(font());
         qreal ch = fm.ascent();
         qreal cw = fm.width('n');
         frame = QRectF(0.0, -ch, cw, ch);
@@ -2980,7 +2982,7 @@ QFont TextBase::font() const
 
 QFontMetricsF TextBase::fontMetrics() const
 {
-    return QFontMetricsF(font());
+    return score()->fontMetricsCache().defaultMetrics(font());
 }
 
 //---------------------------------------------------------
@@ -82,6 +82,7 @@ void TextBase::startEdit(EditData& ed)
 
     ted->oldXmlText = xmlText();
     ted->startUndoIdx = score()->undoStack()->getCurIdx();
+    score()->undoStack()->lockTrim();         // startUndoIdx has to stay valid until endEdit()
 
     if (layoutInvalid) {
         layout();
@@ -115,6 +116,8 @@ void TextBase::endEdit(EditData& ed)
         return;
     }
 
+    undo->unlockTrim();         // trimming is deferred to the end of the next command
+
     const QString actualXmlText = xmlText();
     const QString actualPlainText = plainText();
 
@@ -636,7 +636,7 @@ void Tie::calculateDirection()
 //    layout the first SpannerSegment of a slur
 //---------------------------------------------------------
 
-TieSegment* Tie::layoutFor(System* system)
+TieSegment* Tie::layoutFor(System* system, SlurTieLayout* l)
 {
     // do not layout ties in tablature if not showing back-tied fret marks
     StaffType* st = staff()->staffType(startNote() ? startNote()->tick() : Fraction(0, 1));
@@ -671,7 +671,7 @@ TieSegment* Tie::layoutFor(System* system)
         segment->setSystem(startNote()->chord()->segment()->measure()->system());
         SlurPos sPos;
         slurPos(&sPos);
-        segment->layoutSegment(sPos.p1, sPos.p2);
+        layoutSegment(segment, sPos.p1, sPos.p2, l);
         return segment;
     }
     calculateDirection();
@@ -692,7 +692,7 @@ TieSegment* Tie::layoutFor(System* system)
     fixupSegments(n);
     TieSegment* segment = segmentAt(0);
     segment->setSystem(system);   // Needed to populate System.spannerSegments
-    segment->layoutSegment(sPos.p1, sPos.p2);
+    layoutSegment(segment, sPos.p1, sPos.p2, l);
     segment->setSpannerSegmentType(sPos.system1
                                    != sPos.system2 ? SpannerSegmentType::BEGIN : SpannerSegmentType::SINGLE);
     return segment;
@@ -703,7 +703,7 @@ TieSegment* Tie::layoutFor(System* system)
 //    layout the second SpannerSegment of a split slur
 //---------------------------------------------------------
 
-TieSegment* Tie::layoutBack(System* system)
+TieSegment* Tie::layoutBack(System* system, SlurTieLayout* l)
 {
     // do not layout ties in tablature if not showing back-tied fret marks
     StaffType* st = staff()->staffType(startNote() ? startNote()->tick() : Fraction(0, 1));
@@ -741,7 +741,7 @@ TieSegment* Tie::layoutBack(System* system)
         x = 0.0;
     }
 
-    segment->layoutSegment(QPointF(x, sPos.p2.y()), sPos.p2);
+    layoutSegment(segment, QPointF(x, sPos.p2.y()), sPos.p2, l);
     segment->setSpannerSegmentType(SpannerSegmentType::END);
     return segment;
 }
@@ -43,7 +43,7 @@ public:
     int subtype() const override { return static_cast<int>(spanner()->type()); }
     void draw(QPainter*) const override;
 
-    void layoutSegment(const QPointF& p1, const QPointF& p2);
+    void layoutSegment(const QPointF& p1, const QPointF& p2) override;
 
     bool isEdited() const;
     void editDrag(EditData&) override;
@@ -79,8 +79,8 @@ public:
     void write(XmlWriter& xml) const override;
     void slurPos(SlurPos*) override;
 
-    TieSegment* layoutFor(System*);
-    TieSegment* layoutBack(System*);
+    TieSegment* layoutFor(System*, SlurTieLayout* = nullptr);
+    TieSegment* layoutBack(System*, SlurTieLayout* = nullptr);
 
     TieSegment* frontSegment() { return toTieSegment(Spanner::frontSegment()); }
     const TieSegment* frontSegment() const { return toTieSegment(Spanner::frontSegment()); }
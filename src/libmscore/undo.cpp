@@ -79,6 +79,7 @@
 #include "bracket.h"
 #include "fret.h"
 #include "textedit.h"
+#include "linkstage.h"
 
 namespace Ms {
 extern Measure* tick2measure(int tick);
@@ -144,6 +145,72 @@ void UndoCommand::cleanup(bool undo)
     }
 }
 
+//---------------------------------------------------------
+//   UndoCommand::byteSize
+//---------------------------------------------------------
+
+size_t UndoCommand::byteSize() const
+{
+    return sizeof(UndoCommand) + childrenByteSize();
+}
+
+//---------------------------------------------------------
+//   childrenByteSize
+//---------------------------------------------------------
+
+size_t UndoCommand::childrenByteSize() const
+{
+    size_t size = 0;
+    for (const UndoCommand* c : childList) {
+        size += sizeof(UndoCommand*) + c->byteSize();
+    }
+    return size;
+}
+
+//---------------------------------------------------------
+//   elementTreeByteSize
+//    rough estimate of the memory held by an element and
+//    all elements below it in the score tree
+//---------------------------------------------------------
+
+static size_t elementTreeByteSize(const ScoreElement* e)
+{
+    if (!e) {
+        return 0;
+    }
+    size_t size = sizeof(Element);
+    int n = e->treeChildCount();
+    for (int i = 0; i < n; ++i) {
+        size += elementTreeByteSize(e->treeChild(i));
+    }
+    return size;
+}
+
+//---------------------------------------------------------
+//   variantByteSize
+//---------------------------------------------------------
+
+static size_t variantByteSize(const QVariant& v)
+{
+    size_t size = sizeof(QVariant);
+    switch (v.type()) {
+    case QVariant::String:
+        size += v.toString().size() * sizeof(QChar);
+        break;
+    case QVariant::ByteArray:
+        size += v.toByteArray().size();
+        break;
+    case QVariant::List:
+        for (const QVariant& vv : v.toList()) {
+            size += variantByteSize(vv);
+        }
+        break;
+    default:
+        break;
+    }
+    return size;
+}
+
 //---------------------------------------------------------
 //   undo
 //---------------------------------------------------------
@@ -262,6 +329,8 @@ UndoStack::UndoStack()
     cleanState = 0;
     stateList.push_back(cleanState);
     nextState = 1;
+    _memoryLimit = MScore::undoMemoryLimit;
+    _depthLimit  = MScore::undoDepthLimit;
 }
 
 //---------------------------------------------------------
@@ -304,8 +373,19 @@ void UndoStack::push(UndoCommand* cmd, EditData* ed)
 
         cmd->redo(ed);
         delete cmd;
+        if (!LinkStage::current()) {
+            ++_changes;               // stages are counted once by LinkStage::merge()
+        }
+        return;
+    }
+    if (LinkStage* stage = LinkStage::current()) {
+        // building a part on a worker thread, see Excerpt::createExcerpts()
+        stage->addCommand(cmd);
+        cmd->redo(ed);
         return;
     }
+    ++_changes;
+    flushPropertyBatch();
 #ifndef QT_NO_DEBUG
     if (!strcmp(cmd->name(), "ChangeProperty")) {
         ChangeProperty* cp = static_cast<ChangeProperty*>(cmd);
@@ -314,10 +394,40 @@ void UndoStack::push(UndoCommand* cmd, EditData* ed)
         qDebug("<%s>", cmd->name());
     }
 #endif
+    if (coalesce(cmd, ed)) {
+        return;
+    }
     curCmd->appendChild(cmd);
     cmd->redo(ed);
 }
 
+//---------------------------------------------------------
+//   coalesce
+//    Consecutive changes of the same property of the same
+//    element within one macro only need to remember the
+//    value before the first change. Executes and deletes
+//    cmd and returns true if it could be merged.
+//---------------------------------------------------------
+
+bool UndoStack::coalesce(UndoCommand* cmd, EditData* ed)
+{
+    if (curCmd->empty() || cmd->childCount() || strcmp(cmd->name(), "ChangeProperty")) {
+        return false;
+    }
+    UndoCommand* last = curCmd->commands().back();
+    if (last->childCount() || strcmp(last->name(), "ChangeProperty")) {
+        return false;
+    }
+    ChangeProperty* cp = static_cast<ChangeProperty*>(cmd);
+    ChangeProperty* lp = static_cast<ChangeProperty*>(last);
+    if (cp->getElement() != lp->getElement() || cp->getId() != lp->getId()) {
+        return false;
+    }
+    cmd->redo(ed);
+    delete cmd;
+    return true;
+}
+
 //---------------------------------------------------------
 //   push1
 //---------------------------------------------------------
@@ -330,9 +440,65 @@ void UndoStack::push1(UndoCommand* cmd)
         }
         return;
     }
+    if (LinkStage* stage = LinkStage::current()) {
+        stage->addCommand(cmd);
+        return;
+    }
+    ++_changes;
+    flushPropertyBatch();
     curCmd->appendChild(cmd);
 }
 
+//---------------------------------------------------------
+//   flushPropertyBatch
+//    append the pending batch to the current macro so that
+//    commands pushed after it are undone before it
+//---------------------------------------------------------
+
+void UndoStack::flushPropertyBatch()
+{
+    if (!_propertyBatch) {
+        return;
+    }
+    if (curCmd && !_propertyBatch->empty()) {
+        curCmd->appendChild(_propertyBatch);
+    } else {
+        delete _propertyBatch;
+    }
+    _propertyBatch = nullptr;
+}
+
+//---------------------------------------------------------
+//   endPropertyBatch
+//---------------------------------------------------------
+
+void UndoStack::endPropertyBatch()
+{
+    if (_propertyBatchLevel == 0) {
+        qWarning("no active property batch");
+        return;
+    }
+    if (--_propertyBatchLevel == 0) {
+        flushPropertyBatch();
+    }
+}
+
+//---------------------------------------------------------
+//   pushBatchedProperty
+//    change a property as part of the current batch
+//    instead of creating a ChangeProperty command
+//---------------------------------------------------------
+
+void UndoStack::pushBatchedProperty(ScoreElement* e, Pid id, const QVariant& v, PropertyFlags ps)
+{
+    Q_ASSERT(propertyBatchActive());
+    ++_changes;
+    if (!_propertyBatch) {
+        _propertyBatch = new ChangePropertyBatch;
+    }
+    _propertyBatch->add(e, id, v, ps);
+}
+
 //---------------------------------------------------------
 //   remove
 //---------------------------------------------------------
@@ -376,6 +542,45 @@ void UndoStack::mergeCommands(int startIdx)
         startMacro->append(std::move(*list[idx]));
     }
     remove(startIdx + 1);   // TODO: remove from startIdx to curIdx only
+    startMacro->updateByteSize();
+}
+
+//---------------------------------------------------------
+//   byteSize
+//    approximate memory held by all undo/redo steps
+//---------------------------------------------------------
+
+size_t UndoStack::byteSize() const
+{
+    size_t size = 0;
+    for (const UndoMacro* m : list) {
+        size += m->cachedByteSize();
+    }
+    return size;
+}
+
+//---------------------------------------------------------
+//   trim
+//    drop the oldest undo steps until the stack fits
+//    into the memory and depth limits; the most recent
+//    undo step is always kept
+//---------------------------------------------------------
+
+void UndoStack::trim()
+{
+    if (_trimLock || curCmd) {
+        return;
+    }
+    size_t size = byteSize();
+    while (curIdx > 1
+           && ((_memoryLimit && size > _memoryLimit) || (_depthLimit > 0 && list.size() > _depthLimit))) {
+        UndoMacro* cmd = list.takeFirst();
+        stateList.erase(stateList.begin());
+        --curIdx;
+        size -= cmd->cachedByteSize();
+        cmd->cleanup(true);       // delete elements for which UndoCommand() holds ownership
+        delete cmd;
+    }
 }
 
 //---------------------------------------------------------
@@ -392,6 +597,7 @@ void UndoStack::pop()
     }
     UndoCommand* cmd = curCmd->removeChild();
     cmd->undo(0);
+    ++_changes;
 }
 
 //---------------------------------------------------------
@@ -406,6 +612,7 @@ void UndoStack::rollback()
     int idx = curIdx - 1;
     list[idx]->unwind();
     remove(idx);
+    ++_changes;
 }
 
 //---------------------------------------------------------
@@ -418,7 +625,9 @@ void UndoStack::endMacro(bool rollback)
         qWarning("not active");
         return;
     }
+    flushPropertyBatch();
     if (rollback) {
+        ++_changes;
         delete curCmd;
     } else {
         // remove redo stack
@@ -428,11 +637,15 @@ void UndoStack::endMacro(bool rollback)
             cmd->cleanup(false);        // delete elements for which UndoCommand() holds ownership
             delete cmd;
         }
+        curCmd->updateByteSize();
         list.append(curCmd);
         stateList.push_back(nextState++);
         ++curIdx;
     }
     curCmd = 0;
+    if (!rollback) {
+        trim();
+    }
 }
 
 //---------------------------------------------------------
@@ -480,6 +693,7 @@ void UndoStack::undo(EditData* ed)
         --curIdx;
         Q_ASSERT(curIdx >= 0);
         list[curIdx]->undo(ed);
+        ++_changes;
     }
 }
 
@@ -492,6 +706,7 @@ void UndoStack::redo(EditData* ed)
     qDebug() << "===";
     if (canRedo()) {
         list[curIdx++]->redo(ed);
+        ++_changes;
     }
 }
 
@@ -585,6 +800,13 @@ void UndoMacro::append(UndoMacro&& other)
     }
 }
 
+size_t UndoMacro::byteSize() const
+{
+    return sizeof(UndoMacro)
+           + (undoSelectionInfo.elements.size() + redoSelectionInfo.elements.size()) * sizeof(Element*)
+           + childrenByteSize();
+}
+
 //---------------------------------------------------------
 //   CloneVoice
 //---------------------------------------------------------
@@ -716,6 +938,15 @@ void AddElement::cleanup(bool undo)
     }
 }
 
+//---------------------------------------------------------
+//   AddElement::byteSize
+//---------------------------------------------------------
+
+size_t AddElement::byteSize() const
+{
+    return sizeof(AddElement) + elementTreeByteSize(element) + childrenByteSize();
+}
+
 //---------------------------------------------------------
 //   undoRemoveTuplet
 //---------------------------------------------------------
@@ -893,6 +1124,15 @@ void RemoveElement::cleanup(bool undo)
     }
 }
 
+//---------------------------------------------------------
+//   RemoveElement::byteSize
+//---------------------------------------------------------
+
+size_t RemoveElement::byteSize() const
+{
+    return sizeof(RemoveElement) + elementTreeByteSize(element) + childrenByteSize();
+}
+
 //---------------------------------------------------------
 //   undo
 //---------------------------------------------------------
@@ -1826,6 +2066,22 @@ void ChangeMStaffProperties::flip(EditData*)
     stemless = s;
 }
 
+//---------------------------------------------------------
+//   InsertRemoveMeasures::byteSize
+//---------------------------------------------------------
+
+size_t InsertRemoveMeasures::byteSize() const
+{
+    size_t size = sizeof(InsertRemoveMeasures) + childrenByteSize();
+    for (MeasureBase* m = fm; m; m = m->next()) {
+        size += elementTreeByteSize(m);
+        if (m == lm) {
+            break;
+        }
+    }
+    return size;
+}
+
 //---------------------------------------------------------
 //   getCourtesyClefs
 //    remember clefs at the end of previous measure
@@ -2009,7 +2265,7 @@ void InsertRemoveMeasures::removeMeasures()
                 sp->removeUnmanaged();
             }
         }
-        score->connectTies(true);       // ??
+        score->connectTies(tick1, tick1, true);       // ??
     }
 
     // remove empty systems
@@ -2265,6 +2521,15 @@ void MoveStaff::flip(EditData*)
 
 #endif
 
+//---------------------------------------------------------
+//   ChangeProperty::byteSize
+//---------------------------------------------------------
+
+size_t ChangeProperty::byteSize() const
+{
+    return sizeof(ChangeProperty) - sizeof(QVariant) + variantByteSize(property) + childrenByteSize();
+}
+
 //---------------------------------------------------------
 //   ChangeProperty::flip
 //---------------------------------------------------------
@@ -2282,6 +2547,94 @@ void ChangeProperty::flip(EditData*)
     flags = ps;
 }
 
+//---------------------------------------------------------
+//   ChangePropertyBatch::add
+//    apply the change and remember the previous value
+//---------------------------------------------------------
+
+void ChangePropertyBatch::add(ScoreElement* e, Pid id, const QVariant& v, PropertyFlags ps)
+{
+    elements.push_back(e);
+    ids.push_back(id);
+    values.push_back(v);
+    flags.push_back(ps);
+    flipRow(elements.size() - 1);
+}
+
+//---------------------------------------------------------
+//   ChangePropertyBatch::flipRow
+//---------------------------------------------------------
+
+void ChangePropertyBatch::flipRow(size_t row)
+{
+    ScoreElement* e  = elements[row];
+    const Pid id     = ids[row];
+    QVariant v       = e->getProperty(id);
+    PropertyFlags ps = e->propertyFlags(id);
+
+    e->setProperty(id, values[row]);
+    e->setPropertyFlags(id, flags[row]);
+    values[row] = v;
+    flags[row] = ps;
+}
+
+//---------------------------------------------------------
+//   ChangePropertyBatch::undo
+//---------------------------------------------------------
+
+void ChangePropertyBatch::undo(EditData* ed)
+{
+    UndoCommand::undo(ed);
+    for (size_t row = elements.size(); row > 0; --row) {
+        flipRow(row - 1);
+    }
+}
+
+//---------------------------------------------------------
+//   ChangePropertyBatch::redo
+//---------------------------------------------------------
+
+void ChangePropertyBatch::redo(EditData* ed)
+{
+    UndoCommand::redo(ed);
+    for (size_t row = 0; row < elements.size(); ++row) {
+        flipRow(row);
+    }
+}
+
+//---------------------------------------------------------
+//   ChangePropertyBatch::byteSize
+//---------------------------------------------------------
+
+size_t ChangePropertyBatch::byteSize() const
+{
+    size_t size = sizeof(ChangePropertyBatch) + childrenByteSize();
+    size += elements.capacity() * sizeof(ScoreElement*) + ids.capacity() * sizeof(Pid)
+            + flags.capacity() * sizeof(PropertyFlags) + (values.capacity() - values.size()) * sizeof(QVariant);
+    for (const QVariant& v : values) {
+        size += variantByteSize(v);
+    }
+    return size;
+}
+
+//---------------------------------------------------------
+//   ChangePropertyBatch::isFiltered
+//---------------------------------------------------------
+
+bool ChangePropertyBatch::isFiltered(UndoCommand::Filter f, const Element* target) const
+{
+    if (f != UndoCommand::Filter::ChangePropertyLinked) {
+        return false;
+    }
+    const QList<ScoreElement*> links = target->linkList();
+    for (ScoreElement* e : elements) {
+        if (!links.contains(e)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 //---------------------------------------------------------
 //   ChangeBracketProperty::flip
 //---------------------------------------------------------
@@ -2487,7 +2840,8 @@ LinkUnlink::~LinkUnlink()
 
 void LinkUnlink::link()
 {
-    if (le->size() == 1) {
+    // a stage does not change the element linked to
+    if (le->size() == 1 && !LinkStage::current()) {
         le->front()->setLinks(le);
     }
     mustDelete = false;
@@ -2498,6 +2852,10 @@ void LinkUnlink::link()
 void LinkUnlink::unlink()
 {
     Q_ASSERT(le->contains(e));
+    LinkStage* stage = LinkStage::current();
+    if (stage && stage->remove(e)) {
+        return;
+    }
     le->removeOne(e);
     if (le->size() == 1) {
         le->front()->setLinks(0);
@@ -2516,7 +2874,9 @@ Link::Link(ScoreElement* e1, ScoreElement* e2)
 {
     Q_ASSERT(e1->links() == 0);
     le = e2->links();
-    if (!le) {
+    if (LinkStage* stage = LinkStage::current()) {
+        le = stage->linkedElements(e2);
+    } else if (!le) {
         if (e1->isStaff()) {
             le = new LinkedElements(e1->score(), -1);
         } else {
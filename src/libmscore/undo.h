@@ -98,6 +98,7 @@ class UndoCommand
 protected:
     virtual void flip(EditData*) {}
     void appendChildren(UndoCommand*);
+    size_t childrenByteSize() const;
 
 public:
     enum class Filter {
@@ -119,6 +120,7 @@ public:
     void unwind();
     const QList<UndoCommand*>& commands() const { return childList; }
     virtual void cleanup(bool undo);
+    virtual size_t byteSize() const;      // approximate memory held by this command and its children
 // #ifndef QT_NO_DEBUG
     virtual const char* name() const { return "UndoCommand"; }
 // #endif
@@ -153,6 +155,7 @@ class UndoMacro : public UndoCommand
     SelectionInfo redoSelectionInfo;
 
     Score* score;
+    size_t _cachedByteSize { 0 };
 
     static void fillSelectionInfo(SelectionInfo&, const Selection&);
     static void applySelectionInfo(const SelectionInfo&, Selection&);
@@ -164,6 +167,10 @@ public:
     bool empty() const { return childCount() == 0; }
     void append(UndoMacro&& other);
 
+    size_t byteSize() const override;
+    size_t cachedByteSize() const { return _cachedByteSize; }
+    void updateByteSize() { _cachedByteSize = byteSize(); }
+
     static bool canRecordSelectedElement(const Element* e);
 
     UNDO_NAME("UndoMacro");
@@ -173,6 +180,8 @@ public:
 //   UndoStack
 //---------------------------------------------------------
 
+class ChangePropertyBatch;
+
 class UndoStack
 {
     UndoMacro* curCmd;
@@ -182,7 +191,17 @@ class UndoStack
     int cleanState;
     int curIdx;
 
+    size_t _memoryLimit;
+    int _depthLimit;
+    int _trimLock { 0 };
+    int _propertyBatchLevel { 0 };
+    ChangePropertyBatch* _propertyBatch { nullptr };
+    int _changes { 0 };                 // commands executed, undone or redone
+
     void remove(int idx);
+    void flushPropertyBatch();
+    bool coalesce(UndoCommand*, EditData*);
+    void trim();
 
 public:
     UndoStack();
@@ -211,6 +230,22 @@ public:
 
     void mergeCommands(int startIdx);
     void cleanRedoStack() { remove(curIdx); }
+
+    size_t byteSize() const;
+    size_t memoryLimit() const { return _memoryLimit; }
+    void setMemoryLimit(size_t bytes) { _memoryLimit = bytes; trim(); }
+    int depthLimit() const { return _depthLimit; }
+    void setDepthLimit(int n) { _depthLimit = n; trim(); }
+    void lockTrim() { ++_trimLock; }      // keep indices stable, e.g. while editing text
+    void unlockTrim() { _trimLock = qMax(0, _trimLock - 1); }   // limits are applied again at the next endMacro()
+
+    void beginPropertyBatch() { ++_propertyBatchLevel; }
+    void endPropertyBatch();
+    bool propertyBatchActive() const { return _propertyBatchLevel > 0 && curCmd; }
+    void pushBatchedProperty(ScoreElement*, Pid, const QVariant&, PropertyFlags);
+
+    int changes() const { return _changes; }
+    void countChange() { ++_changes; }
 };
 
 //---------------------------------------------------------
@@ -563,6 +598,7 @@ public:
     AddElement(Element*);
     Element* getElement() const { return element; }
     virtual void cleanup(bool) override;
+    size_t byteSize() const override;
     virtual const char* name() const override;
 
     bool isFiltered(UndoCommand::Filter f, const Element* target) const override;
@@ -581,6 +617,7 @@ public:
     virtual void undo(EditData*) override;
     virtual void redo(EditData*) override;
     virtual void cleanup(bool) override;
+    size_t byteSize() const override;
     virtual const char* name() const override;
 
     bool isFiltered(UndoCommand::Filter f, const Element* target) const override;
@@ -817,6 +854,7 @@ protected:
 public:
     InsertRemoveMeasures(MeasureBase* _fm, MeasureBase* _lm)
         : fm(_fm), lm(_lm) {}
+    size_t byteSize() const override;
     virtual void undo(EditData*) override = 0;
     virtual void redo(EditData*) override = 0;
 };
@@ -1099,6 +1137,7 @@ public:
     Pid getId() const { return id; }
     ScoreElement* getElement() const { return element; }
     QVariant data() const { return property; }
+    size_t byteSize() const override;
     UNDO_NAME("ChangeProperty")
 
     bool isFiltered(UndoCommand::Filter f, const Element* target) const override
@@ -1107,6 +1146,36 @@ public:
     }
 };
 
+//---------------------------------------------------------
+//   ChangePropertyBatch
+//    Property changes of many elements collected into a
+//    single undo command. The changes are stored column
+//    wise and applied as they are added; undo restores
+//    them in reverse order.
+//---------------------------------------------------------
+
+class ChangePropertyBatch : public UndoCommand
+{
+    std::vector<ScoreElement*> elements;
+    std::vector<Pid> ids;
+    std::vector<QVariant> values;
+    std::vector<PropertyFlags> flags;
+
+    void flipRow(size_t row);
+
+public:
+    void add(ScoreElement* e, Pid id, const QVariant& v, PropertyFlags ps);
+    bool empty() const { return elements.empty(); }
+    size_t size() const { return elements.size(); }
+
+    void undo(EditData*) override;
+    void redo(EditData*) override;
+    size_t byteSize() const override;
+    UNDO_NAME("ChangePropertyBatch")
+
+    bool isFiltered(UndoCommand::Filter f, const Element* target) const override;
+};
+
 //---------------------------------------------------------
 //   ChangeBracketProperty
 //---------------------------------------------------------
@@ -1344,6 +1413,9 @@ protected:
 public:
     LinkUnlink() {}
     ~LinkUnlink();
+
+    LinkedElements* links() const { return le; }
+    void setLinks(LinkedElements* l) { le = l; }      // see LinkStage::merge()
 };
 
 //---------------------------------------------------------
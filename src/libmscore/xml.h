@@ -62,6 +62,12 @@ class LinksIndexer
 
 public:
     int assignLocalIndex(const Location& mainElementInfo);
+
+    bool operator==(const LinksIndexer& o) const
+    {
+        return _lastLocalIndex == o._lastLocalIndex && _lastLinkedElementLoc == o._lastLinkedElementLoc;
+    }
+    bool operator!=(const LinksIndexer& o) const { return !(*this == o); }
 };
 
 //---------------------------------------------------------
@@ -216,6 +222,7 @@ public:
     // for reading old files (< 3.01)
     QMap<int, QList<QPair<LinkedElements*, Location> > >& staffLinkedElements() { return _staffLinkedElements; }
     void setOffsetLines(qint64 val) { _offsetLines = val; }
+    qint64 offsetLines() const { return _offsetLines; }
 };
 
 //---------------------------------------------------------
@@ -243,6 +250,10 @@ class XmlWriter : public QTextStream
 
     LinksIndexer _linksIndexer;
     QMap<int, int> _lidLocalIndices;
+    std::vector<std::pair<int, int> >* _lidLocalIndexLog { nullptr };
+
+    QIODevice* _fragmentDevice { nullptr };   // output saved by beginFragment()
+    QString* _fragmentString   { nullptr };
 
     std::vector<std::pair<const ScoreElement*, QString> > _elements;
     bool _recordElements = false;
@@ -279,10 +290,18 @@ public:
     void setWritePosition(bool v) { _writePosition = v; }
 
     int assignLocalIndex(const Location& mainElementLocation);
-    void setLidLocalIndex(int lid, int localIndex) { _lidLocalIndices.insert(lid, localIndex); }
+    void setLidLocalIndex(int lid, int localIndex);
     int lidLocalIndex(int lid) const { return _lidLocalIndices[lid]; }
+    const LinksIndexer& linksIndexer() const { return _linksIndexer; }
+    void setLinksIndexer(const LinksIndexer& li) { _linksIndexer = li; }
+    void setLidLocalIndexLog(std::vector<std::pair<int, int> >* log) { _lidLocalIndexLog = log; }
+
+    int level() const { return stack.size(); }
+    void beginFragment(QString* s);
+    void endFragment();
 
     const std::vector<std::pair<const ScoreElement*, QString> >& elements() const { return _elements; }
+    bool recordElements() const { return _recordElements; }
     void setRecordElements(bool record) { _recordElements = record; }
 
     void sTag(const char* name, Spatium sp) { XmlWriter::tag(name, QVariant(sp.val())); }
@@ -419,6 +419,52 @@ int XmlWriter::assignLocalIndex(const Location& mainElementLocation)
     return _linksIndexer.assignLocalIndex(mainElementLocation);
 }
 
+//---------------------------------------------------------
+//   setLidLocalIndex
+//---------------------------------------------------------
+
+void XmlWriter::setLidLocalIndex(int lid, int localIndex)
+{
+    _lidLocalIndices.insert(lid, localIndex);
+    if (_lidLocalIndexLog) {
+        _lidLocalIndexLog->emplace_back(lid, localIndex);
+    }
+}
+
+//---------------------------------------------------------
+//   beginFragment
+//    write into s until endFragment(), keeping the level
+//    and the write context
+//---------------------------------------------------------
+
+void XmlWriter::beginFragment(QString* s)
+{
+    Q_ASSERT(!_fragmentDevice && !_fragmentString);
+    flush();
+    _fragmentDevice = device();
+    _fragmentString = string();
+    setString(s, QIODevice::WriteOnly);
+}
+
+//---------------------------------------------------------
+//   endFragment
+//    continue writing to the output replaced by
+//    beginFragment()
+//---------------------------------------------------------
+
+void XmlWriter::endFragment()
+{
+    flush();
+    if (_fragmentDevice) {
+        setDevice(_fragmentDevice);
+        setCodec("UTF-8");          // setDevice() resets the codec
+    } else {
+        setString(_fragmentString, QIODevice::WriteOnly);
+    }
+    _fragmentDevice = nullptr;
+    _fragmentString = nullptr;
+}
+
 //---------------------------------------------------------
 //   canWrite
 //---------------------------------------------------------
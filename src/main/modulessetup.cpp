@@ -49,6 +49,7 @@
 #include "inspector/inspectormodule.h"
 #include "playback/playbackmodule.h"
 #include "instruments/instrumentsmodule.h"
+#include "converter/convertermodule.h"
 
 #ifdef BUILD_VST
 #include "framework/vst/vstmodule.h"
@@ -98,6 +99,7 @@ ModulesSetup::ModulesSetup()
         << new mu::importexport::ImportExportModule()
         << new mu::inspector::InspectorModule()
         << new mu::palette::PaletteModule()
+        << new mu::converter::ConverterModule()
     ;
 }
 
@@ -52,9 +52,28 @@ void ExcerptNotation::setExcerpt(Ms::Excerpt* excerpt)
     setMetaInfo(m_metaInfo);
 }
 
+Ms::Score* ExcerptNotation::score() const
+{
+    if (!m_excerpt) {
+        return Notation::score();
+    }
+
+    //! NOTE: a part score is read when it is first used
+    Ms::Excerpt::readPartScores({ m_excerpt });
+    return m_excerpt->partScore();
+}
+
 Meta ExcerptNotation::metaInfo() const
 {
-    return isInited() ? Notation::metaInfo() : m_metaInfo;
+    if (!isInited()) {
+        return m_metaInfo;
+    }
+    if (!m_excerpt->isPartScoreRead()) {
+        Meta meta;
+        meta.title = m_excerpt->title();
+        return meta;
+    }
+    return Notation::metaInfo();
 }
 
 void ExcerptNotation::setMetaInfo(const Meta& meta)
@@ -38,6 +38,8 @@ public:
 
     void setExcerpt(Ms::Excerpt* excerpt);
 
+    Ms::Score* score() const override;
+
     Meta metaInfo() const override;
     void setMetaInfo(const Meta& meta) override;
 
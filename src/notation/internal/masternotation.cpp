@@ -485,8 +485,8 @@ mu::Ret MasterNotation::createNew(const ScoreCreateOptions& scoreOptions)
         x->setPartScore(xs);
         xs->setExcerpt(x);
         score->excerpts().append(x);
-        Excerpt::createExcerpt(x);
     }
+    Excerpt::createExcerpts(excerpts);
 
     score->setExcerptsChanged(true);
 
@@ -562,8 +562,9 @@ void MasterNotation::initExcerpts()
         auto excerpts = Excerpt::createAllExcerpt(master);
 
         for (Excerpt* excerpt : excerpts) {
-            initExcerpt(excerpt);
+            initExcerptScore(excerpt);
         }
+        Excerpt::createExcerpts(excerpts);
     }
 
     ExcerptNotationList excerpts;
@@ -623,11 +624,16 @@ void MasterNotation::createNewExcerpts(const ExcerptNotationList& allExcerpts)
 }
 
 void MasterNotation::initExcerpt(Excerpt* excerpt)
+{
+    initExcerptScore(excerpt);
+    Excerpt::createExcerpt(excerpt);
+}
+
+void MasterNotation::initExcerptScore(Excerpt* excerpt)
 {
     Score* score = new Score(masterScore());
     excerpt->setPartScore(score);
     score->style().set(Sid::createMultiMeasureRests, true);
     auto excerptCmdFake = new AddExcerpt(excerpt);
     excerptCmdFake->redo(nullptr);
-    Excerpt::createExcerpt(excerpt);
 }
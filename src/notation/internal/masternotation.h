@@ -65,6 +65,7 @@ private:
 
     void initExcerpts();
     void initExcerpt(Ms::Excerpt* excerpt);
+    void initExcerptScore(Ms::Excerpt* excerpt);
 
     void removeMissingExcerpts(const ExcerptNotationList& allExcerpts);
     void createNewExcerpts(const ExcerptNotationList& allExcerpts);
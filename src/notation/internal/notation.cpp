@@ -129,6 +129,7 @@ Notation::~Notation()
 void Notation::init()
 {
     MScore::init(); // initialize libmscore
+    MScore::lazyExcerpts = true; // read part scores when they are first viewed or edited
 
     MScore::setNudgeStep(.1); // cursor key (default 0.1)
     MScore::setNudgeStep10(1.0); // Ctrl + cursor key (default 1.0)
@@ -215,7 +216,7 @@ void Notation::setViewSize(const QSizeF& vs)
 
 void Notation::setViewMode(const ViewMode& viewMode)
 {
-    if (!m_score) {
+    if (!score()) {
         return;
     }
 
@@ -226,7 +227,7 @@ void Notation::setViewMode(const ViewMode& viewMode)
 
 ViewMode Notation::viewMode() const
 {
-    if (!m_score) {
+    if (!score()) {
         return ViewMode::PAGE;
     }
 
@@ -235,7 +236,11 @@ ViewMode Notation::viewMode() const
 
 QRectF Notation::previewRect() const
 {
-    const QList<Ms::Page*>& pages = m_score->pages();
+    if (!score()) {
+        return QRect();
+    }
+
+    const QList<Ms::Page*>& pages = score()->pages();
 
     if (pages.isEmpty()) {
         return QRect();
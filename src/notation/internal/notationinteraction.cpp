@@ -44,6 +44,7 @@
 #include "libmscore/undo.h"
 #include "libmscore/navigate.h"
 #include "libmscore/keysig.h"
+#include "libmscore/staffclipboard.h"
 
 #include "masternotation.h"
 #include "scorecallbacks.h"
@@ -53,6 +54,8 @@
 using namespace mu::notation;
 using namespace Ms;
 
+static constexpr int DRAG_LAYOUT_DELAY_MS = 100;
+
 NotationInteraction::NotationInteraction(Notation* notation, INotationUndoStackPtr undoStack)
     : m_notation(notation), m_undoStack(undoStack)
 {
@@ -67,6 +70,15 @@ NotationInteraction::NotationInteraction(Notation* notation, INotationUndoStackP
 
     m_dragData.ed.view = new ScoreCallbacks();
     m_dropData.ed.view = new ScoreCallbacks();
+
+    //! NOTE While dragging, only the measures of the dragged elements are
+    //! laid out (see layoutDragRange()); the full update is done when the
+    //! pointer rests
+    m_dragLayoutTimer.setSingleShot(true);
+    m_dragLayoutTimer.setInterval(DRAG_LAYOUT_DELAY_MS);
+    QObject::connect(&m_dragLayoutTimer, &QTimer::timeout, [this]() {
+        doDragLayout();
+    });
 }
 
 NotationInteraction::~NotationInteraction()
@@ -100,6 +112,51 @@ void NotationInteraction::notifyAboutDragChanged()
     m_dragChanged.notify();
 }
 
+//! NOTE Lays out only the measures of the dragged elements in the edited
+//! score, so that what depends on them (beams, slur segments, autoplaced
+//! neighbours, the shape index of their systems) follows every move.
+//! The frame time does not depend on the score size; the linked parts
+//! and the rest of the range are laid out by doDragLayout() once the
+//! pointer rests, or by endDrag()
+void NotationInteraction::layoutDragRange()
+{
+    Fraction startTick(-1, 1);
+    Fraction endTick(-1, 1);
+    for (const Element* e : m_dragData.elements) {
+        const Ms::MeasureBase* mb = e->findMeasureBase();
+        if (!mb) {
+            continue;
+        }
+        e->triggerLayout();
+        if (startTick < Fraction(0, 1) || mb->tick() < startTick) {
+            startTick = mb->tick();
+        }
+        if (mb->endTick() > endTick) {
+            endTick = mb->endTick();
+        }
+    }
+    if (startTick < Fraction(0, 1)) {
+        return;
+    }
+
+    score()->doLayoutRange(startTick, endTick);
+    for (const Element* e : m_dragData.elements) {
+        if (const Element* system = e->findAncestor(ElementType::SYSTEM)) {
+            score()->addRefresh(system->canvasBoundingRect());
+        }
+    }
+}
+
+void NotationInteraction::doDragLayout()
+{
+    if (!isDragStarted()) {
+        return;
+    }
+
+    score()->update();
+    notifyAboutDragChanged();
+}
+
 void NotationInteraction::notifyAboutDropChanged()
 {
     m_dropChanged.notify();
@@ -501,7 +558,8 @@ void NotationInteraction::drag(const QPointF& fromPos, const QPointF& toPos, Dra
         score()->addRefresh(g->drag(m_dragData.ed));
     }
 
-    score()->update();
+    layoutDragRange();
+    m_dragLayoutTimer.start();
 
     QVector<QLineF> anchorLines;
     for (const Element* e : m_dragData.elements) {
@@ -534,6 +592,8 @@ void NotationInteraction::drag(const QPointF& fromPos, const QPointF& toPos, Dra
 
 void NotationInteraction::endDrag()
 {
+    m_dragLayoutTimer.stop();
+
     for (auto& g : m_dragData.dragGroups) {
         g->endDrag(m_dragData.ed);
     }
@@ -1819,6 +1879,11 @@ void NotationInteraction::copySelection()
         return;
     }
 
+    //! NOTE keep a copy in memory for pasting into the same score, see Ms::StaffClipboard
+    if (mimeData->hasFormat(mimeStaffListFormat)) {
+        Ms::StaffClipboard::copy(score()->selection(), mimeData->data(mimeStaffListFormat));
+    }
+
     QApplication::clipboard()->setMimeData(mimeData);
 }
 
@@ -23,6 +23,7 @@
 #include <vector>
 #include <QPointF>
 #include <QLineF>
+#include <QTimer>
 
 #include "modularity/ioc.h"
 #include "async/asyncable.h"
@@ -128,6 +129,8 @@ private:
     void apply();
 
     void notifyAboutDragChanged();
+    void layoutDragRange();
+    void doDragLayout();
     void notifyAboutDropChanged();
     void notifyAboutSelectionChanged();
     void notifyAboutNotationChanged();
@@ -193,6 +196,7 @@ private:
     async::Notification m_selectionChanged;
 
     DragData m_dragData;
+    QTimer m_dragLayoutTimer;
     async::Notification m_dragChanged;
     std::vector<QLineF> m_anchorLines;
 
@@ -1304,6 +1304,7 @@ int NotationParts::lastStaffIndex() const
 void NotationParts::removeEmptyExcerpts()
 {
     const QList<Ms::Excerpt*> excerpts(masterScore()->excerpts());
+    Ms::Excerpt::readPartScores(excerpts);
     for (Ms::Excerpt* excerpt: excerpts) {
         QList<Staff*> staves = excerpt->partScore()->staves();
 
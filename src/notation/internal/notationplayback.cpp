@@ -18,6 +18,7 @@
 //=============================================================================
 #include "notationplayback.h"
 
+#include <algorithm>
 #include <cmath>
 
 #include "log.h"
@@ -264,66 +265,87 @@ int NotationPlayback::secToTick(float sec) const
     return score->utime2utick(sec);
 }
 
-//! NOTE Copied from ScoreView::moveCursor(const Fraction& tick)
-QRect NotationPlayback::playbackCursorRectByTick(int _tick) const
+//! NOTE The interpolation intervals are those of ScoreView::moveCursor(const Fraction& tick),
+//! collected once per layout so that placing the cursor is a binary search
+void NotationPlayback::updateCursorIndex(const Ms::Score* score) const
 {
     using namespace Ms;
 
-    Ms::Score* score = m_getScore->score();
-    if (!score) {
-        return QRect();
+    if (score == m_cursorIndexScore && score->layoutSerial() == m_cursorIndexLayoutSerial) {
+        return;
     }
 
-    Fraction tick = Fraction::fromTicks(_tick);
+    m_cursorIndex.clear();
+    m_cursorIndexScore = score;
+    m_cursorIndexLayoutSerial = score->layoutSerial();
 
-    Measure* measure = score->tick2measureMM(tick);
-    if (!measure) {
-        return QRect();
-    }
-
-    System* system = measure->system();
-    if (!system) {
-        return QRect();
-    }
+    for (Measure* measure = score->firstMeasureMM(); measure; measure = measure->nextMeasureMM()) {
+        System* system = measure->system();
+        if (!system) {
+            continue;
+        }
 
-    qreal x = 0.0;
-    Segment* s = nullptr;
-    for (s = measure->first(Ms::SegmentType::ChordRest); s;) {
-        Fraction t1 = s->tick();
-        int x1 = s->canvasPos().x();
-        qreal x2;
-        Fraction t2;
-        Segment* ns = s->next(SegmentType::ChordRest);
-        while (ns && !ns->visible()) {
-            ns = ns->next(SegmentType::ChordRest);
+        CursorIndexEntry entry;
+        entry.y = system->staffYpage(0) + system->page()->pos().y();
+        for (int i = 0; i < score->nstaves(); ++i) {
+            SysStaff* ss = system->staff(i);
+            if (!ss->show() || !score->staff(i)->show()) {
+                continue;
+            }
+            entry.staffBottom = ss->bbox().bottom();
         }
-        if (ns) {
-            t2 = ns->tick();
-            x2 = ns->canvasPos().x();
-        } else {
-            t2 = measure->endTick();
-            // measure->width is not good enough because of courtesy keysig, timesig
-            Segment* seg = measure->findSegment(SegmentType::EndBarLine, measure->tick() + measure->ticks());
-            if (seg) {
-                x2 = seg->canvasPos().x();
+
+        for (Segment* s = measure->first(SegmentType::ChordRest); s;) {
+            entry.tick1 = s->tick().ticks();
+            entry.x1 = int(s->canvasPos().x());
+            Segment* ns = s->next(SegmentType::ChordRest);
+            while (ns && !ns->visible()) {
+                ns = ns->next(SegmentType::ChordRest);
+            }
+            if (ns) {
+                entry.tick2 = ns->tick().ticks();
+                entry.x2 = ns->canvasPos().x();
             } else {
-                x2 = measure->canvasPos().x() + measure->width();             //safety, should not happen
+                entry.tick2 = measure->endTick().ticks();
+                // measure->width is not good enough because of courtesy keysig, timesig
+                Segment* seg = measure->findSegment(SegmentType::EndBarLine, measure->tick() + measure->ticks());
+                if (seg) {
+                    entry.x2 = seg->canvasPos().x();
+                } else {
+                    entry.x2 = measure->canvasPos().x() + measure->width();             //safety, should not happen
+                }
             }
+            m_cursorIndex.push_back(entry);
+            s = ns;
         }
-        if (tick >= t1 && tick < t2) {
-            Fraction dt = t2 - t1;
-            qreal dx = x2 - x1;
-            x = x1 + dx * (tick - t1).ticks() / dt.ticks();
-            break;
-        }
-        s = ns;
     }
+}
+
+QRect NotationPlayback::playbackCursorRectByTick(int tick) const
+{
+    using namespace Ms;
+
+    Ms::Score* score = m_getScore->score();
+    if (!score) {
+        return QRect();
+    }
+
+    updateCursorIndex(score);
 
-    if (!s) {
+    auto it = std::upper_bound(m_cursorIndex.cbegin(), m_cursorIndex.cend(), tick, [](int t, const CursorIndexEntry& e) {
+        return t < e.tick1;
+    });
+    if (it == m_cursorIndex.cbegin()) {
+        return QRect();
+    }
+    const CursorIndexEntry& entry = *(--it);
+    if (tick >= entry.tick2) {
         return QRect();
     }
 
-    double y = system->staffYpage(0) + system->page()->pos().y();
+    qreal x = entry.x1 + (entry.x2 - entry.x1) * (tick - entry.tick1) / (entry.tick2 - entry.tick1);
+
+    double y = entry.y;
     double _spatium = score->spatium();
 
     qreal mag = _spatium / SPATIUM20;
@@ -332,16 +354,7 @@ QRect NotationPlayback::playbackCursorRectByTick(int _tick) const
     //
     // set cursor height for whole system
     //
-    double y2 = 0.0;
-
-    for (int i = 0; i < score->nstaves(); ++i) {
-        SysStaff* ss = system->staff(i);
-        if (!ss->show() || !score->staff(i)->show()) {
-            continue;
-        }
-        y2 = ss->bbox().bottom();
-    }
-    h += y2;
+    h += entry.staffBottom;
     x -= _spatium;
     y -= 3 * _spatium;
 
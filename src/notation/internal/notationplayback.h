@@ -20,6 +20,7 @@
 #define MU_NOTATION_NOTATIONPLAYBACK_H
 
 #include <memory>
+#include <vector>
 
 #include "../inotationplayback.h"
 #include "igetscore.h"
@@ -73,10 +74,26 @@ private:
     midi::MidiData playChordMidiData(const Ms::Chord* chord) const;
     midi::MidiData playHarmonyMidiData(const Ms::Harmony* harmony) const;
 
+    // playback cursor
+    struct CursorIndexEntry {
+        int tick1 = 0;                  // the cursor is interpolated over [tick1, tick2)
+        int tick2 = 0;
+        qreal x1 = 0.0;                 // canvas coordinates
+        qreal x2 = 0.0;
+        qreal y = 0.0;                  // top of the first staff
+        qreal staffBottom = 0.0;        // bottom of the last visible staff, relative to the system
+    };
+
+    void updateCursorIndex(const Ms::Score* score) const;
+
     IGetScore* m_getScore = nullptr;
     std::shared_ptr<midi::MidiStream> m_midiStream;
     std::unique_ptr<Ms::MidiRenderer> m_midiRenderer;
     async::Channel<int> m_playPositionTickChanged;
+
+    mutable std::vector<CursorIndexEntry> m_cursorIndex;     // sorted by tick
+    mutable const Ms::Score* m_cursorIndexScore = nullptr;
+    mutable int m_cursorIndexLayoutSerial = -1;
 };
 }
 }
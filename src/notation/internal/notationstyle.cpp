@@ -49,6 +49,7 @@ void NotationStyle::applyToAllParts()
 
     Ms::MStyle style = m_getScore->score()->style();
 
+    Ms::Excerpt::readPartScores(m_getScore->score()->excerpts());
     for (Ms::Excerpt* excerpt : m_getScore->score()->excerpts()) {
         excerpt->partScore()->undo(new Ms::ChangeStyle(excerpt->partScore(), style));
         excerpt->partScore()->update();
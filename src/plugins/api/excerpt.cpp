@@ -22,6 +22,7 @@ namespace PluginAPI {
 
 Score* Excerpt::partScore()
 {
+    Ms::Excerpt::readPartScores({ e });
     return wrap<Score>(e->partScore(), Ownership::SCORE);
 }
 
@@ -542,10 +542,53 @@ public:
     }
 
     void scanFiles();
+    int indexOf(const QString& fileName);
 
     MQZipReader::Status status;
 };
 
+//---------------------------------------------------------
+//   MQZipFileDevice
+//    read only device returned by MQZipReader::openFile();
+//    the file is inflated while it is read, straight from
+//    the zip file if that can be mapped into memory, else
+//    from chunks read from the zip device, so that it never
+//    has to be held in memory as a whole.
+//---------------------------------------------------------
+
+class MQZipFileDevice : public QIODevice
+{
+public:
+    MQZipFileDevice(QIODevice* device, qint64 start, qint64 compressedSize, qint64 size, bool deflated);
+    ~MQZipFileDevice();
+
+    void close() override;
+    bool isSequential() const override { return true; }
+    bool atEnd() const override;
+    qint64 bytesAvailable() const override;
+
+protected:
+    qint64 readData(char* data, qint64 maxlen) override;
+    qint64 writeData(const char*, qint64) override { return -1; }
+
+private:
+    bool readInput();
+
+    QIODevice* device;
+    uchar* map;                 // the compressed data, if the zip file is mapped
+    qint64 inputPos;            // position of the compressed data not read yet
+    qint64 remaining;           // compressed bytes not read yet
+    qint64 fileSize;            // uncompressed size
+    qint64 done;                // uncompressed bytes returned so far
+    bool deflated;
+    z_stream stream;
+    bool streamValid;
+    bool streamEnd;
+    char buffer[16384];
+};
+
+class MQZipEntryDevice;
+
 class MQZipWriterPrivate : public MQZipPrivate
 {
 public:
@@ -553,19 +596,59 @@ public:
         : MQZipPrivate(device, ownDev),
         status(MQZipWriter::NoError),
         permissions(QFile::ReadOwner | QFile::WriteOwner),
-        compressionPolicy(MQZipWriter::AlwaysCompress)
+        compressionPolicy(MQZipWriter::AlwaysCompress),
+        entryDevice(0)
     {
     }
 
+    ~MQZipWriterPrivate();
+
     MQZipWriter::Status status;
     QFile::Permissions permissions;
     MQZipWriter::CompressionPolicy compressionPolicy;
+    MQZipEntryDevice* entryDevice;      // file opened by openFile(), if any
 
     enum EntryType {
         Directory, File, Symlink
     };
 
+    void initHeader(FileHeader& header, EntryType type, const QString& fileName);
     void addEntry(EntryType type, const QString& fileName, const QByteArray& contents);
+    QIODevice* openEntry(const QString& fileName);
+    void closeEntry();
+};
+
+//---------------------------------------------------------
+//   MQZipEntryDevice
+//    write only device returned by MQZipWriter::openFile();
+//    data written to it is deflated straight into the zip
+//    device, so that the file never has to be held in
+//    memory. The local header is written with zero crc and
+//    sizes and patched when the device is closed.
+//---------------------------------------------------------
+
+class MQZipEntryDevice : public QIODevice
+{
+public:
+    MQZipEntryDevice(MQZipWriterPrivate* d, int headerIndex);
+    ~MQZipEntryDevice();
+
+    void close() override;
+    bool isSequential() const override { return true; }
+
+protected:
+    qint64 readData(char*, qint64) override { return -1; }
+    qint64 writeData(const char* data, qint64 len) override;
+
+private:
+    bool deflateInput(int flush);
+
+    MQZipWriterPrivate* d;
+    int headerIndex;
+    z_stream stream;
+    bool streamValid;
+    uint crc_32;
+    char buffer[16384];
 };
 
 LocalFileHeader CentralFileHeader::toLocalHeader() const
@@ -675,6 +758,200 @@ void MQZipReaderPrivate::scanFiles()
     }
 }
 
+//---------------------------------------------------------
+//   indexOf
+//    return the index of the header of fileName or -1
+//---------------------------------------------------------
+
+int MQZipReaderPrivate::indexOf(const QString& fileName)
+{
+    scanFiles();
+    for (int i = 0; i < fileHeaders.size(); ++i) {
+        if (QString::fromUtf8(fileHeaders.at(i).file_name) == fileName) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+MQZipFileDevice::MQZipFileDevice(QIODevice* device, qint64 start, qint64 compressedSize, qint64 size, bool deflated)
+    : device(device), map(0), inputPos(start), remaining(compressedSize), fileSize(size), done(0), deflated(deflated),
+    streamValid(true), streamEnd(false)
+{
+    memset(&stream, 0, sizeof(z_stream));
+    QFileDevice* file = qobject_cast<QFileDevice*>(device);
+    if (file && compressedSize > 0 && compressedSize <= qint64(0x40000000)) {
+        map = file->map(start, compressedSize);
+    }
+    if (map) {
+        stream.next_in = map;
+        stream.avail_in = uInt(compressedSize);
+        remaining = 0;
+    }
+    if (deflated) {
+        streamValid = inflateInit2(&stream, -MAX_WBITS) == Z_OK;
+        if (!streamValid) {
+            qWarning("QZip: cannot initialize inflate stream");
+        }
+    }
+    QIODevice::open(QIODevice::ReadOnly);
+}
+
+MQZipFileDevice::~MQZipFileDevice()
+{
+    close();
+}
+
+//---------------------------------------------------------
+//   readInput
+//    read the next chunk of compressed data from the zip
+//    device; it is re-positioned each time as others may
+//    read from it in between
+//---------------------------------------------------------
+
+bool MQZipFileDevice::readInput()
+{
+    if (remaining <= 0 || !device->seek(inputPos)) {
+        return false;
+    }
+    const qint64 n = device->read(buffer, qMin(remaining, qint64(sizeof(buffer))));
+    if (n <= 0) {
+        return false;
+    }
+    inputPos += n;
+    remaining -= n;
+    stream.next_in = reinterpret_cast<Bytef*>(buffer);
+    stream.avail_in = uInt(n);
+    return true;
+}
+
+qint64 MQZipFileDevice::readData(char* data, qint64 maxlen)
+{
+    if (!streamValid) {
+        return -1;
+    }
+    qint64 n = 0;
+    while (n < maxlen && !streamEnd) {
+        if (stream.avail_in == 0 && !readInput()) {
+            if (deflated) {
+                qWarning("QZip: unexpected end of compressed data");
+                setErrorString("unexpected end of compressed data");
+            }
+            streamEnd = true;
+            break;
+        }
+        // avail_out is only 32 bits wide
+        const uInt len = uInt(qMin(maxlen - n, qint64(0x40000000)));
+        if (!deflated) {
+            const uInt k = qMin(len, stream.avail_in);
+            memcpy(data + n, stream.next_in, k);
+            stream.next_in += k;
+            stream.avail_in -= k;
+            n += k;
+            continue;
+        }
+        stream.next_out = reinterpret_cast<Bytef*>(data + n);
+        stream.avail_out = len;
+        const int res = ::inflate(&stream, Z_NO_FLUSH);
+        n += len - stream.avail_out;
+        if (res == Z_STREAM_END) {
+            streamEnd = true;
+        } else if (res != Z_OK && res != Z_BUF_ERROR) {
+            qWarning("QZip: Z_DATA_ERROR: Input data is corrupted");
+            setErrorString("input data is corrupted");
+            streamEnd = true;
+        }
+    }
+    done += n;
+    if (n == 0 && streamEnd) {
+        return -1;
+    }
+    return n;
+}
+
+bool MQZipFileDevice::atEnd() const
+{
+    return streamEnd && QIODevice::bytesAvailable() == 0;
+}
+
+qint64 MQZipFileDevice::bytesAvailable() const
+{
+    return QIODevice::bytesAvailable() + (streamEnd ? 0 : qMax(fileSize - done, qint64(0)));
+}
+
+void MQZipFileDevice::close()
+{
+    if (!isOpen()) {
+        return;
+    }
+    if (deflated && streamValid) {
+        inflateEnd(&stream);
+    }
+    if (map) {
+        static_cast<QFileDevice*>(device)->unmap(map);
+        map = 0;
+    }
+    QIODevice::close();
+}
+
+MQZipWriterPrivate::~MQZipWriterPrivate()
+{
+    delete entryDevice;
+}
+
+//---------------------------------------------------------
+//   initHeader
+//    fill in everything but the compression method, crc
+//    and sizes
+//---------------------------------------------------------
+
+void MQZipWriterPrivate::initHeader(FileHeader& header, EntryType type, const QString& fileName)
+{
+    memset(&header.h, 0, sizeof(CentralFileHeader));
+    writeUInt(header.h.signature, 0x02014b50);
+
+    writeUShort(header.h.version_needed, ZIP_VERSION);
+    writeMSDosDate(header.h.last_mod_file, QDateTime::currentDateTime());
+
+    // if bit 11 is set, the filename and comment fields must be encoded using UTF-8
+    ushort general_purpose_bits = Utf8Names; // always use utf-8
+    writeUShort(header.h.general_purpose_bits, general_purpose_bits);
+
+    const bool inUtf8 = (general_purpose_bits & Utf8Names) != 0;
+    header.file_name = inUtf8 ? fileName.toUtf8() : fileName.toLocal8Bit();
+    if (header.file_name.size() > 0xffff) {
+        qWarning("QZip: Filename is too long, chopping it to 65535 bytes");
+        header.file_name = header.file_name.left(0xffff); // ### don't break the utf-8 sequence, if any
+    }
+    if (header.file_comment.size() + header.file_name.size() > 0xffff) {
+        qWarning("QZip: File comment is too long, chopping it to 65535 bytes");
+        header.file_comment.truncate(0xffff - header.file_name.size()); // ### don't break the utf-8 sequence, if any
+    }
+    writeUShort(header.h.file_name_length, header.file_name.length());
+    //h.extra_field_length[2];
+
+    writeUShort(header.h.version_made, HostUnix << 8);
+    //uchar internal_file_attributes[2];
+    //uchar external_file_attributes[4];
+    quint32 mode = permissionsToMode(permissions);
+    switch (type) {
+    case Symlink:
+        mode |= UnixFileAttributes::SymLink;
+        break;
+    case Directory:
+        mode |= UnixFileAttributes::Dir;
+        break;
+    case File:
+        mode |= UnixFileAttributes::File;
+        break;
+    default:
+        Q_UNREACHABLE();
+        break;
+    }
+    writeUInt(header.h.external_file_attributes, mode << 16);
+    writeUInt(header.h.offset_local_header, start_of_directory);
+}
+
 void MQZipWriterPrivate::addEntry(EntryType type, const QString& fileName,
                                   const QByteArray& contents /*, QFile::Permissions permissions, QZip::Method m*/)
 {
@@ -687,6 +964,7 @@ void MQZipWriterPrivate::addEntry(EntryType type, const QString& fileName,
              << (type == 2 ? QByteArray(" -> " + contents).constData() : "");
 #endif
 
+    closeEntry();
     if (!(device->isOpen() || device->open(QIODevice::WriteOnly))) {
         status = MQZipWriter::FileOpenError;
         return;
@@ -704,12 +982,9 @@ void MQZipWriterPrivate::addEntry(EntryType type, const QString& fileName,
     }
 
     FileHeader header;
-    memset(&header.h, 0, sizeof(CentralFileHeader));
-    writeUInt(header.h.signature, 0x02014b50);
+    initHeader(header, type, fileName);
 
-    writeUShort(header.h.version_needed, ZIP_VERSION);
     writeUInt(header.h.uncompressed_size, contents.length());
-    writeMSDosDate(header.h.last_mod_file, QDateTime::currentDateTime());
     QByteArray data = contents;
     if (compression == MQZipWriter::AlwaysCompress) {
         writeUShort(header.h.compression_method, CompressionMethodDeflated);
@@ -742,52 +1017,156 @@ void MQZipWriterPrivate::addEntry(EntryType type, const QString& fileName,
     crc_32 = ::crc32(crc_32, (const uchar*)contents.constData(), contents.length());
     writeUInt(header.h.crc_32, crc_32);
 
-    // if bit 11 is set, the filename and comment fields must be encoded using UTF-8
-    ushort general_purpose_bits = Utf8Names; // always use utf-8
-    writeUShort(header.h.general_purpose_bits, general_purpose_bits);
+    fileHeaders.append(header);
 
-    const bool inUtf8 = (general_purpose_bits & Utf8Names) != 0;
-    header.file_name = inUtf8 ? fileName.toUtf8() : fileName.toLocal8Bit();
-    if (header.file_name.size() > 0xffff) {
-        qWarning("QZip: Filename is too long, chopping it to 65535 bytes");
-        header.file_name = header.file_name.left(0xffff); // ### don't break the utf-8 sequence, if any
-    }
-    if (header.file_comment.size() + header.file_name.size() > 0xffff) {
-        qWarning("QZip: File comment is too long, chopping it to 65535 bytes");
-        header.file_comment.truncate(0xffff - header.file_name.size()); // ### don't break the utf-8 sequence, if any
-    }
-    writeUShort(header.h.file_name_length, header.file_name.length());
-    //h.extra_field_length[2];
+    LocalFileHeader h = header.h.toLocalHeader();
+    device->write((const char*)&h, sizeof(LocalFileHeader));
+    device->write(header.file_name);
+    device->write(data);
+    start_of_directory = device->pos();
+    dirtyFileTree = true;
+}
 
-    writeUShort(header.h.version_made, HostUnix << 8);
-    //uchar internal_file_attributes[2];
-    //uchar external_file_attributes[4];
-    quint32 mode = permissionsToMode(permissions);
-    switch (type) {
-    case Symlink:
-        mode |= UnixFileAttributes::SymLink;
-        break;
-    case Directory:
-        mode |= UnixFileAttributes::Dir;
-        break;
-    case File:
-        mode |= UnixFileAttributes::File;
-        break;
-    default:
-        Q_UNREACHABLE();
-        break;
+//---------------------------------------------------------
+//   openEntry
+//    start a deflated file whose contents are written to
+//    the returned device
+//---------------------------------------------------------
+
+QIODevice* MQZipWriterPrivate::openEntry(const QString& fileName)
+{
+    ZDEBUG() << "opening file :" << fileName.toUtf8().data();
+
+    closeEntry();
+    if (!(device->isOpen() || device->open(QIODevice::WriteOnly))) {
+        status = MQZipWriter::FileOpenError;
+        return 0;
     }
-    writeUInt(header.h.external_file_attributes, mode << 16);
-    writeUInt(header.h.offset_local_header, start_of_directory);
+    device->seek(start_of_directory);
 
+    FileHeader header;
+    initHeader(header, File, fileName);
+    // the size is not known in advance, so AutoCompress compresses too
+    writeUShort(header.h.compression_method, CompressionMethodDeflated);
     fileHeaders.append(header);
 
     LocalFileHeader h = header.h.toLocalHeader();
     device->write((const char*)&h, sizeof(LocalFileHeader));
     device->write(header.file_name);
-    device->write(data);
-    start_of_directory = device->pos();
     dirtyFileTree = true;
+
+    entryDevice = new MQZipEntryDevice(this, fileHeaders.size() - 1);
+    return entryDevice;
+}
+
+//---------------------------------------------------------
+//   closeEntry
+//    finish and delete the file opened by openEntry()
+//---------------------------------------------------------
+
+void MQZipWriterPrivate::closeEntry()
+{
+    if (entryDevice) {
+        entryDevice->close();
+        delete entryDevice;
+        entryDevice = 0;
+    }
+}
+
+MQZipEntryDevice::MQZipEntryDevice(MQZipWriterPrivate* d, int headerIndex)
+    : d(d), headerIndex(headerIndex)
+{
+    memset(&stream, 0, sizeof(z_stream));
+    streamValid = deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) == Z_OK;
+    if (!streamValid) {
+        qWarning("QZip: cannot initialize deflate stream");
+        d->status = MQZipWriter::FileError;
+    }
+    crc_32 = ::crc32(0, 0, 0);
+    QIODevice::open(QIODevice::WriteOnly);
+}
+
+MQZipEntryDevice::~MQZipEntryDevice()
+{
+    close();
+}
+
+//---------------------------------------------------------
+//   deflateInput
+//    deflate the pending input and write it to the zip
+//    device
+//---------------------------------------------------------
+
+bool MQZipEntryDevice::deflateInput(int flush)
+{
+    int res;
+    do {
+        stream.next_out = reinterpret_cast<Bytef*>(buffer);
+        stream.avail_out = sizeof(buffer);
+        res = ::deflate(&stream, flush);
+        if (res == Z_STREAM_ERROR) {
+            return false;
+        }
+        const qint64 n = qint64(sizeof(buffer)) - stream.avail_out;
+        if (n && d->device->write(buffer, n) != n) {
+            d->status = MQZipWriter::FileWriteError;
+            return false;
+        }
+    } while (stream.avail_out == 0 || (flush == Z_FINISH && res != Z_STREAM_END));
+    return true;
+}
+
+qint64 MQZipEntryDevice::writeData(const char* data, qint64 len)
+{
+    if (!streamValid) {
+        return -1;
+    }
+    qint64 written = 0;
+    while (written < len) {
+        // avail_in is only 32 bits wide
+        const uInt n = uInt(qMin(len - written, qint64(0x40000000)));
+        crc_32 = ::crc32(crc_32, reinterpret_cast<const Bytef*>(data + written), n);
+        stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data + written));
+        stream.avail_in = n;
+        if (!deflateInput(Z_NO_FLUSH)) {
+            return -1;
+        }
+        written += n;
+    }
+    return written;
+}
+
+//---------------------------------------------------------
+//   close
+//    finish the stream and write crc and sizes to the
+//    local and central headers
+//---------------------------------------------------------
+
+void MQZipEntryDevice::close()
+{
+    if (!isOpen()) {
+        return;
+    }
+    QIODevice::close();
+    if (!streamValid) {
+        return;
+    }
+    stream.next_in = 0;
+    stream.avail_in = 0;
+    deflateInput(Z_FINISH);
+    FileHeader& header = d->fileHeaders[headerIndex];
+    writeUInt(header.h.crc_32, crc_32);
+    writeUInt(header.h.compressed_size, uint(stream.total_out));
+    writeUInt(header.h.uncompressed_size, uint(stream.total_in));
+    deflateEnd(&stream);
+    streamValid = false;
+
+    const qint64 end = d->device->pos();
+    LocalFileHeader h = header.h.toLocalHeader();
+    d->device->seek(readUInt(header.h.offset_local_header));
+    d->device->write((const char*)&h, sizeof(LocalFileHeader));
+    d->device->seek(end);
+    d->start_of_directory = end;
 }
 
 //////////////////////////////  Reader
@@ -970,14 +1349,8 @@ MQZipReader::FileInfo MQZipReader::entryInfoAt(int index) const
 */
 QByteArray MQZipReader::fileData(const QString& fileName) const
 {
-    d->scanFiles();
-    int i;
-    for (i = 0; i < d->fileHeaders.size(); ++i) {
-        if (QString::fromUtf8(d->fileHeaders.at(i).file_name) == fileName) {
-            break;
-        }
-    }
-    if (i == d->fileHeaders.size()) {
+    int i = d->indexOf(fileName);
+    if (i == -1) {
         return QByteArray();
     }
 
@@ -1051,6 +1424,55 @@ QByteArray MQZipReader::fileData(const QString& fileName) const
     return QByteArray();
 }
 
+/*!
+    Open the file \a fileName in the zip archive for reading; its contents
+    are inflated while they are read, so that large files need not be held
+    in memory. If the archive is a file it is mapped into memory where the
+    platform allows it.
+    The returned device is owned by the caller and must be deleted before
+    the reader. Returns 0 if the file cannot be found or extracted.
+*/
+QIODevice* MQZipReader::openFile(const QString& fileName) const
+{
+    int i = d->indexOf(fileName);
+    if (i == -1) {
+        return 0;
+    }
+
+    FileHeader header = d->fileHeaders.at(i);
+
+    ushort version_needed = readUShort(header.h.version_needed);
+    if (version_needed > ZIP_VERSION) {
+        qWarning("QZip: .ZIP specification version %d implementationis needed to extract the data.", version_needed);
+        return 0;
+    }
+    ushort general_purpose_bits = readUShort(header.h.general_purpose_bits);
+    if ((general_purpose_bits & Encrypted) != 0) {
+        qWarning("QZip: Unsupported encryption method is needed to extract the data.");
+        return 0;
+    }
+
+    qint64 compressed_size = readUInt(header.h.compressed_size);
+    qint64 uncompressed_size = readUInt(header.h.uncompressed_size);
+    qint64 start = readUInt(header.h.offset_local_header);
+
+    d->device->seek(start);
+    LocalFileHeader lh;
+    if (d->device->read((char*)&lh, sizeof(LocalFileHeader)) != qint64(sizeof(LocalFileHeader))) {
+        return 0;
+    }
+    start += sizeof(LocalFileHeader) + readUShort(lh.file_name_length) + readUShort(lh.extra_field_length);
+
+    int compression_method = readUShort(lh.compression_method);
+    if (compression_method == CompressionMethodStored) {
+        return new MQZipFileDevice(d->device, start, uncompressed_size, uncompressed_size, false);
+    } else if (compression_method == CompressionMethodDeflated) {
+        return new MQZipFileDevice(d->device, start, compressed_size, uncompressed_size, true);
+    }
+    qWarning("QZip: Unsupported compression method %d is needed to extract the data.", compression_method);
+    return 0;
+}
+
 /*!
     Extracts the full contents of the zip file into \a destinationDir on
     the local filesystem.
@@ -1346,6 +1768,23 @@ void MQZipWriter::addFile(const QString& fileName, QIODevice* device)
     }
 }
 
+/*!
+    Add a file to the archive whose contents are written to the returned
+    device; the file is complete when the device is closed, when the next
+    entry is added or when the archive is closed.
+    The contents are deflated while they are written, so that large files
+    need not be held in memory. The file is always compressed.
+    The device is owned by the writer and stays valid until the next entry
+    is added or the archive is closed. Returns 0 if the archive cannot be
+    written to.
+    The file will be stored in the archive using the \a fileName which
+    includes the full path in the archive.
+*/
+QIODevice* MQZipWriter::openFile(const QString& fileName)
+{
+    return d->openEntry(QDir::fromNativeSeparators(fileName));
+}
+
 /*!
     Create a new directory in the archive with the specified \a dirName and
     the \a permissions;
@@ -1375,6 +1814,7 @@ void MQZipWriter::addSymLink(const QString& fileName, const QString& destination
 */
 void MQZipWriter::close()
 {
+    d->closeEntry();
     if (!(d->device->openMode() & QIODevice::WriteOnly)) {
         d->device->close();
         return;